@@ -22,8 +22,29 @@
  * @see ads7924Irq.h
  */
 #include "ads7924core.h"
+#include "ads7924timing.h"
+#include "ads7924stream.h"
 #include "ads7924Irq.h"
 
+/*!----------------------------------------------------------------------------
+ * @brief Calculates the timing of the current register configuration of
+ *        the given chip.
+ * @retval true  Chip is in a automatic mode, pTiming and pMode are valid.
+ * @retval false No reconstruction of the conversion instants possible.
+ */
+static inline bool getChipTiming( ADS7924_T* pAds7924,
+                                  ADS7924_TIMING_T* pTiming, u8* pMode )
+{
+   u8 aConfig[PWRCONFIG - SLPCONFIG + 1];
+
+   if( adcReadTimingShadow( pAds7924, pMode, aConfig ) < 0 )
+   {
+      ERROR_MESSAGE( ": adcReadTimingShadow() failed!\n" );
+      return false;
+   }
+   return adcCalculateTiming( pTiming, *pMode, aConfig[0], aConfig[1], aConfig[2] );
+}
+
 /*!----------------------------------------------------------------------------
  * @brief Thread-function becomes indirectly invoked from the ADC-interrupt.
  */
@@ -32,10 +53,19 @@ inline
 #endif
 static irqreturn_t onIrqBottomHalf( int irq, void* pData )
 {
-   int            adcChannelIndex;
-   u8             alarmStatus;
-   ADC_CHANNEL_T* pChannel;
-   ADS7924_T*     pAds7924 = pData;
+   int              adcChannelIndex;
+   int              ret;
+   u8               alarmStatus;
+   u8               mode = 0;
+   bool             hasTiming;
+   u64              timestamp;
+   u64              scanEnd = 0;
+   ADS7924_TIMING_T oTiming;
+   ADC_CHANNEL_T*   pChannel;
+   ADS7924_T*       pAds7924 = pData;
+
+   /* Gives the transfers of this thread the highest priority on the bus. */
+   WRITE_ONCE( pAds7924->pHarvester, current );
 
    if( adcReadIntCtrl( pAds7924, &alarmStatus ) < 0 )
    {
@@ -50,6 +80,22 @@ static irqreturn_t onIrqBottomHalf( int irq, void* pData )
       return IRQ_HANDLED;
    }
 
+   if( (s64)(pAds7924->irqTimestamp - READ_ONCE( pAds7924->calibrationEnd )) < 0 )
+   {
+      /* Data-ready of the grounded inputs of a offset calibration. */
+      return IRQ_HANDLED;
+   }
+
+   hasTiming = getChipTiming( pAds7924, &oTiming, &mode );
+   if( hasTiming )
+      scanEnd = adcUpdateScanEstimation( pAds7924, &oTiming, pAds7924->irqTimestamp );
+
+   if( pAds7924->streamMode != ADS7924_STREAM_OFF )
+   {
+      adcStreamHarvest( pAds7924, hasTiming? &oTiming : NULL, mode, scanEnd );
+      return IRQ_HANDLED;
+   }
+
    for( adcChannelIndex = 0; adcChannelIndex < ADC_CHANNELS_PER_CHIP; adcChannelIndex++ )
    {
       pChannel = pAds7924->paChannel[adcChannelIndex];
@@ -62,11 +108,20 @@ static irqreturn_t onIrqBottomHalf( int irq, void* pData )
       if( (g_ads7924InternList[pChannel->cannelNumber].enableMask & alarmStatus) == 0 )
          continue; /* Alarm isn't for this channel. */
 
-      if( readAnalogValue( pChannel ) < 0 )
+      timestamp = 0;
+      if( hasTiming )
+         timestamp = adcReconstructTimestamp( &oTiming, mode,
+                                              pChannel->cannelNumber,
+                                              scanEnd );
+
+      ret = readAnalogSample( pChannel, timestamp, hasTiming? oTiming.period : 0 );
+      if( ret < 0 )
       {
-         ERROR_MESSAGE( ": readAnalogValue() failed!\n" );
+         ERROR_MESSAGE( ": readAnalogSample() failed!\n" );
          continue;
       }
+      if( ret > 0 )
+         continue; /* Dropped by the pipeline of the channel. */
 
       /* Triggering select() of user-space application. */
       wakeUpChannel( pChannel ); 
@@ -75,6 +130,17 @@ static irqreturn_t onIrqBottomHalf( int irq, void* pData )
 }
 
 #ifdef _ADS7924_NO_DEV_TREE
+/*!----------------------------------------------------------------------------
+ * @brief Hard-interrupt function, takes the time of the interrupt only.
+ *
+ * All chips share the same GPIO-interrupt in this case.
+ */
+static irqreturn_t onIrqTopHalfLoop( int irq, void* pData )
+{
+   g_data.adcInterrupt.timestamp = ktime_get_ns();
+   return IRQ_WAKE_THREAD;
+}
+
 /*!----------------------------------------------------------------------------
  * @brief Thread-function becomes indirectly invoked from the ADC-interrupt.
  */
@@ -94,11 +160,25 @@ static irqreturn_t onIrqBottomHalfLoop( int irq, void* pData )
          if( pAds7924 == NULL )
             continue; /* Chip is not present. */
 
+         pAds7924->irqTimestamp = g_data.adcInterrupt.timestamp;
          onIrqBottomHalf( irq, pAds7924 );
       }
    }
    return IRQ_HANDLED;
 }
+#else
+/*!----------------------------------------------------------------------------
+ * @brief Hard-interrupt function, takes the time of the interrupt only.
+ *
+ * This timestamp is the base of the reconstruction of the conversion
+ * instants, the latency of the threaded bottom half doesn't matter.
+ * @see adcReconstructTimestamp
+ */
+static irqreturn_t onIrqTopHalf( int irq, void* pData )
+{
+   ((ADS7924_T*)pData)->irqTimestamp = ktime_get_ns();
+   return IRQ_WAKE_THREAD;
+}
 #endif
 
 #ifdef _ADS7924_NO_DEV_TREE
@@ -130,7 +210,7 @@ int _ADS7924_INIT initGpioInterrupt( void )
    }
 
    if( request_threaded_irq( g_data.adcInterrupt.irq,
-                             NULL,
+                             onIrqTopHalfLoop,
                              onIrqBottomHalfLoop,
                              IRQF_TRIGGER_FALLING | IRQF_ONESHOT,
                              g_data.pName,
@@ -164,7 +244,7 @@ int _ADS7924_INIT initGpioInterrupt( ADS7924_T* pAds7924 )
 
    if( devm_request_threaded_irq( &pAds7924->pI2cSlave->dev,
                                   pAds7924->pI2cSlave->irq,
-                                  NULL,
+                                  onIrqTopHalf,
                                   onIrqBottomHalf,
                                   IRQF_TRIGGER_FALLING | IRQF_ONESHOT,
                                   name,
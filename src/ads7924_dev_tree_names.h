@@ -109,6 +109,17 @@
 #define ADS7924_DT_GPIO_INTERRUPT_INPUT  alarm_input_gpio
 #define ADS7924_DT_CHANNEL_PROPERTY      channel
 
+/*!
+ * @brief Suffixes of the optional calibration properties of a channel.
+ *
+ * E.g.: "channel0-gain = <52800>;" sets the fixed point gain (Q16.16)
+ *       of channel 0.
+ * @see CALIBRATION
+ */
+#define ADS7924_DT_GAIN_SUFFIX           "-gain"
+#define ADS7924_DT_OFFSET_SUFFIX         "-offset"
+#define ADS7924_DT_CALIBRATION_SUFFIX    "-calibration"
+
 /*!
  * @brief Optional template for the used ADC-channel properties.
  */
@@ -0,0 +1,267 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924acquisition.c
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Acquisition of analog values on demand of the application.
+ * @date 2026.10.18
+ * @see ads7924acquisition.h
+ */
+#include "ads7924core.h"
+#include "ads7924timing.h"
+#include "ads7924acquisition.h"
+#include "ads7924pipeline.h"
+#include <linux/hrtimer.h>
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924acquisition.h
+ */
+void _ADS7924_INIT adcInitAcquisition( ADS7924_T* pChip )
+{
+   mutex_init( &pChip->oConvMutex );
+   spin_lock_init( &pChip->burst.oLock );
+   mutex_init( &pChip->burst.oMutex );
+   pChip->burst.request   = 0;
+   pChip->burst.failed    = 0;
+   pChip->burst.dropped   = 0;
+   pChip->burst.started   = 0;
+   pChip->burst.completed = 0;
+   pChip->burst.served    = 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924acquisition.h
+ */
+int adcFreshConversion( ADC_CHANNEL_T* pChannel )
+{
+   ADS7924_T* pChip = pChannel->pParent;
+   unsigned int arrival;
+   u8 mode;
+   u8 aConfig[PWRCONFIG - SLPCONFIG + 1];
+   u32 convTime;
+   ADS7924_SAMPLE_T sample;
+   VALUE_T value;
+   u64 start;
+   int ret;
+
+   arrival = READ_ONCE( pChannel->convStarted );
+   if( mutex_lock_interruptible( &pChip->oConvMutex ) )
+      return -ERESTARTSYS;
+
+   if( (int)(pChannel->convCompleted - arrival) > 0 )
+   {
+      /*
+       * A conversion which has been started after the arrival of this
+       * request is meanwhile completed, its result is fresh enough.
+       */
+      DEBUG_MESSAGE( ": Coalesced request of channel %d\n", pChannel->cannelNumber );
+      ret = 0;
+      goto L_UNLOCK;
+   }
+
+   pChannel->convStarted++;
+   ret = adcReadTimingShadow( pChip, &mode, aConfig );
+   if( ret < 0 )
+      goto L_UNLOCK;
+
+   convTime = adcGetConvTime( aConfig[ACQCONFIG - SLPCONFIG] );
+   ret = adcConvertChannel( pChannel, convTime, &value, &start );
+   if( ret < 0 )
+      goto L_UNLOCK;
+
+   sample.value = value;
+   if( start != 0 )
+   {
+      /* Conversion instant is the end of the acquisition time. */
+      sample.timestamp = start + convTime - ADS7924_CONV_TIME_NS;
+      sample.flags = ADS7924_SAMPLE_RECONSTRUCTED;
+   }
+   else
+   {
+      sample.timestamp = ktime_get_ns();
+      sample.flags = 0;
+   }
+   pChannel->convCompleted = pChannel->convStarted;
+   if( adcHasPipeline( pChannel ) && !adcRunPipeline( pChannel, &sample ) )
+      goto L_UNLOCK; /* Dropped, the previous result remains. */
+
+   publishResult( pChannel, &sample );
+
+L_UNLOCK:
+   mutex_unlock( &pChip->oConvMutex );
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924acquisition.h
+ */
+int adcWaitNextConversion( ADC_CHANNEL_T* pChannel )
+{
+   u64 wakeUp, instant;
+   ktime_t expires;
+
+   wakeUp = adcPredictConversion( pChannel->pParent, pChannel->cannelNumber,
+                                  ktime_get_ns(), &instant );
+   if( wakeUp == 0 )
+      return adcFreshConversion( pChannel );
+
+   /*
+    * Sleeping by a high-resolution timer, the timer-slack of the jiffies
+    * based sleeps would exceed a period in the fast modes.
+    */
+   expires = ns_to_ktime( wakeUp );
+   set_current_state( TASK_INTERRUPTIBLE );
+   if( schedule_hrtimeout_range( &expires, ADS7924_CONV_TIME_NS, HRTIMER_MODE_ABS ) != 0 )
+      return -ERESTARTSYS;
+
+   return readAnalogSample( pChannel, instant, 0 );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Reads all requested channels by a single I2C-transfer, which
+ *        covers the data registers from the lowest to the highest
+ *        requested channel, and publishes their results.
+ * @note The caller has to hold pChip->burst.oMutex.
+ * @param mask Requested channels.
+ */
+static void readBurst( ADS7924_T* pChip, u8 mask )
+{
+   VALUE_T aValue[ADC_CHANNELS_PER_CHIP];
+   ADS7924_SAMPLE_T sample;
+   ADC_CHANNEL_T* pChannel;
+   unsigned int first = __ffs( mask );
+   unsigned int last  = __fls( mask );
+   unsigned int i;
+   bool error;
+   u64 timestamp;
+
+   error = adcReadAnalogValues( pChip, first, last - first + 1, aValue ) < 0;
+   timestamp = ktime_get_ns();
+   pChip->burst.failed  &= ~mask;
+   pChip->burst.dropped &= ~mask;
+   for( i = first; i <= last; i++ )
+   {
+      pChannel = pChip->paChannel[i];
+      if( ((mask & BIT( i )) == 0) || (pChannel == NULL) )
+         continue;
+      if( error )
+      {
+         invalidateResult( pChannel );
+         pChip->burst.failed |= BIT( i );
+         continue;
+      }
+      /* The pipeline may change each field, so each channel starts afresh. */
+      sample.timestamp = timestamp;
+      sample.value     = aValue[i - first];
+      sample.channel   = i;
+      sample.flags     = 0;
+      sample.dummy     = 0;
+      if( adcHasPipeline( pChannel ) && !adcRunPipeline( pChannel, &sample ) )
+      {
+         /* Dropped, the previous result remains. */
+         pChip->burst.dropped |= BIT( i );
+         continue;
+      }
+      publishResult( pChannel, &sample );
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924acquisition.h
+ */
+int adcCoalescedRead( ADC_CHANNEL_T* pChannel )
+{
+   ADS7924_T* pChip = pChannel->pParent;
+   const u8 bit = BIT( pChannel->cannelNumber );
+   unsigned int arrival;
+   u8 mask;
+   int ret = 0;
+
+   spin_lock( &pChip->burst.oLock );
+   pChip->burst.request |= bit;
+   arrival = pChip->burst.started;
+   spin_unlock( &pChip->burst.oLock );
+
+   /*
+    * A interrupted reader leaves its bit in burst.request,
+    * the next burst reads this channel unnecessarily only.
+    */
+   if( mutex_lock_interruptible( &pChip->burst.oMutex ) )
+      return -ERESTARTSYS;
+
+   if( (int)(pChip->burst.completed - arrival) > 0 )
+   {
+      /*
+       * A burst which has been started after the arrival of this request
+       * has read this channel meanwhile.
+       */
+      DEBUG_MESSAGE( ": Coalesced read of channel %d\n", pChannel->cannelNumber );
+      pChip->burst.served++;
+   }
+   else
+   {
+      /*
+       * All started bursts are completed, so the bit of this request
+       * is still part of burst.request.
+       */
+      spin_lock( &pChip->burst.oLock );
+      mask = pChip->burst.request;
+      pChip->burst.request = 0;
+      pChip->burst.started++;
+      spin_unlock( &pChip->burst.oLock );
+
+      readBurst( pChip, mask );
+      pChip->burst.completed = pChip->burst.started;
+   }
+
+   if( (pChip->burst.failed & bit) != 0 )
+      ret = -EIO;
+   else if( (pChip->burst.dropped & bit) != 0 )
+      ret = 1;
+   mutex_unlock( &pChip->burst.oMutex );
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924acquisition.h
+ */
+int adcCachedRead( ADC_CHANNEL_T* pChannel )
+{
+   const s64 maxAge = (s64)READ_ONCE( pChannel->maxAge ) * NSEC_PER_USEC;
+   unsigned int seq;
+   u64 timestamp;
+   u32 sequence;
+
+   do
+   {
+      seq = read_seqbegin( &pChannel->result.oLock );
+      timestamp = pChannel->result.timestamp;
+      sequence  = pChannel->result.sequence;
+   }
+   while( read_seqretry( &pChannel->result.oLock, seq ) );
+
+   /*
+    * A reconstructed timestamp can be slightly in the future,
+    * that counts as age zero.
+    */
+   if( (sequence != 0) && ((s64)(ktime_get_ns() - timestamp) <= maxAge) )
+      return 0;
+
+   return adcCoalescedRead( pChannel );
+}
+
+/*================================== EOF ====================================*/
@@ -0,0 +1,94 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924acquisition.h
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Acquisition of analog values on demand of the application.
+ * @date 2026.10.18
+ * @see ads7924acquisition.c
+ */
+#ifndef _ADS7924ACQUISITION_H
+#define _ADS7924ACQUISITION_H
+
+#include "ads7924driver.h"
+
+/*!----------------------------------------------------------------------------
+ * @brief Initializes the objects of the on-demand conversion of the
+ *        given chip.
+ */
+extern void adcInitAcquisition( ADS7924_T* pChip );
+
+/*!----------------------------------------------------------------------------
+ * @brief Provides a fresh analog value of the given channel in
+ *        pChannel->result.
+ *
+ * When the chip isn't in a automatic mode a single conversion becomes
+ * started, the waiting time follows from ACQCONFIG.
+ * Concurrent requests becomes coalesced: A request which arrives during
+ * a running conversion waits and takes the result of the next conversion
+ * which has been started after its arrival, that can also be the one of
+ * a other caller.
+ * @retval ==0 OK
+ * @retval <0  Error
+ * @see ADS7924_IOCTL_SET_FRESH_READ
+ */
+extern int adcFreshConversion( ADC_CHANNEL_T* pChannel );
+
+/*!----------------------------------------------------------------------------
+ * @brief Waits for the next conversion of the given channel and provides
+ *        its value in pChannel->result.
+ *
+ * In the automatic modes the end of the next conversion becomes predicted
+ * by adcPredictConversion, the caller sleeps until then and reads the
+ * data register. In the other modes it's the same as adcFreshConversion.
+ * @retval ==0 OK
+ * @retval >0  Sample dropped by the pipeline, the previous result remains.
+ * @retval -ERESTARTSYS Interrupted by a signal.
+ * @retval <0  Error
+ * @see ADS7924_FRESH_READ_NEXT_SCAN
+ */
+extern int adcWaitNextConversion( ADC_CHANNEL_T* pChannel );
+
+/*!----------------------------------------------------------------------------
+ * @brief Reads the data register of the given channel without starting
+ *        a conversion and publishes it in pChannel->result.
+ *
+ * Concurrent requests of all channels of the same chip becomes coalesced
+ * (single-flight): Only one reader at a time performs a I2C-transfer,
+ * which reads all data registers requested meanwhile by a single burst.
+ * The readers arriving during this transfer wait and are served by the
+ * next burst, so the number of bus transactions doesn't grow with the
+ * number of concurrent readers.
+ * @retval ==0 OK
+ * @retval >0  Sample dropped by the pipeline, the previous result remains.
+ * @retval -ERESTARTSYS Interrupted by a signal.
+ * @retval <0  Error
+ */
+extern int adcCoalescedRead( ADC_CHANNEL_T* pChannel );
+
+/*!----------------------------------------------------------------------------
+ * @brief Keeps the result of the channel if it is younger than
+ *        pChannel->maxAge, otherwise refreshes it by adcCoalescedRead.
+ * @retval ==0 OK
+ * @retval >0  Sample dropped by the pipeline, the previous result remains.
+ * @retval <0  Error
+ * @see ADS7924_IOCTL_SET_MAX_AGE
+ */
+extern int adcCachedRead( ADC_CHANNEL_T* pChannel );
+
+#endif /* ifndef _ADS7924ACQUISITION_H */
+/*================================== EOF ====================================*/
@@ -0,0 +1,371 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924async.c
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Asynchronous register operations, executed by a worker of each
+ *        I2C-bus.
+ * @date 2026.10.18
+ * @see ads7924async.h
+ */
+#include "ads7924async.h"
+#include "ads7924core.h"
+#include "ads7924sequencer.h"
+#include <linux/slab.h>
+#include <linux/eventfd.h>
+
+/*!----------------------------------------------------------------------------
+ * @brief Access functions of a register addressable by ADS7924_ASYNC_T::reg
+ */
+typedef struct
+{
+   int (*read)( ADS7924_T* pChip, u8* pValue );
+   int (*write)( ADS7924_T* pChip, u8 value );
+   int (*edit)( ADS7924_T* pChip, u8 set, u8 clear ); //!<@brief NULL if not editable.
+} REGISTER_ACCESS_T;
+
+/*!----------------------------------------------------------------------------
+ * @brief Register table indexed by ADS7924_ASYNC_T::reg
+ */
+static const REGISTER_ACCESS_T mg_aRegisterAccess[] =
+{
+   [ADS7924_ASYNC_REG_MODE]      = { adcReadModeByte,  adcWriteModeByte,  NULL             },
+   [ADS7924_ASYNC_REG_INTCONFIG] = { adcReadIntConfig, adcWriteIntConfig, adcEditIntConfig },
+   [ADS7924_ASYNC_REG_SLPCONFIG] = { adcReadSlpConfig, adcWriteSlpConfig, adcEditSlpConfig },
+   [ADS7924_ASYNC_REG_ACQCONFIG] = { adcReadAcqConfig, adcWriteAcqConfig, adcEditAcqConfig },
+   [ADS7924_ASYNC_REG_PWRCONFIG] = { adcReadPwrConfig, adcWritePwrConfig, adcEditPwrConfig }
+};
+
+/*!----------------------------------------------------------------------------
+ * @brief Performs the I2C-transfers of the operation.
+ * @return Value of ADS7924_ASYNC_RESULT_T::status
+ */
+static int execute( ASYNC_OPERATION_T* pOperation )
+{
+   const REGISTER_ACCESS_T* pAccess = &mg_aRegisterAccess[pOperation->request.reg];
+   ADS7924_T* pChip = pOperation->pChip;
+   u8 value;
+
+   switch( pOperation->request.operation )
+   {
+      case ADS7924_ASYNC_READ:
+      {
+         if( pAccess->read( pChip, &value ) < 0 )
+            return -EIO;
+         if( pOperation->request.reg == ADS7924_ASYNC_REG_MODE )
+            value &= ADS7924_MODE_AUTO_BURST_SCAN_SLEEP;
+         pOperation->result.value = value;
+         return 0;
+      }
+      case ADS7924_ASYNC_WRITE:
+      {
+         bool isMode = (pOperation->request.reg == ADS7924_ASYNC_REG_MODE);
+         int ret;
+
+         /*
+          * Same ownership rules as ADS7924_IOCTL_SET_MODE, taken at
+          * execution because the sequencer could have been started
+          * meanwhile.
+          */
+         if( isMode && (adcLockMode( pChip ) < 0) )
+            return -EBUSY;
+         ret = pAccess->write( pChip, pOperation->request.value );
+         if( isMode )
+            adcUnlockMode( pChip );
+         if( ret < 0 )
+            return -EIO;
+         return 0;
+      }
+      case ADS7924_ASYNC_EDIT:
+      {
+         if( pAccess->edit( pChip, pOperation->request.value,
+                                   pOperation->request.clear ) < 0 )
+            return -EIO;
+         return 0;
+      }
+   }
+   return -EINVAL;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Worker of a bus: Executes the queued operations until the queue
+ *        is empty.
+ */
+static void onAsyncWork( struct work_struct* pWork )
+{
+   ASYNC_ENGINE_T*    pEngine = container_of( pWork, ASYNC_ENGINE_T, oWork );
+   ASYNC_OPERATION_T* pOperation;
+
+   while( true )
+   {
+      spin_lock( &pEngine->oLock );
+      pOperation = list_first_entry_or_null( &pEngine->oQueue,
+                                             ASYNC_OPERATION_T, oNode );
+      if( pOperation != NULL )
+         list_del( &pOperation->oNode );
+      spin_unlock( &pEngine->oLock );
+      if( pOperation == NULL )
+         break;
+
+      pOperation->result.status    = execute( pOperation );
+      pOperation->result.timestamp = ktime_get_ns();
+
+      spin_lock( &pEngine->oLock );
+      pEngine->completed++;
+      spin_unlock( &pEngine->oLock );
+
+      pOperation->pOnComplete( pOperation );
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924async.h
+ */
+void adcInitAsync( BUS_T* pBus )
+{
+   spin_lock_init( &pBus->async.oLock );
+   INIT_LIST_HEAD( &pBus->async.oQueue );
+   INIT_WORK( &pBus->async.oWork, onAsyncWork );
+   pBus->async.submitted = 0;
+   pBus->async.completed = 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924async.h
+ */
+void adcFreeAsync( BUS_T* pBus )
+{
+   flush_work( &pBus->async.oWork );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924async.h
+ */
+int adcAsyncSubmit( ASYNC_OPERATION_T* pOperation )
+{
+   ASYNC_ENGINE_T* pEngine;
+
+   if( pOperation->request.reg >= ARRAY_SIZE( mg_aRegisterAccess ) )
+      return -EINVAL;
+   switch( pOperation->request.operation )
+   {
+      case ADS7924_ASYNC_READ:
+      case ADS7924_ASYNC_WRITE:
+         break;
+      case ADS7924_ASYNC_EDIT:
+      {
+         if( mg_aRegisterAccess[pOperation->request.reg].edit == NULL )
+            return -EINVAL;
+         break;
+      }
+      default: return -EINVAL;
+   }
+   BUG_ON( pOperation->pOnComplete == NULL );
+
+   pOperation->result.token     = pOperation->request.token;
+   pOperation->result.status    = 0;
+   pOperation->result.operation = pOperation->request.operation;
+   pOperation->result.reg       = pOperation->request.reg;
+   pOperation->result.value     = pOperation->request.value;
+   memset( pOperation->result.dummy, 0, sizeof( pOperation->result.dummy ) );
+
+   pEngine = &pOperation->pChip->pParent->async;
+   spin_lock( &pEngine->oLock );
+   list_add_tail( &pOperation->oNode, &pEngine->oQueue );
+   pEngine->submitted++;
+   spin_unlock( &pEngine->oLock );
+   queue_work( system_wq, &pEngine->oWork );
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Completion callback of the operations submitted by a context.
+ */
+static void onContextCompletion( ASYNC_OPERATION_T* pOperation )
+{
+   ASYNC_CONTEXT_T* pContext = pOperation->pPrivate;
+
+   /*
+    * The wake up happens under the lock, so adcDestroyAsyncContext
+    * can't free the context before this function has left it.
+    */
+   spin_lock( &pContext->oLock );
+   list_add_tail( &pOperation->oNode, &pContext->oDone );
+   pContext->pending--;
+   if( pContext->pEventFd != NULL )
+      eventfd_signal( pContext->pEventFd, 1 );
+   wake_up_all( &pContext->oWaitQueue );
+   spin_unlock( &pContext->oLock );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924async.h
+ */
+ASYNC_CONTEXT_T* adcCreateAsyncContext( ADS7924_T* pChip )
+{
+   ASYNC_CONTEXT_T* pContext;
+
+   pContext = kzalloc( sizeof( ASYNC_CONTEXT_T ), GFP_KERNEL );
+   if( pContext == NULL )
+      return NULL;
+   pContext->pChip = pChip;
+   spin_lock_init( &pContext->oLock );
+   INIT_LIST_HEAD( &pContext->oDone );
+   init_waitqueue_head( &pContext->oWaitQueue );
+   return pContext;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns true if no operation of the context is running.
+ */
+static bool isIdle( ASYNC_CONTEXT_T* pContext )
+{
+   bool ret;
+
+   spin_lock( &pContext->oLock );
+   ret = (pContext->pending == 0);
+   spin_unlock( &pContext->oLock );
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924async.h
+ */
+void adcDestroyAsyncContext( ASYNC_CONTEXT_T* pContext )
+{
+   ASYNC_OPERATION_T* pOperation;
+   ASYNC_OPERATION_T* pNext;
+
+   wait_event( pContext->oWaitQueue, isIdle( pContext ) );
+
+   spin_lock( &pContext->oLock );
+   list_for_each_entry_safe( pOperation, pNext, &pContext->oDone, oNode )
+   {
+      list_del( &pOperation->oNode );
+      kfree( pOperation );
+   }
+   spin_unlock( &pContext->oLock );
+
+   if( pContext->pEventFd != NULL )
+      eventfd_ctx_put( pContext->pEventFd );
+   kfree( pContext );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924async.h
+ */
+int adcAsyncSubmitRequest( ASYNC_CONTEXT_T* pContext, ADS7924_ASYNC_T* pRequest )
+{
+   ASYNC_OPERATION_T* pOperation;
+   int ret;
+
+   pOperation = kmalloc( sizeof( ASYNC_OPERATION_T ), GFP_KERNEL );
+   if( pOperation == NULL )
+      return -ENOMEM;
+   pOperation->pChip       = pContext->pChip;
+   pOperation->request     = *pRequest;
+   pOperation->pOnComplete = onContextCompletion;
+   pOperation->pPrivate    = pContext;
+
+   spin_lock( &pContext->oLock );
+   if( pContext->outstanding >= ADS7924_ASYNC_MAX_OUTSTANDING )
+   {
+      spin_unlock( &pContext->oLock );
+      kfree( pOperation );
+      return -EAGAIN;
+   }
+   pOperation->request.token = ++pContext->nextToken;
+   pContext->outstanding++;
+   pContext->pending++;
+   spin_unlock( &pContext->oLock );
+
+   pRequest->token = pOperation->request.token;
+   ret = adcAsyncSubmit( pOperation );
+   if( ret < 0 )
+   {
+      spin_lock( &pContext->oLock );
+      pContext->outstanding--;
+      pContext->pending--;
+      spin_unlock( &pContext->oLock );
+      kfree( pOperation );
+   }
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924async.h
+ */
+int adcAsyncFetchResult( ASYNC_CONTEXT_T* pContext, ADS7924_ASYNC_RESULT_T* pResult )
+{
+   ASYNC_OPERATION_T* pOperation;
+
+   spin_lock( &pContext->oLock );
+   pOperation = list_first_entry_or_null( &pContext->oDone,
+                                          ASYNC_OPERATION_T, oNode );
+   if( pOperation == NULL )
+   {
+      spin_unlock( &pContext->oLock );
+      return -EAGAIN;
+   }
+   list_del( &pOperation->oNode );
+   pContext->outstanding--;
+   spin_unlock( &pContext->oLock );
+
+   *pResult = pOperation->result;
+   kfree( pOperation );
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924async.h
+ */
+bool adcAsyncHasResult( ASYNC_CONTEXT_T* pContext )
+{
+   bool ret;
+
+   spin_lock( &pContext->oLock );
+   ret = !list_empty( &pContext->oDone );
+   spin_unlock( &pContext->oLock );
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924async.h
+ */
+int adcAsyncSetEventFd( ASYNC_CONTEXT_T* pContext, int fd )
+{
+   struct eventfd_ctx* pEventFd = NULL;
+   struct eventfd_ctx* pPrevious;
+
+   if( fd >= 0 )
+   {
+      pEventFd = eventfd_ctx_fdget( fd );
+      if( IS_ERR( pEventFd ) )
+         return PTR_ERR( pEventFd );
+   }
+
+   spin_lock( &pContext->oLock );
+   pPrevious = pContext->pEventFd;
+   pContext->pEventFd = pEventFd;
+   spin_unlock( &pContext->oLock );
+
+   if( pPrevious != NULL )
+      eventfd_ctx_put( pPrevious );
+   return 0;
+}
+
+/*================================== EOF ====================================*/
@@ -0,0 +1,141 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924async.h
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Asynchronous register operations, executed by a worker of each
+ *        I2C-bus.
+ *
+ * A operation becomes submitted to the ASYNC_ENGINE_T of the bus of its
+ * chip and executed by the worker of this bus by the same functions of
+ * ads7924core.h which the blocking ioctl-commands use. When done the
+ * worker invokes the completion callback of the operation.
+ *
+ * The file descriptors of the chip devices use a ASYNC_CONTEXT_T as
+ * completion target which collects the results for
+ * ADS7924_IOCTL_ASYNC_RESULT and wakes up poll() and a eventfd.
+ * @date 2026.10.18
+ * @see ads7924async.c
+ * @see ASYNC
+ */
+#ifndef _ADS7924ASYNC_H
+#define _ADS7924ASYNC_H
+
+#include "ads7924driver.h"
+
+struct _ASYNC_OPERATION_T; // Resolves the chicken egg problem...
+
+/*!----------------------------------------------------------------------------
+ * @brief Completion callback, invoked by the worker of the bus after the
+ *        execution of the operation.
+ *
+ * The callback becomes the owner of the operation.
+ */
+typedef void (*ASYNC_COMPLETION_T)( struct _ASYNC_OPERATION_T* pOperation );
+
+/*!----------------------------------------------------------------------------
+ * @brief A single asynchronous register operation.
+ */
+typedef struct _ASYNC_OPERATION_T
+{
+   struct list_head        oNode;       //!<@brief Node of the bus queue respectively of the done list.
+   ADS7924_T*              pChip;       //!<@brief Addressed chip.
+   ADS7924_ASYNC_T         request;
+   ADS7924_ASYNC_RESULT_T  result;      //!<@brief Becomes set by the worker.
+   ASYNC_COMPLETION_T      pOnComplete;
+   void*                   pPrivate;    //!<@brief Object of the submitter.
+} ASYNC_OPERATION_T;
+
+/*!----------------------------------------------------------------------------
+ * @brief Submitter and completion target of a file descriptor of a chip
+ *        device.
+ */
+typedef struct
+{
+   ADS7924_T*          pChip;
+   spinlock_t          oLock;       //!<@brief Guards all members below.
+   struct list_head    oDone;       //!<@brief Completed operations in the order of completion.
+   unsigned int        pending;     //!<@brief Submitted but not completed yet.
+   unsigned int        outstanding; //!<@brief Submitted but not fetched yet.
+   u32                 nextToken;
+   wait_queue_head_t   oWaitQueue;  //!<@brief Woken by each completion.
+   struct eventfd_ctx* pEventFd;    //!<@brief NULL if none registered.
+} ASYNC_CONTEXT_T;
+
+/*!----------------------------------------------------------------------------
+ * @brief Initializes the worker of the given bus.
+ */
+extern void adcInitAsync( BUS_T* pBus );
+
+/*!----------------------------------------------------------------------------
+ * @brief Waits until the worker of the given bus has done all submitted
+ *        operations.
+ */
+extern void adcFreeAsync( BUS_T* pBus );
+
+/*!----------------------------------------------------------------------------
+ * @brief Validates the request of the operation and queues the operation
+ *        to the worker of the bus of ASYNC_OPERATION_T::pChip.
+ * @retval ==0 Submitted, the completion callback will be invoked.
+ * @retval <0  Invalid request, the caller keeps the ownership.
+ */
+extern int adcAsyncSubmit( ASYNC_OPERATION_T* pOperation );
+
+/*!----------------------------------------------------------------------------
+ * @brief Allocates the context of a file descriptor of the given chip.
+ * @retval NULL Out of memory.
+ */
+extern ASYNC_CONTEXT_T* adcCreateAsyncContext( ADS7924_T* pChip );
+
+/*!----------------------------------------------------------------------------
+ * @brief Waits for the operations of the context still running and
+ *        frees the context including its unfetched results.
+ */
+extern void adcDestroyAsyncContext( ASYNC_CONTEXT_T* pContext );
+
+/*!----------------------------------------------------------------------------
+ * @brief Submits the request of the user on behalf of the context.
+ * @param pRequest Request, its token becomes set when successful.
+ * @retval ==0 Submitted.
+ * @retval -EAGAIN ADS7924_ASYNC_MAX_OUTSTANDING results are outstanding.
+ * @retval <0  Other error.
+ */
+extern int adcAsyncSubmitRequest( ASYNC_CONTEXT_T* pContext,
+                                  ADS7924_ASYNC_T* pRequest );
+
+/*!----------------------------------------------------------------------------
+ * @brief Removes the oldest result of the context.
+ * @retval ==0 OK
+ * @retval -EAGAIN No result pending.
+ */
+extern int adcAsyncFetchResult( ASYNC_CONTEXT_T* pContext,
+                                ADS7924_ASYNC_RESULT_T* pResult );
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns true if the context has at least one result pending.
+ */
+extern bool adcAsyncHasResult( ASYNC_CONTEXT_T* pContext );
+
+/*!----------------------------------------------------------------------------
+ * @brief Registers the eventfd to signal, fd < 0 removes it.
+ * @retval ==0 OK
+ * @retval <0  Invalid file descriptor.
+ */
+extern int adcAsyncSetEventFd( ASYNC_CONTEXT_T* pContext, int fd );
+
+#endif /* ifndef _ADS7924ASYNC_H */
+/*================================== EOF ====================================*/
@@ -0,0 +1,175 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924bus.c
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Priority arbitration of the I2C-transfers of all chips on a bus.
+ * @date 2026.10.18
+ * @see ads7924bus.h
+ */
+#include "ads7924bus.h"
+
+/*!
+ * @brief Consecutive grants to higher classes after which the lowest
+ *        waiting class gets the bus.
+ */
+#define BUS_AGING_GRANTS 16
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924bus.h
+ */
+void adcInitBusScheduler( BUS_T* pBus )
+{
+   spin_lock_init( &pBus->scheduler.oLock );
+   init_waitqueue_head( &pBus->scheduler.oWaitQueue );
+   pBus->scheduler.busy = false;
+   pBus->scheduler.passed = 0;
+   memset( pBus->scheduler.aWaiting, 0, sizeof( pBus->scheduler.aWaiting ) );
+   memset( pBus->scheduler.aStats, 0, sizeof( pBus->scheduler.aStats ) );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924bus.h
+ */
+BUS_CLASS_T adcBusClassify( ADS7924_T* pChip, bool isDataRead )
+{
+   if( current == READ_ONCE( pChip->pHarvester ) )
+      return BUS_CLASS_HARVEST;
+   if( current == READ_ONCE( g_data.pDiagnostic ) )
+      return BUS_CLASS_DIAG;
+   return isDataRead? BUS_CLASS_USER : BUS_CLASS_CONFIG;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Grants the bus if it's free and no transfer of a higher class
+ *        is waiting, respectively after BUS_AGING_GRANTS passed grants
+ *        only to the lowest waiting class.
+ * @note The caller has to hold pScheduler->oLock.
+ */
+static bool tryGrant( BUS_SCHEDULER_T* pScheduler, BUS_CLASS_T busClass )
+{
+   int i;
+
+   if( pScheduler->busy )
+      return false;
+
+   if( pScheduler->passed >= BUS_AGING_GRANTS )
+   {
+      for( i = BUS_CLASSES - 1; i > busClass; i-- )
+      {
+         if( pScheduler->aWaiting[i] != 0 )
+            return false;
+      }
+   }
+   else
+   {
+      for( i = 0; i < busClass; i++ )
+      {
+         if( pScheduler->aWaiting[i] != 0 )
+            return false;
+      }
+   }
+
+   /* Counting only grants which pass a waiting lower class. */
+   for( i = busClass + 1; i < BUS_CLASSES; i++ )
+   {
+      if( pScheduler->aWaiting[i] != 0 )
+         break;
+   }
+   if( i < BUS_CLASSES )
+      pScheduler->passed++;
+   else
+      pScheduler->passed = 0;
+   pScheduler->busy = true;
+   return true;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Condition of wait_event in adcBusAcquire.
+ */
+static bool tryGrantWaiting( BUS_SCHEDULER_T* pScheduler, BUS_CLASS_T busClass )
+{
+   bool ret;
+
+   spin_lock( &pScheduler->oLock );
+   ret = tryGrant( pScheduler, busClass );
+   if( ret )
+      pScheduler->aWaiting[busClass]--;
+   spin_unlock( &pScheduler->oLock );
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924bus.h
+ */
+void adcBusAcquire( BUS_T* pBus, BUS_CLASS_T busClass )
+{
+   BUS_SCHEDULER_T* pScheduler = &pBus->scheduler;
+   BUS_CLASS_STATS_T* pStats = &pScheduler->aStats[busClass];
+   u64 arrival = ktime_get_ns();
+   u64 latency;
+
+   spin_lock( &pScheduler->oLock );
+   if( !tryGrant( pScheduler, busClass ) )
+   {
+      pScheduler->aWaiting[busClass]++;
+      spin_unlock( &pScheduler->oLock );
+      wait_event( pScheduler->oWaitQueue, tryGrantWaiting( pScheduler, busClass ) );
+      spin_lock( &pScheduler->oLock );
+   }
+   latency = ktime_get_ns() - arrival;
+   pStats->transfers++;
+   pStats->totalWait += latency;
+   if( pStats->maxWait < latency )
+      pStats->maxWait = latency;
+   spin_unlock( &pScheduler->oLock );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924bus.h
+ */
+void adcBusRelease( BUS_T* pBus )
+{
+   BUS_SCHEDULER_T* pScheduler = &pBus->scheduler;
+   bool waiting = false;
+   int i;
+
+   spin_lock( &pScheduler->oLock );
+   pScheduler->busy = false;
+   for( i = 0; i < BUS_CLASSES; i++ )
+      waiting |= (pScheduler->aWaiting[i] != 0);
+   spin_unlock( &pScheduler->oLock );
+
+   /*
+    * All waiters re-check their condition, only the one of the highest
+    * waiting class, after aging the one of the lowest, can get the bus.
+    */
+   if( waiting )
+      wake_up_all( &pScheduler->oWaitQueue );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924bus.h
+ */
+void adcGetBusStats( BUS_T* pBus, BUS_CLASS_STATS_T* paStats )
+{
+   spin_lock( &pBus->scheduler.oLock );
+   memcpy( paStats, pBus->scheduler.aStats, sizeof( pBus->scheduler.aStats ) );
+   spin_unlock( &pBus->scheduler.oLock );
+}
+
+/*================================== EOF ====================================*/
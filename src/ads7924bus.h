@@ -0,0 +1,73 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924bus.h
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Priority arbitration of the I2C-transfers of all chips on a bus.
+ *
+ * The chips on the same I2C-adapter have their own mutexes, but share the
+ * adapter. Each register transfer takes the bus by adcBusAcquire, waiting
+ * transfers are granted in the order of their class BUS_CLASS_T, so a
+ * interrupt thread waits at most for a single running transfer of a other
+ * chip even if /proc becomes dumped meanwhile.
+ *
+ * So that a lower class can't starve, after BUS_AGING_GRANTS consecutive
+ * grants to higher classes whilst a lower one was waiting, the lowest
+ * waiting class gets the next grant. Hence a waiting transfer is granted
+ * after at most BUS_AGING_GRANTS + 1 transfers per class above it, and the
+ * interrupt thread waits in the worst case for two transfers.
+ * @date 2026.10.18
+ * @see ads7924bus.c
+ */
+#ifndef _ADS7924BUS_H
+#define _ADS7924BUS_H
+
+#include "ads7924driver.h"
+
+/*!----------------------------------------------------------------------------
+ * @brief Initializes the arbiter of the given bus.
+ */
+extern void adcInitBusScheduler( BUS_T* pBus );
+
+/*!----------------------------------------------------------------------------
+ * @brief Determines the class of a transfer of the current task.
+ * @param pChip Addressed chip.
+ * @param isDataRead True when the transfer reads data registers only.
+ */
+extern BUS_CLASS_T adcBusClassify( ADS7924_T* pChip, bool isDataRead );
+
+/*!----------------------------------------------------------------------------
+ * @brief Waits until the bus is free and no transfer of a higher class
+ *        is waiting, and takes the bus.
+ * @note Uninterruptible like the chip mutex, the waiting time is limited
+ *       by the transfers of the higher classes and by the aging rule.
+ */
+extern void adcBusAcquire( BUS_T* pBus, BUS_CLASS_T busClass );
+
+/*!----------------------------------------------------------------------------
+ * @brief Gives the bus free and wakes the waiting transfers.
+ */
+extern void adcBusRelease( BUS_T* pBus );
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns a copy of the queueing statistics of all classes.
+ * @param paStats Target of BUS_CLASSES items.
+ */
+extern void adcGetBusStats( BUS_T* pBus, BUS_CLASS_STATS_T* paStats );
+
+#endif /* ifndef _ADS7924BUS_H */
+/*================================== EOF ====================================*/
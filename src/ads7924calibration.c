@@ -0,0 +1,425 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924calibration.c
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Calibration of the analog channels and conversion of the raw
+ *        values into engineering units.
+ *
+ * The conversion happens by integer-arithmetic only: Each channel owns a
+ * lookup table of ADS7924_SCALE_TABLE_SIZE precomputed values, so the
+ * conversion in the read-path is a single indexed memory access.
+ *
+ * Furthermore the automatic offset calibration by the internal
+ * calibration mode (CALCNTL) of the ADS7924 is implemented here.
+ *
+ * @date 2026.10.18
+ * @see ads7924calibration.h
+ * @see CALIBRATION
+ * @see OFFSET_CALIBRATION
+ */
+#include "ads7924calibration.h"
+#include "ads7924core.h"
+#include "ads7924sequencer.h"
+#include "ads7924_dev_tree_names.h"
+#include <linux/slab.h>
+#include <linux/math64.h>
+
+/*!
+ * @brief Fixed point gain Q16.16 for the output in millivolt.
+ */
+#define DEFAULT_GAIN \
+   ((s32)((CONFIG_ADS7924_DEFAULT_AVDD_MILLIVOLT << 16) / ADS7924_SCALE_TABLE_SIZE))
+
+/*!----------------------------------------------------------------------------
+ * @brief Limits a 64 bit result to the range of s32.
+ */
+static inline s32 limitS32( s64 value )
+{
+   if( value > S32_MAX )
+      return S32_MAX;
+   if( value < S32_MIN )
+      return S32_MIN;
+   return (s32)value;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Checks the plausibility of the given calibration.
+ * @retval true Calibration is usable.
+ */
+static bool isCalibrationValid( const ADS7924_CALIBRATION_T* pCalibration )
+{
+   unsigned int i;
+
+   if( pCalibration->numPoints == 0 )
+      return true;
+
+   if( (pCalibration->numPoints < 2) ||
+       (pCalibration->numPoints > ADS7924_MAX_CALIB_POINTS) )
+   {
+      ERROR_MESSAGE( ": Invalid number of calibration points: %u\n",
+                     pCalibration->numPoints );
+      return false;
+   }
+
+   for( i = 0; i < pCalibration->numPoints; i++ )
+   {
+      if( pCalibration->aPoint[i].raw > ADS7924_MAX_VALUE )
+      {
+         ERROR_MESSAGE( ": Raw value of point %u out of range: %u\n",
+                        i, pCalibration->aPoint[i].raw );
+         return false;
+      }
+      if( (i > 0) && (pCalibration->aPoint[i].raw <= pCalibration->aPoint[i-1].raw) )
+      {
+         ERROR_MESSAGE( ": Calibration points not in ascending order at point %u\n", i );
+         return false;
+      }
+   }
+   return true;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Fills the lookup table by the linear equation:
+ *        scaled = ((raw * gain) >> 16) + offset
+ */
+static void buildLinearTable( s32* pTable, const ADS7924_CALIBRATION_T* pCalibration )
+{
+   unsigned int raw;
+
+   for( raw = 0; raw < ADS7924_SCALE_TABLE_SIZE; raw++ )
+   {
+      pTable[raw] = limitS32( ((((s64)raw * pCalibration->gain) + (1 << 15)) >> 16) +
+                              pCalibration->offset );
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Fills the lookup table by linear interpolation between the
+ *        calibration points.
+ *
+ * Raw values outside of the table becomes extrapolated by the first
+ * respectively the last segment.
+ */
+static void buildPiecewiseTable( s32* pTable, const ADS7924_CALIBRATION_T* pCalibration )
+{
+   unsigned int raw;
+   unsigned int seg = 0;
+   const ADS7924_CALIB_POINT_T* p0;
+   const ADS7924_CALIB_POINT_T* p1;
+   s64 numerator;
+   s32 denominator;
+
+   for( raw = 0; raw < ADS7924_SCALE_TABLE_SIZE; raw++ )
+   {
+      while( (seg < pCalibration->numPoints - 2) &&
+             (raw > pCalibration->aPoint[seg+1].raw) )
+         seg++;
+
+      p0 = &pCalibration->aPoint[seg];
+      p1 = &pCalibration->aPoint[seg+1];
+      numerator   = ((s64)p1->scaled - p0->scaled) * ((s32)raw - p0->raw);
+      denominator = p1->raw - p0->raw;
+
+      /* Rounding to the nearest integer. */
+      if( numerator < 0 )
+         numerator -= denominator / 2;
+      else
+         numerator += denominator / 2;
+
+      pTable[raw] = limitS32( p0->scaled + div_s64( numerator, denominator ) );
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Fills the lookup table in dependence of the calibration type.
+ */
+static void buildScaleTable( s32* pTable, const ADS7924_CALIBRATION_T* pCalibration )
+{
+   if( pCalibration->numPoints == 0 )
+      buildLinearTable( pTable, pCalibration );
+   else
+      buildPiecewiseTable( pTable, pCalibration );
+}
+
+#if !defined( _ADS7924_NO_DEV_TREE ) || defined(__DOXYGEN__)
+/*!----------------------------------------------------------------------------
+ * @brief Reads the optional calibration properties of the given channel
+ *        from the device-tree.
+ *
+ * E.g.:
+ * @code
+ * channel0;
+ * channel0-gain = <52800>;   // 3300 mV / 4096 in Q16.16
+ * channel0-offset = <0>;
+ * channel1;
+ * channel1-calibration = <0 0  2048 1650  4095 3299>; // <raw scaled>...
+ * @endcode
+ * @note This function will only compiled and used, if the device-tree
+ *       will used (CONFIG_ADS7924_NO_DEV_TREE=N and CONFIG_OF=Y).
+ */
+static void readCalibrationFromDeviceTree( ADC_CHANNEL_T* pChannel )
+{
+   const struct device_node* pNode = pChannel->pParent->pI2cSlave->dev.of_node;
+   ADS7924_CALIBRATION_T calibration = pChannel->oCalibration;
+   u32 aCell[ADS7924_MAX_CALIB_POINTS * 2];
+   char textBuffer[40];
+   s32 value;
+   int n, i;
+
+   snprintf( textBuffer, sizeof(textBuffer),
+             TS(ADS7924_DT_CHANNEL_PROPERTY)"%d"ADS7924_DT_GAIN_SUFFIX,
+             pChannel->cannelNumber );
+   if( of_property_read_s32( pNode, textBuffer, &value ) == 0 )
+      calibration.gain = value;
+
+   snprintf( textBuffer, sizeof(textBuffer),
+             TS(ADS7924_DT_CHANNEL_PROPERTY)"%d"ADS7924_DT_OFFSET_SUFFIX,
+             pChannel->cannelNumber );
+   if( of_property_read_s32( pNode, textBuffer, &value ) == 0 )
+      calibration.offset = value;
+
+   snprintf( textBuffer, sizeof(textBuffer),
+             TS(ADS7924_DT_CHANNEL_PROPERTY)"%d"ADS7924_DT_CALIBRATION_SUFFIX,
+             pChannel->cannelNumber );
+   n = of_property_count_u32_elems( pNode, textBuffer );
+   if( n > 0 )
+   {
+      if( ((n % 2) != 0) || (n > ARRAY_SIZE( aCell )) ||
+          (of_property_read_u32_array( pNode, textBuffer, aCell, n ) != 0) )
+      {
+         ERROR_MESSAGE( ": Property %s invalid, will ignored!\n", textBuffer );
+      }
+      else
+      {
+         calibration.numPoints = n / 2;
+         for( i = 0; i < calibration.numPoints; i++ )
+         {
+            calibration.aPoint[i].raw    = aCell[2*i];
+            calibration.aPoint[i].scaled = (s32)aCell[2*i+1];
+         }
+      }
+   }
+
+   if( isCalibrationValid( &calibration ) )
+      pChannel->oCalibration = calibration;
+   else
+      ERROR_MESSAGE( ": Calibration of channel %d in device-tree invalid, will ignored!\n",
+                     pChannel->cannelNumber );
+
+   DEBUG_MESSAGE( ": Channel %d: gain: %d, offset: %d, points: %u\n",
+                  pChannel->cannelNumber,
+                  pChannel->oCalibration.gain,
+                  pChannel->oCalibration.offset,
+                  pChannel->oCalibration.numPoints );
+}
+#endif /* if !defined( _ADS7924_NO_DEV_TREE ) || defined(__DOXYGEN__) */
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924calibration.h
+ */
+void _ADS7924_INIT adcInitCalibration( ADC_CHANNEL_T* pChannel )
+{
+   memset( &pChannel->oCalibration, 0, sizeof( pChannel->oCalibration ) );
+   pChannel->oCalibration.gain = DEFAULT_GAIN;
+   pChannel->pScaleTable = NULL;
+#ifndef _ADS7924_NO_DEV_TREE
+   readCalibrationFromDeviceTree( pChannel );
+#endif
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924calibration.h
+ */
+void adcFreeCalibration( ADC_CHANNEL_T* pChannel )
+{
+   kfree( pChannel->pScaleTable );
+   pChannel->pScaleTable = NULL;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924calibration.h
+ */
+int adcSetCalibration( ADC_CHANNEL_T* pChannel,
+                       const ADS7924_CALIBRATION_T* pCalibration )
+{
+   if( !isCalibrationValid( pCalibration ) )
+      return -EINVAL;
+
+   mutex_lock( &pChannel->oMutex );
+   pChannel->oCalibration = *pCalibration;
+   /*
+    * A already existing table becomes overwritten in place, otherwise
+    * it will built by the first scaled read.
+    */
+   if( pChannel->pScaleTable != NULL )
+      buildScaleTable( pChannel->pScaleTable, &pChannel->oCalibration );
+   mutex_unlock( &pChannel->oMutex );
+
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924calibration.h
+ */
+void adcGetCalibration( ADC_CHANNEL_T* pChannel,
+                        ADS7924_CALIBRATION_T* pCalibration )
+{
+   mutex_lock( &pChannel->oMutex );
+   *pCalibration = pChannel->oCalibration;
+   mutex_unlock( &pChannel->oMutex );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924calibration.h
+ */
+const s32* adcGetScaleTable( ADC_CHANNEL_T* pChannel )
+{
+   if( pChannel->pScaleTable != NULL )
+      return pChannel->pScaleTable;
+
+   pChannel->pScaleTable = kmalloc_array( ADS7924_SCALE_TABLE_SIZE,
+                                          sizeof( s32 ), GFP_KERNEL );
+   if( pChannel->pScaleTable == NULL )
+   {
+      ERROR_MESSAGE( ": Unable to allocate scale table for channel %d\n",
+                     pChannel->cannelNumber );
+      return NULL;
+   }
+   buildScaleTable( pChannel->pScaleTable, &pChannel->oCalibration );
+   return pChannel->pScaleTable;
+}
+
+/* Automatic offset calibration begin ****************************************/
+/*!----------------------------------------------------------------------------
+ * @see ads7924calibration.h
+ */
+int adcDoOffsetCalibration( ADS7924_T* pChip )
+{
+   s16 aOffset[ADC_CHANNELS_PER_CHIP];
+   ADS7924_OFFSET_ENTRY_T* pEntry;
+   int ret;
+
+   BUILD_BUG_ON( ARRAY_SIZE( aOffset ) != ARRAY_SIZE( pEntry->offset ) );
+
+   ret = adcLockMode( pChip );
+   if( ret < 0 )
+      return ret;
+   mutex_lock( &pChip->offsetCal.oMutex );
+   ret = adcOffsetCalibration( pChip, aOffset );
+   if( ret == 0 )
+   {
+      pChip->offsetCal.index = (pChip->offsetCal.index + 1) % ADS7924_OFFSET_HISTORY_SIZE;
+      if( pChip->offsetCal.count < ADS7924_OFFSET_HISTORY_SIZE )
+         pChip->offsetCal.count++;
+      pEntry = &pChip->offsetCal.aHistory[pChip->offsetCal.index];
+      pEntry->timestamp = ktime_get_ns();
+      memcpy( pEntry->offset, aOffset, sizeof( pEntry->offset ) );
+      DEBUG_MESSAGE( ": Offsets: %d, %d, %d, %d\n",
+                     aOffset[0], aOffset[1], aOffset[2], aOffset[3] );
+   }
+   else
+   {
+      ERROR_MESSAGE( ": adcOffsetCalibration() failed!\n" );
+   }
+   mutex_unlock( &pChip->offsetCal.oMutex );
+   adcUnlockMode( pChip );
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Work function of the automatic offset calibration, reschedules
+ *        itself as long as the interval isn't zero.
+ */
+static void onOffsetCalibrationWork( struct work_struct* pWork )
+{
+   unsigned int interval;
+   ADS7924_T* pChip = container_of( to_delayed_work( pWork ), ADS7924_T, offsetCal.oWork );
+
+   /*
+    * The calibration would disturb the sequencer respectively the group,
+    * so it becomes deferred to the next interval.
+    */
+   if( !adcIsModeOwned( pChip ) )
+      adcDoOffsetCalibration( pChip );
+
+   mutex_lock( &pChip->offsetCal.oMutex );
+   interval = pChip->offsetCal.interval;
+   if( interval != 0 )
+      schedule_delayed_work( &pChip->offsetCal.oWork, msecs_to_jiffies( interval ) );
+   mutex_unlock( &pChip->offsetCal.oMutex );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924calibration.h
+ */
+void _ADS7924_INIT adcInitOffsetCalibration( ADS7924_T* pChip )
+{
+   INIT_DELAYED_WORK( &pChip->offsetCal.oWork, onOffsetCalibrationWork );
+   mutex_init( &pChip->offsetCal.oMutex );
+   pChip->offsetCal.interval = 0;
+   pChip->offsetCal.index    = 0;
+   pChip->offsetCal.count    = 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924calibration.h
+ */
+void adcStopOffsetCalibration( ADS7924_T* pChip )
+{
+   mutex_lock( &pChip->offsetCal.oMutex );
+   pChip->offsetCal.interval = 0;
+   mutex_unlock( &pChip->offsetCal.oMutex );
+   cancel_delayed_work_sync( &pChip->offsetCal.oWork );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924calibration.h
+ */
+void adcSetOffsetCalInterval( ADS7924_T* pChip, unsigned int interval )
+{
+   mutex_lock( &pChip->offsetCal.oMutex );
+   pChip->offsetCal.interval = interval;
+   if( interval != 0 )
+      mod_delayed_work( system_wq, &pChip->offsetCal.oWork, msecs_to_jiffies( interval ) );
+   else
+      cancel_delayed_work( &pChip->offsetCal.oWork );
+   mutex_unlock( &pChip->offsetCal.oMutex );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924calibration.h
+ */
+void adcGetOffsetHistory( ADS7924_T* pChip, ADS7924_OFFSET_HISTORY_T* pHistory )
+{
+   unsigned int i;
+
+   memset( pHistory, 0, sizeof( ADS7924_OFFSET_HISTORY_T ) );
+   mutex_lock( &pChip->offsetCal.oMutex );
+   pHistory->count    = pChip->offsetCal.count;
+   pHistory->interval = pChip->offsetCal.interval;
+   for( i = 0; i < pChip->offsetCal.count; i++ )
+   {
+      pHistory->aEntry[i] = pChip->offsetCal.aHistory[(pChip->offsetCal.index +
+                                                       ADS7924_OFFSET_HISTORY_SIZE - i)
+                                                       % ADS7924_OFFSET_HISTORY_SIZE];
+   }
+   mutex_unlock( &pChip->offsetCal.oMutex );
+}
+/* Automatic offset calibration end ******************************************/
+
+/*================================== EOF ====================================*/
@@ -0,0 +1,113 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924calibration.h
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Calibration of the analog channels and conversion of the raw
+ *        values into engineering units.
+ * @date 2026.10.18
+ * @see ads7924calibration.c
+ * @see CALIBRATION
+ */
+#ifndef _ADS7924CALIBRATION_H
+#define _ADS7924CALIBRATION_H
+
+#include "ads7924driver.h"
+
+/*!----------------------------------------------------------------------------
+ * @brief Number of entries of the scale lookup table.
+ */
+#define ADS7924_SCALE_TABLE_SIZE (ADS7924_MAX_VALUE + 1)
+
+/*!----------------------------------------------------------------------------
+ * @brief Initializes the calibration of the given channel by its default
+ *        values: Output in millivolt related to
+ *        CONFIG_ADS7924_DEFAULT_AVDD_MILLIVOLT.
+ * @note In the case of device-tree the optional properties
+ *       channel[0-3]-gain, channel[0-3]-offset and channel[0-3]-calibration
+ *       will considered.
+ */
+extern void adcInitCalibration( ADC_CHANNEL_T* pChannel );
+
+/*!----------------------------------------------------------------------------
+ * @brief Releases the scale lookup table of the given channel.
+ */
+extern void adcFreeCalibration( ADC_CHANNEL_T* pChannel );
+
+/*!----------------------------------------------------------------------------
+ * @brief Checks and sets a new calibration for the given channel.
+ *
+ * A already existing lookup table becomes rebuilt in place, otherwise
+ * the first scaled read builds it.
+ * @retval ==0 OK
+ * @retval -EINVAL Invalid calibration.
+ */
+extern int adcSetCalibration( ADC_CHANNEL_T* pChannel,
+                              const ADS7924_CALIBRATION_T* pCalibration );
+
+/*!----------------------------------------------------------------------------
+ * @brief Copies the current calibration of the given channel in
+ *        pCalibration.
+ */
+extern void adcGetCalibration( ADC_CHANNEL_T* pChannel,
+                               ADS7924_CALIBRATION_T* pCalibration );
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns the scale lookup table of the given channel, builds it
+ *        if not already done.
+ * @note The caller has to hold pChannel->oMutex.
+ * @retval !=NULL Pointer to ADS7924_SCALE_TABLE_SIZE scaled values.
+ * @retval ==NULL Out of memory.
+ */
+extern const s32* adcGetScaleTable( ADC_CHANNEL_T* pChannel );
+
+/*!----------------------------------------------------------------------------
+ * @brief Initializes the objects of the automatic offset calibration of
+ *        the given chip.
+ * @note The calibration becomes started by adcSetOffsetCalInterval().
+ * @see OFFSET_CALIBRATION
+ */
+extern void adcInitOffsetCalibration( ADS7924_T* pChip );
+
+/*!----------------------------------------------------------------------------
+ * @brief Stops the automatic offset calibration of the given chip.
+ */
+extern void adcStopOffsetCalibration( ADS7924_T* pChip );
+
+/*!----------------------------------------------------------------------------
+ * @brief Sets the interval of the automatic offset calibration in
+ *        milliseconds, 0 stops it.
+ */
+extern void adcSetOffsetCalInterval( ADS7924_T* pChip, unsigned int interval );
+
+/*!----------------------------------------------------------------------------
+ * @brief Performs a offset calibration immediately and stores the result
+ *        in the history.
+ * @retval ==0 OK
+ * @retval -EBUSY The mode is owned by the running sequencer or group.
+ * @retval <0  Other error
+ */
+extern int adcDoOffsetCalibration( ADS7924_T* pChip );
+
+/*!----------------------------------------------------------------------------
+ * @brief Copies the offset history of the given chip in pHistory,
+ *        the newest entry first.
+ */
+extern void adcGetOffsetHistory( ADS7924_T* pChip, ADS7924_OFFSET_HISTORY_T* pHistory );
+
+#endif /* ifndef _ADS7924CALIBRATION_H */
+/*================================== EOF ====================================*/
@@ -0,0 +1,286 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924capture.c
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Pre- and post-trigger capture windows around alarm events.
+ *
+ * Each delivered sample of a capturing channel becomes written into the
+ * ring paHistory. On a trigger the last preTrigger samples of the ring
+ * and the trigger sample becomes copied into paWindow, the following
+ * postTrigger samples becomes appended directly. So the window is
+ * complete without any further copying when the last sample arrives.
+ *
+ * @date 2026.10.18
+ * @see ads7924capture.h
+ * @see CAPTURE
+ */
+#include "ads7924capture.h"
+#include "ads7924stream.h"
+#include <linux/slab.h>
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924capture.h
+ */
+void _ADS7924_INIT adcInitCapture( ADC_CHANNEL_T* pChannel )
+{
+   mutex_init( &pChannel->capture.oMutex );
+   mutex_init( &pChannel->capture.oReadMutex );
+   pChannel->capture.config.mode = ADS7924_CAPTURE_OFF;
+   pChannel->capture.state       = CAPTURE_IDLE;
+   pChannel->capture.paHistory   = NULL;
+   pChannel->capture.paWindow    = NULL;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924capture.h
+ */
+void adcFreeCapture( ADC_CHANNEL_T* pChannel )
+{
+   kfree( pChannel->capture.paHistory );
+   pChannel->capture.paHistory = NULL;
+   kfree( pChannel->capture.paWindow );
+   pChannel->capture.paWindow = NULL;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924capture.h
+ */
+int adcSetCapture( ADC_CHANNEL_T* pChannel, const ADS7924_CAPTURE_T* pConfig )
+{
+   ADS7924_SAMPLE_T* paHistory = NULL;
+   ADS7924_SAMPLE_T* paWindow  = NULL;
+   unsigned int size = pConfig->preTrigger + pConfig->postTrigger + 1;
+
+   switch( pConfig->mode )
+   {
+      case ADS7924_CAPTURE_OFF:
+      {
+         mutex_lock( &pChannel->capture.oReadMutex );
+         mutex_lock( &pChannel->capture.oMutex );
+         pChannel->capture.config.mode = ADS7924_CAPTURE_OFF;
+         pChannel->capture.state = CAPTURE_IDLE;
+         mutex_unlock( &pChannel->capture.oMutex );
+         mutex_unlock( &pChannel->capture.oReadMutex );
+         wakeUpChannel( pChannel );
+         return 0;
+      }
+      case ADS7924_CAPTURE_SINGLE:
+      case ADS7924_CAPTURE_CONTINUOUS: break;
+      default:
+      {
+         ERROR_MESSAGE( ": Unknown capture mode: %d\n", pConfig->mode );
+         return -EINVAL;
+      }
+   }
+
+   if( (size > ADS7924_CAPTURE_MAX_SAMPLES) || (pConfig->lower >= pConfig->upper) )
+   {
+      ERROR_MESSAGE( ": Invalid capture window: %u + %u, %u..%u\n",
+                     pConfig->preTrigger, pConfig->postTrigger,
+                     pConfig->lower, pConfig->upper );
+      return -EINVAL;
+   }
+
+   if( !adcIsStreaming( pChannel ) )
+   {
+      ERROR_MESSAGE( ": Neither streaming nor sequencer is running!\n" );
+      return -EBUSY;
+   }
+
+   if( pConfig->preTrigger > 0 )
+   {
+      paHistory = kmalloc_array( pConfig->preTrigger, sizeof( ADS7924_SAMPLE_T ), GFP_KERNEL );
+      if( paHistory == NULL )
+         return -ENOMEM;
+   }
+   paWindow = kmalloc_array( size, sizeof( ADS7924_SAMPLE_T ), GFP_KERNEL );
+   if( paWindow == NULL )
+   {
+      kfree( paHistory );
+      return -ENOMEM;
+   }
+
+   mutex_lock( &pChannel->capture.oReadMutex );
+   mutex_lock( &pChannel->capture.oMutex );
+   adcFreeCapture( pChannel );
+   pChannel->capture.paHistory = paHistory;
+   pChannel->capture.paWindow  = paWindow;
+   pChannel->capture.history   = 0;
+   pChannel->capture.sequence  = 0;
+   pChannel->capture.missed    = 0;
+   pChannel->capture.inZone    = false;
+   pChannel->capture.config    = *pConfig;
+   pChannel->capture.state     = CAPTURE_ARMED;
+   mutex_unlock( &pChannel->capture.oMutex );
+   mutex_unlock( &pChannel->capture.oReadMutex );
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Writes a sample in the pre-trigger history.
+ */
+static inline void pushHistory( ADC_CHANNEL_T* pChannel, const ADS7924_SAMPLE_T* pSample )
+{
+   if( pChannel->capture.config.preTrigger == 0 )
+      return;
+   pChannel->capture.paHistory[pChannel->capture.history % pChannel->capture.config.preTrigger] = *pSample;
+   pChannel->capture.history++;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Starts a window by the history and the trigger sample.
+ */
+static void trigger( ADC_CHANNEL_T* pChannel, const ADS7924_SAMPLE_T* pSample )
+{
+   const unsigned int pre = pChannel->capture.config.preTrigger;
+   unsigned int n = min( pChannel->capture.history, pre );
+   unsigned int i;
+
+   /* The oldest sample of the history comes first. */
+   for( i = 0; i < n; i++ )
+      pChannel->capture.paWindow[i] = pChannel->capture.paHistory[(pChannel->capture.history - n + i) % pre];
+   pChannel->capture.paWindow[n] = *pSample;
+
+   pChannel->capture.record.timestamp    = pSample->timestamp;
+   pChannel->capture.record.sequence     = pChannel->capture.sequence++;
+   pChannel->capture.record.missed       = pChannel->capture.missed;
+   pChannel->capture.record.count        = n + 1;
+   pChannel->capture.record.triggerIndex = n;
+   pChannel->capture.record.dummy        = 0;
+   pChannel->capture.missed    = 0;
+   pChannel->capture.remaining = pChannel->capture.config.postTrigger;
+   pChannel->capture.state = (pChannel->capture.remaining == 0)? CAPTURE_READY : CAPTURE_POST;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924capture.h
+ */
+void adcCaptureSample( ADC_CHANNEL_T* pChannel, const ADS7924_SAMPLE_T* pSample )
+{
+   bool outside, rising;
+   bool wake = false;
+
+   mutex_lock( &pChannel->capture.oMutex );
+   outside = (pSample->value > pChannel->capture.config.upper) ||
+             (pSample->value < pChannel->capture.config.lower);
+   rising = outside && !pChannel->capture.inZone;
+   pChannel->capture.inZone = outside;
+
+   switch( pChannel->capture.state )
+   {
+      case CAPTURE_ARMED:
+      {
+         if( rising )
+         {
+            trigger( pChannel, pSample );
+            wake = (pChannel->capture.state == CAPTURE_READY);
+         }
+         break;
+      }
+      case CAPTURE_POST:
+      {
+         pChannel->capture.paWindow[pChannel->capture.record.count++] = *pSample;
+         if( --pChannel->capture.remaining == 0 )
+         {
+            pChannel->capture.state = CAPTURE_READY;
+            wake = true;
+         }
+         break;
+      }
+      case CAPTURE_READY:
+      {
+         if( rising )
+            pChannel->capture.missed++;
+         break;
+      }
+      default: /* CAPTURE_IDLE */
+      {
+         mutex_unlock( &pChannel->capture.oMutex );
+         return;
+      }
+   }
+   /*
+    * The history becomes filled in all active states, so a re-armed
+    * capture has its pre-trigger samples immediately.
+    */
+   pushHistory( pChannel, pSample );
+   mutex_unlock( &pChannel->capture.oMutex );
+
+   if( wake )
+      wakeUpChannel( pChannel );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924capture.h
+ */
+ssize_t adcReadCapture( ADC_CHANNEL_T* pChannel, char __user* pBuffer, size_t len )
+{
+   ADS7924_CAPTURE_RECORD_T record;
+   size_t size;
+   ssize_t ret;
+
+   /*
+    * In CAPTURE_READY the producer leaves paWindow alone and
+    * adcSetCapture() is kept away by oReadMutex, so the window can be
+    * copied without holding oMutex.
+    */
+   mutex_lock( &pChannel->capture.oReadMutex );
+   mutex_lock( &pChannel->capture.oMutex );
+   if( pChannel->capture.state != CAPTURE_READY )
+   {
+      mutex_unlock( &pChannel->capture.oMutex );
+      ret = 0;
+      goto L_UNLOCK;
+   }
+   record = pChannel->capture.record;
+   mutex_unlock( &pChannel->capture.oMutex );
+
+   size = record.count * sizeof( ADS7924_SAMPLE_T );
+   if( len < sizeof( ADS7924_CAPTURE_RECORD_T ) + size )
+   {
+      ret = -EINVAL;
+      goto L_UNLOCK;
+   }
+
+   if( (copy_to_user( pBuffer, &record, sizeof( ADS7924_CAPTURE_RECORD_T ) ) != 0) ||
+       (copy_to_user( pBuffer + sizeof( ADS7924_CAPTURE_RECORD_T ), pChannel->capture.paWindow, size ) != 0) )
+   {
+      ERROR_MESSAGE( "copy_to_user: %ld bytes\n", (long int)(sizeof( ADS7924_CAPTURE_RECORD_T ) + size) );
+      ret = -EFAULT;
+      goto L_UNLOCK;
+   }
+   ret = sizeof( ADS7924_CAPTURE_RECORD_T ) + size;
+
+   mutex_lock( &pChannel->capture.oMutex );
+   if( pChannel->capture.config.mode == ADS7924_CAPTURE_CONTINUOUS )
+   {
+      pChannel->capture.state = CAPTURE_ARMED;
+   }
+   else
+   {
+      pChannel->capture.state = CAPTURE_IDLE;
+      pChannel->capture.config.mode = ADS7924_CAPTURE_OFF;
+   }
+   mutex_unlock( &pChannel->capture.oMutex );
+
+L_UNLOCK:
+   mutex_unlock( &pChannel->capture.oReadMutex );
+   return ret;
+}
+
+/*================================== EOF ====================================*/
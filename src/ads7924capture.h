@@ -0,0 +1,86 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924capture.h
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Pre- and post-trigger capture windows around alarm events.
+ * @date 2026.10.18
+ * @see ads7924capture.c
+ * @see CAPTURE
+ */
+#ifndef _ADS7924CAPTURE_H
+#define _ADS7924CAPTURE_H
+
+#include "ads7924driver.h"
+
+/*!----------------------------------------------------------------------------
+ * @brief Initializes the capture object of the given channel.
+ */
+extern void adcInitCapture( ADC_CHANNEL_T* pChannel );
+
+/*!----------------------------------------------------------------------------
+ * @brief Frees the buffers of the capture mode.
+ */
+extern void adcFreeCapture( ADC_CHANNEL_T* pChannel );
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns true if the capture mode of the channel is active.
+ */
+static inline bool adcIsCapturing( ADC_CHANNEL_T* pChannel )
+{
+   return pChannel->capture.config.mode != ADS7924_CAPTURE_OFF;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns true if a complete window waits for reading.
+ */
+static inline bool adcIsCaptureReady( ADC_CHANNEL_T* pChannel )
+{
+   return pChannel->capture.state == CAPTURE_READY;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Sets and arms the capture mode.
+ *
+ * Arming is refused when neither the streaming mode nor the sequencer of
+ * the chip is running, because nobody would deliver samples.
+ * @retval ==0 OK
+ * @retval <0  Error (-EINVAL, -EBUSY or -ENOMEM)
+ */
+extern int adcSetCapture( ADC_CHANNEL_T* pChannel, const ADS7924_CAPTURE_T* pConfig );
+
+/*!----------------------------------------------------------------------------
+ * @brief Feeds a sample into the history and checks the trigger condition.
+ *
+ * Wakes the readers of the channel when a window becomes complete.
+ */
+extern void adcCaptureSample( ADC_CHANNEL_T* pChannel, const ADS7924_SAMPLE_T* pSample );
+
+/*!----------------------------------------------------------------------------
+ * @brief Copies a complete window to the user-space and re-arms respectively
+ *        ends the capture mode.
+ *
+ * The capture mutex is not held during the copying, so the producer
+ * can't be blocked by a page fault of the user buffer.
+ * @retval >0  Number of copied bytes.
+ * @retval ==0 No complete window.
+ * @retval <0  Error (-EINVAL if the buffer is too small or -EFAULT)
+ */
+extern ssize_t adcReadCapture( ADC_CHANNEL_T* pChannel, char __user* pBuffer, size_t len );
+
+#endif /* ifndef _ADS7924CAPTURE_H */
+/*================================== EOF ====================================*/
@@ -22,6 +22,9 @@
  * @see ads7924core.h
  */
 #include "ads7924core.h"
+#include "ads7924timing.h"
+#include "ads7924pipeline.h"
+#include "ads7924bus.h"
 
 /*!
  * @brief Lock I2C-device
@@ -33,6 +36,20 @@
  */
 #define UNLOCK_I2C( pChip ) mutex_unlock( &pChip->oI2cMutex )
 
+/*!
+ * @brief Invalidates the shadow of the timing registers,
+ *        shall be used within LOCK_I2C and UNLOCK_I2C only.
+ * @see adcReadTimingShadow
+ */
+#define INVALIDATE_TIMING( pChip ) (pChip)->timingShadow.valid = false
+
+/*!
+ * @brief Records the start of a scan by writing MODECNTRL,
+ *        shall be used within LOCK_I2C and UNLOCK_I2C only.
+ * @see adcGetModeTimestamp
+ */
+#define STAMP_MODE( pChip ) (pChip)->timingShadow.modeTimestamp = ktime_get_ns()
+
 
 #define READ_CONTINUE  0x80
 
@@ -145,26 +162,41 @@ const char* getModeName( int mode )
 ssize_t _readAdcRegister( struct i2c_client* poI2cClient, u8 address, void* pData, size_t size )
 {
    ssize_t ret;
+   ADS7924_T* pChip;
 
    BUG_ON( poI2cClient == NULL );
    BUG_ON( size == 0 );
    BUG_ON( address + size > MAX_ADC_ADDRESS+1 );
 
+   /* NULL during the probing of the chip only. */
+   pChip = i2c_get_clientdata( poI2cClient );
+   if( pChip != NULL )
+      adcBusAcquire( pChip->pParent,
+                     adcBusClassify( pChip, (address >= DATA0_U) &&
+                                            (address + size <= DATA3_L + 1) ) );
+
    if( size > 1 )
       address |= READ_CONTINUE;
 
+   /*
+    * Setting of the register pointer and reading belongs together,
+    * so both are a single scheduled transfer.
+    */
    ret = i2c_master_send( poI2cClient, &address, sizeof( address ) );
    if( ret < 0 )
    {
       ERROR_MESSAGE( ": Unable to send address 0x%02X %s to ADS7924\n",
                      address, getRegisterName( address ) );
-      return ret;
+      goto L_RELEASE;
    }
    ret = i2c_master_recv( poI2cClient, pData, size );
    if( ret < 0 )
       ERROR_MESSAGE( ": Unable to receive %d bytes from ADS7924 register %s\n",
                      size, getRegisterName( address ) );
 
+L_RELEASE:
+   if( pChip != NULL )
+      adcBusRelease( pChip->pParent );
    return ret;
 }
 
@@ -175,6 +207,7 @@ ssize_t _readAdcRegister( struct i2c_client* poI2cClient, u8 address, void* pDat
 ssize_t _writeAdcRegister( struct i2c_client* poI2cClient, u8 address, void* const pData, size_t size )
 {
    ssize_t ret;
+   ADS7924_T* pChip;
 
    u8* buffer = kmalloc( size + sizeof( address ), GFP_KERNEL );
    if( buffer == NULL )
@@ -193,7 +226,12 @@ ssize_t _writeAdcRegister( struct i2c_client* poI2cClient, u8 address, void* con
    buffer[0] = address;
    memcpy( &buffer[1], pData, size );
 
+   pChip = i2c_get_clientdata( poI2cClient );
+   if( pChip != NULL )
+      adcBusAcquire( pChip->pParent, adcBusClassify( pChip, false ) );
    ret = i2c_master_send( poI2cClient, buffer, size + sizeof( address ) );
+   if( pChip != NULL )
+      adcBusRelease( pChip->pParent );
    if( ret < 0 )
       ERROR_MESSAGE( "Unable to send %d bytes to ADS7924 register %s\n",
                      size, getRegisterName( address ) );
@@ -252,6 +290,7 @@ int adcChipReset( ADS7924_T* pChip )
       pChip->shadowAlarmStatus = 0;
       pChip->afterReset = true; /* Discard the first interrupt */
    }
+   INVALIDATE_TIMING( pChip );
    UNLOCK_I2C( pChip );
    return ret;
 }
@@ -308,6 +347,8 @@ int adcWriteModeByte( ADS7924_T* pChip, u8 mode )
 
    LOCK_I2C( pChip );
    ret = _adcWriteModeByte( pChip->pI2cSlave, mode );
+   INVALIDATE_TIMING( pChip );
+   STAMP_MODE( pChip );
    UNLOCK_I2C( pChip );
    return ret;
 }
@@ -466,6 +507,7 @@ int adcWriteSlpConfig( ADS7924_T* pChip, u8 slpConfig )
 
    LOCK_I2C( pChip );
    ret = _adcWriteSlpConfig( pChip->pI2cSlave, slpConfig );
+   INVALIDATE_TIMING( pChip );
    UNLOCK_I2C( pChip );
    return ret;
 }
@@ -485,6 +527,7 @@ int adcEditSlpConfig( ADS7924_T* pChip, u8 set, u8 clear )
 
    LOCK_I2C( pChip );
    ret = _adcEditSlpConfig( pChip->pI2cSlave, set, clear );
+   INVALIDATE_TIMING( pChip );
    UNLOCK_I2C( pChip );
    return ret;
 }
@@ -523,6 +566,7 @@ int adcWriteAcqConfig( ADS7924_T* pChip, u8 acqConfig )
 
    LOCK_I2C( pChip );
    ret = _adcWriteAcqConfig( pChip->pI2cSlave, acqConfig );
+   INVALIDATE_TIMING( pChip );
    UNLOCK_I2C( pChip );
    return ret;
 }
@@ -542,6 +586,7 @@ int adcEditAcqConfig( ADS7924_T* pChip, u8 set, u8 clear )
 
    LOCK_I2C( pChip );
    ret = _adcEditAcqConfig( pChip->pI2cSlave, set, clear );
+   INVALIDATE_TIMING( pChip );
    UNLOCK_I2C( pChip );
    return ret;
 }
@@ -580,6 +625,7 @@ int adcWritePwrConfig( ADS7924_T* pChip, u8 pwrConfig )
 
    LOCK_I2C( pChip );
    ret = _adcWritePwrConfig( pChip->pI2cSlave, pwrConfig );
+   INVALIDATE_TIMING( pChip );
    UNLOCK_I2C( pChip );
    return ret;
 }
@@ -599,6 +645,7 @@ int adcEditPwrConfig( ADS7924_T* pChip, u8 set, u8 clear )
 
    LOCK_I2C( pChip );
    ret = _adcEditPwrConfig( pChip->pI2cSlave, set, clear );
+   INVALIDATE_TIMING( pChip );
    UNLOCK_I2C( pChip );
    return ret;
 }
@@ -607,9 +654,20 @@ int adcEditPwrConfig( ADS7924_T* pChip, u8 set, u8 clear )
  * @see ads7924core.h
  */
 int readAnalogValue( ADC_CHANNEL_T* poCannel )
+{
+   return readAnalogSample( poCannel, 0, 0 );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924core.h
+ */
+int readAnalogSample( ADC_CHANNEL_T* poCannel, u64 timestamp, u64 period )
 {
    u8 analog[2];
    ssize_t ret;
+   s16 offset;
+   u64 readTime;
+   ADS7924_SAMPLE_T sample;
 
    //STATIC_ASSERT( sizeof( poCannel->result.value ) == sizeof( analog ) );
 
@@ -617,38 +675,61 @@ int readAnalogValue( ADC_CHANNEL_T* poCannel )
    BUG_ON( poCannel->cannelNumber >= ARRAY_SIZE( g_ads7924InternList ) );
 
    LOCK_I2C( poCannel->pParent );
+   readTime = ktime_get_ns();
    ret = _readAdcRegister( poCannel->pParent->pI2cSlave,
                            g_ads7924InternList[poCannel->cannelNumber].dataAddrUpper,
                            analog,
                            sizeof( analog ));
+   /*
+    * The offset becomes taken under the same lock like the analog value,
+    * so a concurrent offset calibration can't mix old values with new
+    * offsets.
+    */
+   offset = poCannel->offset;
    UNLOCK_I2C( poCannel->pParent );
-   mutex_lock( &poCannel->result.oMutex );
-   poCannel->result.isValid = (ret == sizeof( analog ));
-   if( poCannel->result.isValid )
+   if( ret != sizeof( analog ) )
    {
-   #if (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || (__BYTE_ORDER__ == __ORDER_PDP_ENDIAN__)
-     /*
-      * If the bit size doesn't exceed 16 bit so we can handle the byte order
-      * "PDP_ENDIAN" like "LITTLE_ENDIAN".
-      */
-     ((u8*)&poCannel->result.value)[0] = analog[1];
-     ((u8*)&poCannel->result.value)[1] = analog[0];
-   #elif (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
-     ((u8*)&poCannel->result.value)[0] = analog[0];
-     ((u8*)&poCannel->result.value)[1] = analog[1];
-   #else
-     #error "Extremely fatal: Byte order (little or big endian) is unclear!"
-   #endif
-      poCannel->result.value >>= 4;
-      DEBUG_MESSAGE( ": Analog-value of channel %d: 0x%02X%02X -> 0x%04X\n",
-                     poCannel->cannelNumber,
-                     analog[0], analog[1],
-                     poCannel->result.value
-                   );
+      invalidateResult( poCannel );
+      return -1;
    }
-   mutex_unlock( &poCannel->result.oMutex );
 
-   return (ret < 0)? -1: 0;
+   if( timestamp == 0 )
+   {
+      sample.timestamp = readTime;
+      sample.flags = 0;
+   }
+   else
+   {
+      sample.timestamp = adcAlignToRead( timestamp, period, readTime );
+      sample.flags = ADS7924_SAMPLE_RECONSTRUCTED;
+   }
+#if (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || (__BYTE_ORDER__ == __ORDER_PDP_ENDIAN__)
+  /*
+   * If the bit size doesn't exceed 16 bit so we can handle the byte order
+   * "PDP_ENDIAN" like "LITTLE_ENDIAN".
+   */
+  ((u8*)&sample.value)[0] = analog[1];
+  ((u8*)&sample.value)[1] = analog[0];
+#elif (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+  ((u8*)&sample.value)[0] = analog[0];
+  ((u8*)&sample.value)[1] = analog[1];
+#else
+  #error "Extremely fatal: Byte order (little or big endian) is unclear!"
+#endif
+   sample.value >>= 4;
+   sample.value = adcApplyOffset( sample.value, offset );
+   DEBUG_MESSAGE( ": Analog-value of channel %d: 0x%02X%02X -> 0x%04X\n",
+                  poCannel->cannelNumber,
+                  analog[0], analog[1],
+                  sample.value
+                );
+
+   if( adcHasPipeline( poCannel ) && !adcRunPipeline( poCannel, &sample ) )
+      return 1;
+
+   publishResult( poCannel, &sample );
+
+   return 0;
 }
 
 /*!----------------------------------------------------------------------------
@@ -723,6 +804,539 @@ int adcReadLowerLimitThreshold( ADC_CHANNEL_T* poCannel, u8* pThreshold )
    return ret;
 }
 
+/*!----------------------------------------------------------------------------
+ * @see ads7924core.h
+ */
+int adcOffsetCalibration( ADS7924_T* pChip, s16* paOffset )
+{
+   u8 mode;
+   u8 config[2]; /* ACQCONFIG and PWRCONFIG */
+   u8 data[DATA3_L - DATA0_U + 1];
+   unsigned int waitTime;
+   int i, ret;
+
+   LOCK_I2C( pChip );
+   ret = _adcReadModeByte( pChip->pI2cSlave, &mode );
+   if( ret < 0 )
+      goto L_UNLOCK;
+   ret = _readAdcRegister( pChip->pI2cSlave, ACQCONFIG, config, sizeof( config ) );
+   if( ret < 0 )
+      goto L_UNLOCK;
+
+   /*
+    * Suppressing of alarms, the grounded inputs would release them.
+    */
+   ret = _adcWriteIntCtrl( pChip->pI2cSlave, 0 );
+   if( ret < 0 )
+      goto L_UNLOCK;
+
+   /*
+    * Duration of a manual scan: tPWRUP + 4 * (tACQ + tCONV)
+    * See ADS7924.pdf chapter "Timing".
+    */
+   waitTime = 2 * (config[1] & ADS7924_PWRUPTIME_MASK) +
+              ADC_CHANNELS_PER_CHIP * (2 * (config[0] & ADS7924_ACQTIME_MASK) + 6 + 4);
+
+   ret = _adcWritePwrConfig( pChip->pI2cSlave, config[1] | CALCNTL );
+   if( ret < 0 )
+      goto L_RESTORE;
+
+   ret = _adcWriteModeByte( pChip->pI2cSlave, ADS7924_MODE_MANUAL_SCAN );
+   if( ret < 0 )
+      goto L_RESTORE;
+   usleep_range( waitTime, 2 * waitTime );
+
+   ret = _readAdcRegister( pChip->pI2cSlave, DATA0_U, data, sizeof( data ) );
+   if( ret == sizeof( data ) )
+   {
+      for( i = 0; i < ADC_CHANNELS_PER_CHIP; i++ )
+      {
+         paOffset[i] = ((data[2*i] << 8) | data[2*i+1]) >> 4;
+         if( pChip->paChannel[i] != NULL )
+            pChip->paChannel[i]->offset = paOffset[i];
+      }
+   }
+   else if( ret >= 0 )
+   {
+      ret = -EIO;
+   }
+
+L_RESTORE:
+   i = _adcWritePwrConfig( pChip->pI2cSlave, config[1] );
+   if( (i < 0) && (ret >= 0) )
+      ret = i;
+   /*
+    * The data registers still hold the grounded inputs, a normal scan
+    * overwrites them before the readers, the interrupt and the restored
+    * mode could take them as samples.
+    */
+   if( (i >= 0) && (_adcWriteModeByte( pChip->pI2cSlave, ADS7924_MODE_MANUAL_SCAN ) >= 0) )
+      usleep_range( waitTime, 2 * waitTime );
+   WRITE_ONCE( pChip->calibrationEnd, ktime_get_ns() );
+   i = _adcWriteModeByte( pChip->pI2cSlave, mode );
+   STAMP_MODE( pChip );
+   if( (i < 0) && (ret >= 0) )
+      ret = i;
+   i = _adcWriteIntCtrl( pChip->pI2cSlave, pChip->shadowAlarmStatus );
+   if( (i < 0) && (ret >= 0) )
+      ret = i;
+
+L_UNLOCK:
+   UNLOCK_I2C( pChip );
+   return (ret < 0)? ret : 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924core.h
+ */
+int adcWriteTimingConfig( ADS7924_T* pChip, u8 mode, u8* paConfig, const u8* paMask )
+{
+   u8 current[PWRCONFIG - SLPCONFIG + 1];
+   int i, ret;
+
+   LOCK_I2C( pChip );
+   INVALIDATE_TIMING( pChip );
+   ret = _readAdcRegister( pChip->pI2cSlave, SLPCONFIG, current, sizeof( current ) );
+   if( ret < 0 )
+      goto L_UNLOCK;
+
+   for( i = 0; i < ARRAY_SIZE( current ); i++ )
+      paConfig[i] = (current[i] & ~paMask[i]) | (paConfig[i] & paMask[i]);
+
+   ret = _adcWriteModeByte( pChip->pI2cSlave, ADS7924_MODE_AWAKE );
+   if( ret < 0 )
+      goto L_UNLOCK;
+
+   ret = _writeAdcRegister( pChip->pI2cSlave, SLPCONFIG, paConfig, sizeof( current ) );
+   if( ret < 0 )
+      goto L_UNLOCK;
+
+   ret = _adcWriteModeByte( pChip->pI2cSlave, mode );
+   STAMP_MODE( pChip );
+
+L_UNLOCK:
+   UNLOCK_I2C( pChip );
+   return (ret < 0)? ret : 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924core.h
+ */
+int adcConvertChannel( ADC_CHANNEL_T* poCannel, unsigned int waitTime,
+                       VALUE_T* pValue, u64* pStart )
+{
+   ADS7924_T* pChip = poCannel->pParent;
+   u8 analog[2];
+   u8 prevMode;
+   int ret;
+
+   BUG_ON( poCannel->cannelNumber < 0 );
+   BUG_ON( poCannel->cannelNumber >= ARRAY_SIZE( g_ads7924InternList ) );
+
+   *pStart = 0;
+   LOCK_I2C( pChip );
+   ret = _adcReadModeByte( pChip->pI2cSlave, &prevMode );
+   if( ret < 0 )
+      goto L_UNLOCK;
+
+   if( (prevMode & MODE0) == 0 )
+   {
+      /*
+       * Chip isn't in a automatic mode, so the data register contains
+       * a stale value: Start a single conversion of this channel.
+       */
+      ret = _adcWriteModeByte( pChip->pI2cSlave,
+                               ADS7924_MODE_MANUAL_SINGLE | poCannel->cannelNumber );
+      if( ret < 0 )
+         goto L_UNLOCK;
+      *pStart = ktime_get_ns();
+      usleep_range( DIV_ROUND_UP( waitTime, 1000 ), DIV_ROUND_UP( 2 * waitTime, 1000 ) );
+   }
+
+   ret = _readAdcRegister( pChip->pI2cSlave,
+                           g_ads7924InternList[poCannel->cannelNumber].dataAddrUpper,
+                           analog,
+                           sizeof( analog ));
+   if( ret == sizeof( analog ) )
+   {
+      *pValue = adcApplyOffset( ((analog[0] << 8) | analog[1]) >> 4, poCannel->offset );
+      ret = 0;
+   }
+   else if( ret >= 0 )
+   {
+      ret = -EIO;
+   }
+
+   /* Restoring of the previous mode including SEL_ID. */
+   if( _adcWriteModeByte( pChip->pI2cSlave, prevMode ) < 0 )
+      ret = -EIO;
+   STAMP_MODE( pChip );
+
+L_UNLOCK:
+   UNLOCK_I2C( pChip );
+   return (ret < 0)? ret : 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924core.h
+ */
+int adcConvertScan( ADS7924_T* pChip, unsigned int waitTime,
+                    VALUE_T* paValue, u64* pStart )
+{
+   u8 analog[DATA3_L - DATA0_U + 1];
+   u8 prevMode;
+   unsigned int i;
+   int ret;
+
+   *pStart = 0;
+   LOCK_I2C( pChip );
+   ret = _adcReadModeByte( pChip->pI2cSlave, &prevMode );
+   if( ret < 0 )
+      goto L_UNLOCK;
+
+   /*
+    * Outside of a scan mode the data registers contain stale values or
+    * values of different conversions. In the automatic scan modes the
+    * burst read below could straddle two scans, because the window
+    * between the end of a scan and the first conversion of the next one
+    * is shorter than the transfer. So a own scan of all channels becomes
+    * started in each mode.
+    */
+   ret = _adcWriteModeByte( pChip->pI2cSlave, ADS7924_MODE_MANUAL_SCAN );
+   if( ret < 0 )
+   {
+      INVALIDATE_TIMING( pChip );
+      goto L_UNLOCK;
+   }
+   *pStart = ktime_get_ns();
+   usleep_range( DIV_ROUND_UP( ADC_CHANNELS_PER_CHIP * waitTime, 1000 ),
+                 DIV_ROUND_UP( 2 * ADC_CHANNELS_PER_CHIP * waitTime, 1000 ) );
+
+   ret = _readAdcRegister( pChip->pI2cSlave, DATA0_U, analog, sizeof( analog ) );
+   if( ret == sizeof( analog ) )
+   {
+      for( i = 0; i < ADC_CHANNELS_PER_CHIP; i++ )
+      {
+         paValue[i] = ((analog[2*i] << 8) | analog[2*i+1]) >> 4;
+         if( pChip->paChannel[i] != NULL )
+            paValue[i] = adcApplyOffset( paValue[i], pChip->paChannel[i]->offset );
+      }
+      ret = 0;
+   }
+   else if( ret >= 0 )
+   {
+      ret = -EIO;
+   }
+
+   /* Restoring of the previous mode including SEL_ID. */
+   if( _adcWriteModeByte( pChip->pI2cSlave, prevMode ) < 0 )
+      ret = -EIO;
+   STAMP_MODE( pChip );
+
+L_UNLOCK:
+   UNLOCK_I2C( pChip );
+   return (ret < 0)? ret : 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924core.h
+ */
+int adcReadAnalogValues( ADS7924_T* pChip, unsigned int first,
+                         unsigned int count, VALUE_T* paValue )
+{
+   u8 analog[DATA3_L - DATA0_U + 1];
+   const ssize_t size = 2 * count;
+   ssize_t ret;
+   unsigned int i;
+
+   BUG_ON( (count == 0) || ((first + count) > ADC_CHANNELS_PER_CHIP) );
+
+   LOCK_I2C( pChip );
+   ret = _readAdcRegister( pChip->pI2cSlave,
+                           g_ads7924InternList[first].dataAddrUpper,
+                           analog, size );
+   if( ret == size )
+   {
+      for( i = 0; i < count; i++ )
+      {
+         paValue[i] = ((analog[2*i] << 8) | analog[2*i+1]) >> 4;
+         if( pChip->paChannel[first + i] != NULL )
+            paValue[i] = adcApplyOffset( paValue[i], pChip->paChannel[first + i]->offset );
+      }
+   }
+   UNLOCK_I2C( pChip );
+   return (ret == size)? 0 : -EIO;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924core.h
+ */
+int adcReadRegisterFile( ADS7924_T* pChip, u8* paRegister )
+{
+   ssize_t ret;
+
+   LOCK_I2C( pChip );
+   ret = _readAdcRegister( pChip->pI2cSlave, MODECNTRL, paRegister, ADS7924_REGISTER_FILE_SIZE );
+   UNLOCK_I2C( pChip );
+   return (ret == ADS7924_REGISTER_FILE_SIZE)? 0 : -EIO;
+}
+
+STATIC_ASSERT( ADS7924_REG_MODECNTRL == MODECNTRL );
+STATIC_ASSERT( ADS7924_REG_ULR( 3 ) == ULR3 );
+STATIC_ASSERT( ADS7924_REG_LLR( 3 ) == LLR3 );
+STATIC_ASSERT( ADS7924_REG_PWRCONFIG == PWRCONFIG );
+
+/*!----------------------------------------------------------------------------
+ * @brief Executes a run of entries with the same operation on ascending
+ *        registers by auto-increment transfers.
+ * @note Has to be invoked within LOCK_I2C and UNLOCK_I2C only.
+ * @retval ==0 OK
+ * @retval <0  Transfer failed.
+ */
+static int _adcExecuteBatchRun( ADS7924_T* pChip, ADS7924_BATCH_ENTRY_T* paEntry,
+                                unsigned int count )
+{
+   u8 aRegister[ADS7924_REGISTER_FILE_SIZE];
+   const u8 address = paEntry[0].reg;
+   ssize_t ret;
+   unsigned int i;
+
+   BUG_ON( address + count > ADS7924_REGISTER_FILE_SIZE );
+
+   switch( paEntry[0].operation )
+   {
+      case ADS7924_BATCH_READ:
+      {
+         ret = _readAdcRegister( pChip->pI2cSlave, address, aRegister, count );
+         break;
+      }
+      case ADS7924_BATCH_WRITE:
+      {
+         for( i = 0; i < count; i++ )
+            aRegister[i] = paEntry[i].value;
+         ret = _writeAdcRegister( pChip->pI2cSlave, address, aRegister, count );
+         break;
+      }
+      case ADS7924_BATCH_EDIT:
+      {
+         ret = _readAdcRegister( pChip->pI2cSlave, address, aRegister, count );
+         if( ret < 0 )
+            break;
+         for( i = 0; i < count; i++ )
+         {
+            aRegister[i] &= ~paEntry[i].clear;
+            aRegister[i] |= paEntry[i].set;
+         }
+         ret = _writeAdcRegister( pChip->pI2cSlave, address, aRegister, count );
+         break;
+      }
+      default:
+      {
+         BUG_ON( true );
+         ret = -EINVAL;
+         break;
+      }
+   }
+
+   ret = (ret < 0)? -EIO : 0;
+   for( i = 0; i < count; i++ )
+   {
+      paEntry[i].status = ret;
+      if( ret == 0 )
+         paEntry[i].value = aRegister[i];
+   }
+   if( (ret == 0) && (paEntry[0].operation != ADS7924_BATCH_READ) )
+   {
+      INVALIDATE_TIMING( pChip );
+      if( address == MODECNTRL )
+         STAMP_MODE( pChip );
+   }
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924core.h
+ */
+unsigned int adcExecuteBatch( ADS7924_T* pChip, ADS7924_BATCH_ENTRY_T* paEntry,
+                              unsigned int count )
+{
+   unsigned int first;
+   unsigned int runLength;
+   unsigned int i;
+
+   LOCK_I2C( pChip );
+   for( first = 0; first < count; first += runLength )
+   {
+      for( runLength = 1; first + runLength < count; runLength++ )
+      {
+         if( paEntry[first + runLength].operation != paEntry[first].operation )
+            break;
+         if( paEntry[first + runLength].reg != paEntry[first].reg + runLength )
+            break;
+      }
+      if( _adcExecuteBatchRun( pChip, &paEntry[first], runLength ) < 0 )
+         break;
+   }
+   UNLOCK_I2C( pChip );
+
+   if( first >= count )
+      return count;
+   for( i = first + runLength; i < count; i++ )
+      paEntry[i].status = -ECANCELED;
+   return first;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924core.h
+ */
+int adcReadAllAnalogValues( ADS7924_T* pChip, VALUE_T* paValue )
+{
+   return adcReadAnalogValues( pChip, 0, ADC_CHANNELS_PER_CHIP, paValue );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924core.h
+ */
+int adcWriteStreamMode( ADS7924_T* pChip, u8 streamMode, u8 set, u8 clear )
+{
+   int ret;
+
+   LOCK_I2C( pChip );
+   ret = _adcEditIntConfig( pChip->pI2cSlave, set, clear );
+   if( ret >= 0 )
+      WRITE_ONCE( pChip->streamMode, streamMode );
+   UNLOCK_I2C( pChip );
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924core.h
+ */
+int adcSwitchChannel( ADS7924_T* pChip, u8 mode, int channel,
+                      VALUE_T* pValue, u64* pSwitch )
+{
+   u8 analog[2];
+   int ret;
+
+   BUG_ON( channel >= (int)ARRAY_SIZE( g_ads7924InternList ) );
+
+   LOCK_I2C( pChip );
+   ret = _adcWriteModeByte( pChip->pI2cSlave, mode );
+   if( ret < 0 )
+   {
+      INVALIDATE_TIMING( pChip );
+      goto L_UNLOCK;
+   }
+   *pSwitch = ktime_get_ns();
+   pChip->timingShadow.modeTimestamp = *pSwitch;
+   /*
+    * Only the mode has been changed, so the shadow remains valid and
+    * the next adcReadTimingShadow() doesn't need a I2C-transfer.
+    */
+   pChip->timingShadow.mode = mode;
+
+   if( channel < 0 )
+      goto L_UNLOCK;
+
+   ret = _readAdcRegister( pChip->pI2cSlave,
+                           g_ads7924InternList[channel].dataAddrUpper,
+                           analog,
+                           sizeof( analog ));
+   if( ret == sizeof( analog ) )
+   {
+      *pValue = ((analog[0] << 8) | analog[1]) >> 4;
+      if( pChip->paChannel[channel] != NULL )
+         *pValue = adcApplyOffset( *pValue, pChip->paChannel[channel]->offset );
+      ret = 0;
+   }
+   else if( ret >= 0 )
+   {
+      ret = -EIO;
+   }
+
+L_UNLOCK:
+   UNLOCK_I2C( pChip );
+   return (ret < 0)? ret : 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924core.h
+ */
+int adcGroupWriteMode( ADS7924_T** papChip, unsigned int count, u8 mode,
+                       u64* paTimestamp )
+{
+   unsigned int i;
+   int ret = 0;
+
+   /*
+    * All members are locked before the first write, so no other access
+    * can slip between the MODECNTRL-writes and enlarge the skew.
+    */
+   for( i = 0; i < count; i++ )
+      mutex_lock_nested( &papChip[i]->oI2cMutex, i );
+
+   for( i = 0; i < count; i++ )
+   {
+      if( _adcWriteModeByte( papChip[i]->pI2cSlave, mode ) < 0 )
+      {
+         INVALIDATE_TIMING( papChip[i] );
+         paTimestamp[i] = 0;
+         ret = -EIO;
+         continue;
+      }
+      paTimestamp[i] = ktime_get_ns();
+      papChip[i]->timingShadow.modeTimestamp = paTimestamp[i];
+      papChip[i]->timingShadow.mode = mode;
+   }
+
+   i = count;
+   while( i-- > 0 )
+      UNLOCK_I2C( papChip[i] );
+
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924core.h
+ */
+u64 adcGetModeTimestamp( ADS7924_T* pChip )
+{
+   u64 ret;
+
+   LOCK_I2C( pChip );
+   ret = pChip->timingShadow.modeTimestamp;
+   UNLOCK_I2C( pChip );
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924core.h
+ */
+int adcReadTimingShadow( ADS7924_T* pChip, u8* pMode, u8* paConfig )
+{
+   int ret = 0;
+
+   LOCK_I2C( pChip );
+   if( !pChip->timingShadow.valid )
+   {
+      ret = _adcReadModeByte( pChip->pI2cSlave, &pChip->timingShadow.mode );
+      if( ret < 0 )
+         goto L_UNLOCK;
+      ret = _readAdcRegister( pChip->pI2cSlave, SLPCONFIG,
+                              pChip->timingShadow.aConfig,
+                              sizeof( pChip->timingShadow.aConfig ) );
+      if( ret < 0 )
+         goto L_UNLOCK;
+      pChip->timingShadow.valid = true;
+   }
+   *pMode = pChip->timingShadow.mode;
+   memcpy( paConfig, pChip->timingShadow.aConfig, sizeof( pChip->timingShadow.aConfig ) );
+
+L_UNLOCK:
+   UNLOCK_I2C( pChip );
+   return (ret < 0)? ret : 0;
+}
+
 /*!----------------------------------------------------------------------------
  */
 int adcAlarmEnable( ADC_CHANNEL_T* poCannel )
@@ -397,6 +397,242 @@ int adcEditPwrConfig( ADS7924_T* pChip, u8 set, u8 clear );
  */
 int readAnalogValue( ADC_CHANNEL_T* poCannel );
 
+/*!----------------------------------------------------------------------------
+ * @brief Reads the analog value like readAnalogValue and stores the given
+ *        timestamp as its conversion instant.
+ *
+ * A reconstructed timestamp becomes moved by whole periods to the
+ * conversion which the data register holds at the time of reading.
+ * @param poCannel Pointer to the channel object.
+ * @param timestamp Reconstructed conversion instant in ns,
+ *                  0: the time of reading becomes used.
+ * @param period Sample period of the channel in ns, 0: not periodic.
+ * @see adcAlignToRead
+ * @retval ==0 New result stored.
+ * @retval >0  Sample dropped by the pipeline, the previous result remains.
+ * @retval <0  Error
+ * @see ADS7924_SAMPLE_T
+ * @see PIPELINE
+ */
+int readAnalogSample( ADC_CHANNEL_T* poCannel, u64 timestamp, u64 period );
+
+/*!----------------------------------------------------------------------------
+ * @brief Performs a single conversion of the given channel on demand.
+ *
+ * If the chip isn't in a automatic mode it becomes switched in
+ * ADS7924_MODE_MANUAL_SINGLE for this channel, after waitTime the result
+ * becomes read and the previous mode restored. In the automatic modes
+ * the current content of the data register becomes read only.
+ * The whole sequence runs in a single lock of the I2C-device.
+ * @param poCannel Pointer to the channel object.
+ * @param waitTime Time of the conversion in ns.
+ * @param pValue Target of the analog value including offset correction.
+ * @param pStart Target of the start time of the conversion in ns,
+ *               0 if no conversion was started.
+ * @retval ==0 OK
+ * @retval <0  Error
+ */
+int adcConvertChannel( ADC_CHANNEL_T* poCannel, unsigned int waitTime,
+                       VALUE_T* pValue, u64* pStart );
+
+/*!----------------------------------------------------------------------------
+ * @brief Provides coherent analog values of all four channels.
+ *
+ * The chip becomes switched in ADS7924_MODE_MANUAL_SCAN, after four times
+ * waitTime the values becomes read by a single I2C-transfer and the
+ * previous mode restored. This applies to the automatic scan modes as
+ * well, a read of their data registers could straddle two scans.
+ * The whole sequence runs in a single lock of the I2C-device.
+ * @param pChip Pointer to the chip object.
+ * @param waitTime Time of one conversion in ns.
+ * @param paValue Target of the four analog values including offset correction.
+ * @param pStart Target of the start time of the scan in ns,
+ *               0 on error.
+ * @retval ==0 OK
+ * @retval <0  Error
+ */
+int adcConvertScan( ADS7924_T* pChip, unsigned int waitTime,
+                    VALUE_T* paValue, u64* pStart );
+
+/*!----------------------------------------------------------------------------
+ * @brief Reads the analog values of all four channels by a single
+ *        I2C-transfer and applies the offset corrections.
+ * @param pChip Pointer to the chip object.
+ * @param paValue Target of ADC_CHANNELS_PER_CHIP analog values.
+ * @retval ==0 OK
+ * @retval <0  Error
+ * @see STREAMING
+ */
+int adcReadAllAnalogValues( ADS7924_T* pChip, VALUE_T* paValue );
+
+/*!----------------------------------------------------------------------------
+ * @brief Reads the analog values of consecutive channels by a single
+ *        I2C-transfer and applies the offset corrections.
+ * @param pChip Pointer to the chip object.
+ * @param first Number of the first channel.
+ * @param count Number of channels, first + count <= ADC_CHANNELS_PER_CHIP
+ * @param paValue Target of count analog values.
+ * @retval ==0 OK
+ * @retval <0  Error
+ * @see adcCoalescedRead
+ */
+int adcReadAnalogValues( ADS7924_T* pChip, unsigned int first,
+                         unsigned int count, VALUE_T* paValue );
+
+/*!
+ * @brief Number of registers from MODECNTRL to PWRCONFIG.
+ * @see adcReadRegisterFile
+ */
+#define ADS7924_REGISTER_FILE_SIZE (PWRCONFIG - MODECNTRL + 1)
+
+/*!----------------------------------------------------------------------------
+ * @brief Reads all registers from MODECNTRL to PWRCONFIG by a single
+ *        I2C-transfer, e.g. for diagnostics.
+ * @note INTCNTRL becomes read as well, with the same side effects as
+ *       by adcReadIntCtrl.
+ * @param pChip Pointer to the chip object.
+ * @param paRegister Target of ADS7924_REGISTER_FILE_SIZE bytes,
+ *        indexed by the register address.
+ * @retval ==0 OK
+ * @retval <0  Error
+ */
+int adcReadRegisterFile( ADS7924_T* pChip, u8* paRegister );
+
+/*!----------------------------------------------------------------------------
+ * @brief Executes the register operations of a batch in their order while
+ *        holding the I2C-lock once.
+ *
+ * Consecutive entries of the same operation on ascending registers become
+ * a single auto-increment transfer. The execution stops at the first
+ * failed transfer, the entries not executed get the status -ECANCELED.
+ * @note The entries have to be validated by the caller.
+ * @param pChip Pointer to the chip object.
+ * @param paEntry Entries, ADS7924_BATCH_ENTRY_T::value and
+ *        ADS7924_BATCH_ENTRY_T::status becomes set.
+ * @param count Number of entries.
+ * @return Number of successful entries.
+ * @see BATCH
+ */
+unsigned int adcExecuteBatch( ADS7924_T* pChip, ADS7924_BATCH_ENTRY_T* paEntry,
+                              unsigned int count );
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns the values of MODECNTRL, SLPCONFIG, ACQCONFIG and PWRCONFIG.
+ *
+ * The values comes from the shadow in the chip object, the registers
+ * becomes read via I2C only when the shadow was invalidated by a
+ * preceding write access.
+ * @param pChip Pointer to the chip object.
+ * @param pMode Target of MODECNTRL.
+ * @param paConfig Target of SLPCONFIG, ACQCONFIG and PWRCONFIG.
+ * @retval ==0 OK
+ * @retval <0  Error
+ */
+int adcReadTimingShadow( ADS7924_T* pChip, u8* pMode, u8* paConfig );
+
+/*!----------------------------------------------------------------------------
+ * @brief Writes MODECNTRL and reads afterwards the data register of the
+ *        given channel by a single lock of the I2C-bus.
+ *
+ * Used by the channel sequencer: The new mode selects the next channel,
+ * the data register of the previous channel keeps its last conversion.
+ * @param pChip Pointer to the chip object.
+ * @param mode New value of MODECNTRL.
+ * @param channel Channel number 0 to 3 to read, <0 for none.
+ * @param pValue Target of the offset corrected analog value.
+ * @param pSwitch Target of the time in ns of the mode switch.
+ * @retval ==0 OK
+ * @retval <0  Error
+ * @see SEQUENCER
+ */
+int adcSwitchChannel( ADS7924_T* pChip, u8 mode, int channel,
+                      VALUE_T* pValue, u64* pSwitch );
+
+/*!----------------------------------------------------------------------------
+ * @brief Edits INTCONFIG and sets ADS7924_T::streamMode by a single lock
+ *        of the I2C-bus, so both change together.
+ * @param pChip Pointer to the chip object.
+ * @param streamMode New streaming mode, becomes set on success only.
+ * @param set Bits of INTCONFIG to set.
+ * @param clear Bits of INTCONFIG to clear.
+ * @retval ==0 OK
+ * @retval <0  Error
+ * @see STREAMING
+ */
+int adcWriteStreamMode( ADS7924_T* pChip, u8 streamMode, u8 set, u8 clear );
+
+/*!----------------------------------------------------------------------------
+ * @brief Writes MODECNTRL of several chips back to back.
+ *
+ * The I2C-mutexes of all chips become locked before the first write and
+ * released after the last one, so the skew between the chips is only
+ * determined by the I2C-transfers.
+ * @param papChip Array of pointers to the chip objects.
+ * @param count Number of elements in papChip.
+ * @param mode New value of MODECNTRL.
+ * @param paTimestamp Target array of the write times in ns, an element
+ *                    becomes 0 when the write of its chip has failed.
+ * @retval ==0 OK
+ * @retval <0  Error of at least one chip
+ * @see GROUP
+ */
+int adcGroupWriteMode( ADS7924_T** papChip, unsigned int count, u8 mode,
+                       u64* paTimestamp );
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns the time in ns of the last write of MODECNTRL,
+ *        0 if it wasn't written since loading of the driver.
+ */
+u64 adcGetModeTimestamp( ADS7924_T* pChip );
+
+/*!----------------------------------------------------------------------------
+ * @brief Subtracts the offset correction of the raw analog value and
+ *        limits the result to ADS7924_MIN_VALUE and ADS7924_MAX_VALUE.
+ * @see OFFSET_CALIBRATION
+ */
+static inline VALUE_T adcApplyOffset( VALUE_T value, s16 offset )
+{
+   int corrected = (int)value - offset;
+
+   if( corrected < (int)ADS7924_MIN_VALUE )
+      return ADS7924_MIN_VALUE;
+   if( corrected > (int)ADS7924_MAX_VALUE )
+      return ADS7924_MAX_VALUE;
+   return corrected;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Measures the offsets of all four channels by the internal
+ *        calibration mode (CALCNTL) and sets the offset correction of the
+ *        present channels.
+ *
+ * The whole sequence runs in a single lock of the I2C-device. Before the
+ * operation-mode and the power configuration becomes restored, a normal
+ * scan overwrites the data registers and the interrupts signaled until
+ * then becomes discarded by ADS7924_T::calibrationEnd.
+ * @param pChip Pointer to the chip object.
+ * @param paOffset Target of the ADC_CHANNELS_PER_CHIP measured offsets.
+ * @retval ==0 OK
+ * @retval <0  Error
+ * @see OFFSET_CALIBRATION
+ */
+int adcOffsetCalibration( ADS7924_T* pChip, s16* paOffset );
+
+/*!----------------------------------------------------------------------------
+ * @brief Writes the masked bits of SLPCONFIG, ACQCONFIG and PWRCONFIG in a
+ *        single transfer and starts the given mode.
+ *
+ * The chip becomes switched in the awake-mode before.
+ * @param pChip Pointer to the chip object.
+ * @param mode New mode.
+ * @param paConfig In: New values of SLPCONFIG, ACQCONFIG and PWRCONFIG,
+ *                 out: the actual written values.
+ * @param paMask Masks of the bits to change.
+ * @retval ==0 OK
+ * @retval <0  Error
+ */
+int adcWriteTimingConfig( ADS7924_T* pChip, u8 mode, u8* paConfig, const u8* paMask );
+
 /*!----------------------------------------------------------------------------
  */
 int adcWriteUpperLimitThreshold( ADC_CHANNEL_T* poCannel, u8 threshold );
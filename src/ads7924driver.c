@@ -26,6 +26,19 @@
 #include "ads7924fileIo.h"
 #include "ads7924core.h"
 #include "ads7924Irq.h"
+#include "ads7924calibration.h"
+#include "ads7924timing.h"
+#include "ads7924stream.h"
+#include "ads7924acquisition.h"
+#include "ads7924sequencer.h"
+#include "ads7924group.h"
+#include "ads7924merge.h"
+#include "ads7924capture.h"
+#include "ads7924virtual.h"
+#include "ads7924pipeline.h"
+#include "ads7924values.h"
+#include "ads7924bus.h"
+#include "ads7924async.h"
 #include "ads7924_dev_tree_names.h"
 #include <linux/slab.h>
 #include <linux/init.h>
@@ -429,14 +442,43 @@ static void allFree( void )
    BUS_T* pI2cBusTmp;
    BUS_T* pI2cBus = g_data.pI2cBusAncor;
 
+   /* open() must not find any object which becomes freed here. */
+   adcFreeMinorTable();
+
+   /* The group has to be stopped before its members becomes freed. */
+   adcFreeGroup( &g_data.group );
+   if( g_data.group.minor >= 0 )
+   {
+      device_destroy( g_data.pClass, g_data.deviceNumber | g_data.group.minor );
+      g_data.group.minor = -1;
+   }
+   adcFreeMerge( &g_data.merge );
+   if( g_data.merge.minor >= 0 )
+   {
+      device_destroy( g_data.pClass, g_data.deviceNumber | g_data.merge.minor );
+      g_data.merge.minor = -1;
+   }
+   if( g_data.values.minor >= 0 )
+   {
+      device_destroy( g_data.pClass, g_data.deviceNumber | g_data.values.minor );
+      g_data.values.minor = -1;
+   }
+   /* Unbinds the channels before they becomes freed. */
+   adcFreeValues( &g_data.values );
+
    while( pI2cBus != NULL )
    {
       pI2cBusTmp = pI2cBus->pNext;
+      /* The worker has to be idle before the chips becomes freed. */
+      adcFreeAsync( pI2cBus );
       for( chipNumber = 0; chipNumber < ARRAY_SIZE( pI2cBus->paChip ); chipNumber++ )
       {
          if( pI2cBus->paChip[chipNumber] == NULL )
             continue;
 
+         adcStopOffsetCalibration( pI2cBus->paChip[chipNumber] );
+         adcStopSequencer( pI2cBus->paChip[chipNumber] );
+
       #ifdef _ADS7924_NO_DEV_TREE
         // Not necessary will accomplished by unregister I2C-Device.
         // if( pI2cBus->paChip[chipNumber]->pI2cSlave->irq != 0 )
@@ -452,6 +494,9 @@ static void allFree( void )
             device_destroy( g_data.pClass,
                             g_data.deviceNumber | 
                             pI2cBus->paChip[chipNumber]->paChannel[channelNumber]->minor );
+            adcFreeCalibration( pI2cBus->paChip[chipNumber]->paChannel[channelNumber] );
+            adcFreeStream( pI2cBus->paChip[chipNumber]->paChannel[channelNumber] );
+            adcFreeCapture( pI2cBus->paChip[chipNumber]->paChannel[channelNumber] );
             ADS7924_KFREE( pI2cBus->paChip[chipNumber]->paChannel[channelNumber] );
             pI2cBus->paChip[chipNumber]->paChannel[channelNumber] = NULL;
          }
@@ -467,6 +512,12 @@ static void allFree( void )
             i2c_unregister_device( pI2cBus->paChip[chipNumber]->pI2cSlave );
          }
       #endif
+         for( channelNumber = 0; channelNumber < ARRAY_SIZE( pI2cBus->paChip[chipNumber]->aVirtual ); channelNumber++ )
+         {
+            device_destroy( g_data.pClass,
+                            g_data.deviceNumber |
+                            pI2cBus->paChip[chipNumber]->aVirtual[channelNumber].minor );
+         }
          DEBUG_MESSAGE( ": ADS7924_KFREE ADS7924_T Minor: %d\n",
                         pI2cBus->paChip[chipNumber]->minor );
          device_destroy( g_data.pClass,
@@ -561,9 +612,25 @@ static int _ADS7924_INIT buildChannelObjects( ADS7924_T* poChip )
       atomic_set( &poChip->paChannel[i]->openCounter, 0 );
       poChip->paChannel[i]->outputFormat = CONFIG_ADS7924_DEFAULT_OUTPUT_FORMAT;
       initWaitQueue( &poChip->paChannel[i]->waitQueue );
-      mutex_init( &poChip->paChannel[i]->result.oMutex );
+      initResult( poChip->paChannel[i] );
       mutex_init( &poChip->paChannel[i]->oMutex );
-      poChip->paChannel[i]->result.isValid = false;
+      adcInitCalibration( poChip->paChannel[i] );
+      adcInitStream( poChip->paChannel[i] );
+      adcInitCapture( poChip->paChannel[i] );
+      adcInitPipeline( poChip->paChannel[i] );
+   }
+
+   adcInitVirtual( poChip );
+   for( i = 0; i < ARRAY_SIZE( poChip->aVirtual ); i++ )
+   {
+      g_data.maxMinor++;
+      DEBUG_MESSAGE( ": Create object for %s%d%cv%d Minor: %d\n",
+                      g_data.pName,
+                      poChip->pParent->pI2cAdapter->nr,
+                      'A' + poChip->number,
+                      i,
+                      g_data.maxMinor );
+      poChip->aVirtual[i].minor = g_data.maxMinor;
    }
    return 0;
 }
@@ -616,6 +683,10 @@ static int __init buildChipObjects( BUS_T* poI2cBus )
       atomic_set( &poI2cBus->paChip[i]->openCounter, 0 );
       poI2cBus->paChip[i]->pParent = poI2cBus;
       mutex_init( &poI2cBus->paChip[i]->oI2cMutex );
+      adcInitOffsetCalibration( poI2cBus->paChip[i] );
+      adcInitScanEstimation( poI2cBus->paChip[i] );
+      adcInitAcquisition( poI2cBus->paChip[i] );
+      adcInitSequencer( poI2cBus->paChip[i] );
       strncpy( poI2cBus->paChip[i]->i2cBoardInfo.type, g_data.pName, I2C_NAME_SIZE );
 
       BUG_ON( i >= ARRAY_SIZE( g_ads7924i2cAddrMap ) );
@@ -663,6 +734,8 @@ static int __init buildChipObjects( BUS_T* poI2cBus )
       if( g_data.error < 0 )
          return g_data.error;
 
+      adcSetOffsetCalInterval( poI2cBus->paChip[i], CONFIG_ADS7924_OFFSET_CAL_INTERVAL );
+
       g_data.maxMinor++;
    }
    return 0;
@@ -712,6 +785,8 @@ static int __init buildObjects( void )
       pI2cBus->pNext = NULL;
       if( pI2cBusLast != NULL )
          pI2cBusLast->pNext = pI2cBus;
+      adcInitBusScheduler( pI2cBus );
+      adcInitAsync( pI2cBus );
 
       pI2cBus->pI2cAdapter = i2c_get_adapter( i );
       if( pI2cBus->pI2cAdapter == NULL )
@@ -800,8 +875,74 @@ static int _ADS7924_INIT buildDeviceFiles( void )
                return -EIO;
             }
          } /* End channel-loop */
+
+         for( adcChannelIndex = 0; adcChannelIndex < ARRAY_SIZE( pAds7924->aVirtual ); adcChannelIndex++ )
+         {
+            if( device_create( g_data.pClass,
+                               NULL,
+                               g_data.deviceNumber | pAds7924->aVirtual[adcChannelIndex].minor,
+                               NULL,
+                               "%s%d%cv%d",
+                               g_data.pName,
+                               pI2cBus->pI2cAdapter->nr,
+                               'A' + chipIndex,
+                               adcChannelIndex
+                             )
+                == NULL )
+            {
+               ERROR_MESSAGE( ": Can not create device-file %s%d%cv%d\n",
+                              g_data.pName,
+                              pI2cBus->pI2cAdapter->nr,
+                              'A' + chipIndex,
+                              adcChannelIndex );
+               allFree();
+               return -EIO;
+            }
+         } /* End virtual channel-loop */
       } /* End chip-loop */
    } /* End bus-loop */
+
+   if( device_create( g_data.pClass,
+                      NULL,
+                      g_data.deviceNumber | g_data.group.minor,
+                      NULL,
+                      "%sgroup",
+                      g_data.pName
+                    )
+       == NULL )
+   {
+      ERROR_MESSAGE( ": Can not create device-file %sgroup\n", g_data.pName );
+      allFree();
+      return -EIO;
+   }
+
+   if( device_create( g_data.pClass,
+                      NULL,
+                      g_data.deviceNumber | g_data.merge.minor,
+                      NULL,
+                      "%sall",
+                      g_data.pName
+                    )
+       == NULL )
+   {
+      ERROR_MESSAGE( ": Can not create device-file %sall\n", g_data.pName );
+      allFree();
+      return -EIO;
+   }
+
+   if( device_create( g_data.pClass,
+                      NULL,
+                      g_data.deviceNumber | g_data.values.minor,
+                      NULL,
+                      "%svalues",
+                      g_data.pName
+                    )
+       == NULL )
+   {
+      ERROR_MESSAGE( ": Can not create device-file %svalues\n", g_data.pName );
+      allFree();
+      return -EIO;
+   }
    return 0;
 }
 
@@ -860,6 +1001,8 @@ static inline ADS7924_T* allocateAds7924Object( struct i2c_client* pI2cChannel )
       }
       pI2cBus->pI2cAdapter = pI2cChannel->adapter;
       pI2cBus->pNext = NULL;
+      adcInitBusScheduler( pI2cBus );
+      adcInitAsync( pI2cBus );
       if( g_data.pI2cBusAncor == NULL )
          g_data.pI2cBusAncor = pI2cBus;
       if( pI2cBusLast != NULL )
@@ -882,6 +1025,10 @@ static inline ADS7924_T* allocateAds7924Object( struct i2c_client* pI2cChannel )
    atomic_set( &pI2cBus->paChip[number]->openCounter, 0 );
    pI2cBus->paChip[number]->pParent = pI2cBus;
    mutex_init( &pI2cBus->paChip[number]->oI2cMutex );
+   adcInitOffsetCalibration( pI2cBus->paChip[number] );
+   adcInitScanEstimation( pI2cBus->paChip[number] );
+   adcInitAcquisition( pI2cBus->paChip[number] );
+   adcInitSequencer( pI2cBus->paChip[number] );
    pI2cBus->paChip[number]->pI2cSlave = pI2cChannel;
    i2c_set_clientdata( pI2cChannel, pI2cBus->paChip[number] );
 
@@ -889,6 +1036,8 @@ static inline ADS7924_T* allocateAds7924Object( struct i2c_client* pI2cChannel )
    if( g_data.error != 0 )
       return NULL;
 
+   adcSetOffsetCalInterval( pI2cBus->paChip[number], CONFIG_ADS7924_OFFSET_CAL_INTERVAL );
+
    g_data.maxMinor++;
 
    return pI2cBus->paChip[number];
@@ -947,6 +1096,9 @@ static int onAds7924remove( struct i2c_client* pI2cClient )
 static int __init driverInit( void )
 {
    INFO_MESSAGE( "Initializing %s Version " __VERSION "\n", g_data.pName );
+   adcInitGroup( &g_data.group );
+   adcInitMerge( &g_data.merge );
+   adcInitValues( &g_data.values );
 
 #ifdef _ADS7924_NO_DEV_TREE
    g_data.error = buildObjects();
@@ -977,6 +1129,29 @@ static int __init driverInit( void )
       return -EIO;
    }
 
+   /*
+    * The group device, the aggregate device and the device of the shared
+    * page takes the minor numbers behind the last channel.
+    */
+   g_data.group.minor  = g_data.maxMinor++;
+   g_data.merge.minor  = g_data.maxMinor++;
+   g_data.values.minor = g_data.maxMinor++;
+
+   g_data.error = adcAllocValues( &g_data.values );
+   if( g_data.error != 0 )
+   {
+      i2c_del_driver( &mg_ads7924Driver );
+      return g_data.error;
+   }
+
+   g_data.error = adcBuildMinorTable();
+   if( g_data.error != 0 )
+   {
+      adcFreeValues( &g_data.values );
+      i2c_del_driver( &mg_ads7924Driver );
+      return g_data.error;
+   }
+
    g_data.pObject = cdev_alloc();
    if( IS_ERR( g_data.pObject ) )
    {
@@ -36,6 +36,9 @@
 #include <linux/wait.h>
 #include <linux/interrupt.h>
 #include <linux/i2c.h>
+#include <linux/workqueue.h>
+#include <linux/hrtimer.h>
+#include <linux/seqlock.h>
 #include <asm/uaccess.h>
 #include "ads7924ioctl.h"
 #ifdef CONFIG_PROC_FS
@@ -104,12 +107,27 @@ typedef u8  LIMIT_T; /*!<@brief Type for ADS7924 threshold-registers */
 
 /*!
  * @brief Object keeps the last analog value read via the I2C bus.
+ *
+ * The members becomes published by a sequence lock: The writers
+ * (interrupt thread, sequencer, on-demand reads) are serialized by its
+ * spinlock, the readers never block and retry only if a writer was
+ * active meanwhile.
+ * @see publishResult
+ * @see getSample
  */
 typedef struct
 {
-   struct mutex     oMutex;  /*!<@brief Race condition guard. */
-   volatile VALUE_T value;   /*!<@brief Analog value. */
+   seqlock_t        oLock;   /*!<@brief Guards the following members. */
+   VALUE_T          value;   /*!<@brief Analog value. */
    volatile bool    isValid; /*!<@brief Becomes true if analog-value valid. */
+   u64              timestamp; /*!<@brief Conversion instant in ns. @see ADS7924_SAMPLE_T */
+   u8               flags;   /*!<@brief ADS7924_SAMPLE_RECONSTRUCTED or 0 */
+   u32              sequence; /*!<@brief Number of published values. */
+   /*!
+    * @brief Slot of the shared page /dev/adcvalues or NULL.
+    * @see VALUES
+    */
+   ADS7924_VALUE_SLOT_T* pSlot;
 } ANALOG_T;
 
 STATIC_ASSERT( sizeof( VALUE_T ) == 2 );
@@ -121,7 +139,9 @@ typedef enum
 {
    OUT_BIN = 0, //!<@brief Analog value in binary-format.
    OUT_DEC = 1, //!<@brief Analog value in ASCII-decimal-format
-   OUT_HEX = 2  //!<@brief Analog value in ASCII-hexadecimal-format
+   OUT_HEX = 2, //!<@brief Analog value in ASCII-hexadecimal-format
+   OUT_SCALED = 3, //!<@brief Calibrated value in ASCII-decimal-format @see CALIBRATION
+   OUT_SAMPLE = 4  //!<@brief Analog value and timestamp in binary-format @see ADS7924_SAMPLE_T
 } OUTPUT_FORMAT_T;
 
 /*!----------------------------------------------------------------------------
@@ -172,8 +192,51 @@ static inline void initWaitQueue( WAIT_QUEUE_T* poQueue )
    init_waitqueue_head( &poQueue->queue );
 }
 
+/*!----------------------------------------------------------------------------
+ * @brief States of the capture mode of a channel.
+ * @see CAPTURE
+ */
+typedef enum
+{
+   CAPTURE_IDLE,  //!<@brief Capture mode off or single window already read.
+   CAPTURE_ARMED, //!<@brief Filling the history, waiting for the trigger.
+   CAPTURE_POST,  //!<@brief Collecting the post-trigger samples.
+   CAPTURE_READY  //!<@brief Window complete, waiting for read().
+} CAPTURE_STATE_T;
+
+/*!----------------------------------------------------------------------------
+ * @brief Run-time state of a single pipeline stage.
+ * @see PIPELINE
+ */
+typedef struct
+{
+   s32          aHistory[ADS7924_FILTER_MAX_LENGTH]; //!<@brief Ring of the filter inputs.
+   unsigned int index;   //!<@brief Free running write index of aHistory.
+   s32          sum;     //!<@brief Sum of the valid entries of aHistory.
+   s32          last;    //!<@brief Last passed value of the dead band.
+   bool         hasLast; //!<@brief Member last is valid.
+   unsigned int counter; //!<@brief Sample counter of the decimation.
+} STAGE_STATE_T;
+
 struct _ADS7924_T; // Resolves the chicken egg problem...
 
+/*!----------------------------------------------------------------------------
+ * @brief Object of a virtual channel derived from two channels of a chip.
+ * @see VIRTUAL
+ */
+typedef struct
+{
+   struct _ADS7924_T*       pParent;
+   int                      minor;
+   int                      number;
+   atomic_t                 openCounter;
+   struct mutex             oMutex;     //!<@brief Guards definition and result.
+   ADS7924_VIRTUAL_T        definition;
+   ADS7924_VIRTUAL_SAMPLE_T result;
+   bool                     isValid;    //!<@brief Result is from a unread scan.
+   wait_queue_head_t        oWaitQueue;
+} VIRTUAL_CHANNEL_T;
+
 /*!----------------------------------------------------------------------------
  * @brief Object for one of the four analog-channels of ADS7924
  */
@@ -187,16 +250,163 @@ typedef struct
    OUTPUT_FORMAT_T    outputFormat;
    WAIT_QUEUE_T       waitQueue;
    struct mutex       oMutex;
+   /*!
+    * @brief Current calibration, guarded by oMutex.
+    * @see CALIBRATION
+    */
+   ADS7924_CALIBRATION_T oCalibration;
+   /*!
+    * @brief Lookup table of ADS7924_MAX_VALUE+1 precomputed scaled values,
+    *        becomes built on demand and is guarded by oMutex.
+    * @see adcGetScaleTable
+    */
+   s32*               pScaleTable;
+   /*!
+    * @brief FIFO of the streaming mode, the buffer becomes allocated by
+    *        switching the streaming on.
+    * @see STREAMING
+    */
+   struct
+   {
+      struct mutex      oMutex;
+      ADS7924_SAMPLE_T* paBuffer; //!<@brief CONFIG_ADS7924_FIFO_SIZE samples
+      unsigned int      head;     //!<@brief Free running write index, released after the write.
+      unsigned int      tail;     //!<@brief Free running read index.
+      unsigned int      overruns; //!<@brief Number of lost samples.
+      ADS7924_WAKEUP_T  wakeup;   //!<@brief Wakeup condition of the readers.
+      u64               deadline; //!<@brief Latest wakeup for the oldest sample in ns.
+      struct hrtimer    oTimer;   //!<@brief Wakes the readers at deadline.
+      unsigned int      wakeups;  //!<@brief Number of wakeups of the readers.
+   } fifo;
+   /*!
+    * @brief Read policy, ADS7924_FRESH_READ_OFF by default.
+    * @see FRESH_READ
+    * @see ADS7924_IOCTL_SET_FRESH_READ
+    */
+   u8                 freshRead;
+   /*!
+    * @brief Maximum age in us of a cached result, 0 if switched off.
+    * @see ADS7924_IOCTL_SET_MAX_AGE
+    */
+   u32                maxAge;
+   /*!
+    * @brief Counters of the on-demand conversions for coalescing of
+    *        concurrent requests, guarded by pParent->oConvMutex.
+    * @see adcFreshConversion
+    */
+   unsigned int       convStarted;
+   unsigned int       convCompleted;
+   /*!
+    * @brief Offset correction which becomes subtracted from each raw value,
+    *        guarded by pParent->oI2cMutex.
+    * @see OFFSET_CALIBRATION
+    */
+   s16                offset;
+   /*!
+    * @brief Queue of the aggregate stream, guarded by g_data.merge.oMutex.
+    * @see MERGE
+    */
+   struct
+   {
+      ADS7924_RECORD_T* paBuffer; //!<@brief CONFIG_ADS7924_FIFO_SIZE records
+      unsigned int      head;     //!<@brief Free running write index, released after the write.
+      unsigned int      tail;     //!<@brief Free running read index.
+      u32               sequence; //!<@brief Sequence number of the next record.
+      u64               last;     //!<@brief Timestamp of the newest record, lower bound of the next one.
+      volatile bool     subscribed;
+   } merge;
+   /*!
+    * @brief Capture mode, guarded by capture.oMutex.
+    * @see CAPTURE
+    */
+   struct
+   {
+      struct mutex             oMutex;
+      /*!
+       * @brief Held by the reader whilst copying paWindow to the user and by
+       *        adcSetCapture(), but never by the producer.
+       */
+      struct mutex             oReadMutex;
+      ADS7924_CAPTURE_T        config;
+      volatile CAPTURE_STATE_T state;
+      bool                     inZone;    //!<@brief Previous sample was out of lower..upper
+      ADS7924_SAMPLE_T*        paHistory; //!<@brief Ring of config.preTrigger samples.
+      unsigned int             history;   //!<@brief Free running write index of paHistory.
+      ADS7924_SAMPLE_T*        paWindow;  //!<@brief preTrigger + postTrigger + 1 samples.
+      ADS7924_CAPTURE_RECORD_T record;    //!<@brief Header of the window in paWindow.
+      unsigned int             remaining; //!<@brief Missing post-trigger samples.
+      u32                      sequence;  //!<@brief Number of the next window.
+      u32                      missed;    //!<@brief Triggers lost since the previous window.
+   } capture;
+   /*!
+    * @brief Processing pipeline, guarded by pipeline.oMutex.
+    * @see PIPELINE
+    */
+   struct
+   {
+      struct mutex             oMutex;
+      ADS7924_PIPELINE_T       config;
+      STAGE_STATE_T            aState[ADS7924_PIPELINE_MAX_STAGES];
+      ADS7924_PIPELINE_STATS_T stats;
+   } pipeline;
 } ADC_CHANNEL_T;
 
 /*!----------------------------------------------------------------------------
- * @brief Stores the analog value thread-save.
+ * @brief Initializes the result object of a channel as invalid.
  */
-static inline void setResult( ADC_CHANNEL_T* pChannel, VALUE_T value )
+static inline void initResult( ADC_CHANNEL_T* pChannel )
 {
-   mutex_lock( &pChannel->result.oMutex );
-   pChannel->result.value = value;
-   mutex_unlock( &pChannel->result.oMutex );
+   seqlock_init( &pChannel->result.oLock );
+   pChannel->result.isValid  = false;
+   pChannel->result.sequence = 0;
+   pChannel->result.pSlot    = NULL;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Mirrors the result into the slot of the shared page, if any.
+ * @note The caller has to hold the write side of the sequence lock,
+ *       so the writers of the slot are serialized as well.
+ * @see ads7924ReadValue
+ */
+static inline void updateSlot( ANALOG_T* pResult )
+{
+   ADS7924_VALUE_SLOT_T* pSlot = pResult->pSlot;
+
+   if( pSlot == NULL )
+      return;
+   WRITE_ONCE( pSlot->sequence, pSlot->sequence + 1 );
+   smp_wmb();
+   pSlot->value     = pResult->value;
+   pSlot->flags     = pResult->flags;
+   pSlot->timestamp = pResult->timestamp;
+   smp_wmb();
+   WRITE_ONCE( pSlot->sequence, pSlot->sequence + 1 );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Publishes value, timestamp and flags of the sample as the new
+ *        valid result of the channel.
+ */
+static inline void publishResult( ADC_CHANNEL_T* pChannel, const ADS7924_SAMPLE_T* pSample )
+{
+   write_seqlock( &pChannel->result.oLock );
+   pChannel->result.value     = pSample->value;
+   pChannel->result.timestamp = pSample->timestamp;
+   pChannel->result.flags     = pSample->flags;
+   pChannel->result.isValid   = true;
+   pChannel->result.sequence++;
+   updateSlot( &pChannel->result );
+   write_sequnlock( &pChannel->result.oLock );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Marks the result of the channel as invalid.
+ */
+static inline void invalidateResult( ADC_CHANNEL_T* pChannel )
+{
+   write_seqlock( &pChannel->result.oLock );
+   pChannel->result.isValid = false;
+   write_sequnlock( &pChannel->result.oLock );
 }
 
 /*!----------------------------------------------------------------------------
@@ -205,13 +415,37 @@ static inline void setResult( ADC_CHANNEL_T* pChannel, VALUE_T value )
 static inline VALUE_T getResult( ADC_CHANNEL_T* pChannel )
 {
    VALUE_T ret;
-
-   mutex_lock( &pChannel->result.oMutex );
-   ret = pChannel->result.value;
-   mutex_unlock( &pChannel->result.oMutex );
+   unsigned int seq;
+
+   do
+   {
+      seq = read_seqbegin( &pChannel->result.oLock );
+      ret = pChannel->result.value;
+   }
+   while( read_seqretry( &pChannel->result.oLock, seq ) );
    return ret;
 }
 
+/*!----------------------------------------------------------------------------
+ * @brief Get the stored analog value including its timestamp thread-save
+ *        back.
+ */
+static inline void getSample( ADC_CHANNEL_T* pChannel, ADS7924_SAMPLE_T* pSample )
+{
+   unsigned int seq;
+
+   do
+   {
+      seq = read_seqbegin( &pChannel->result.oLock );
+      pSample->timestamp = pChannel->result.timestamp;
+      pSample->value     = pChannel->result.value;
+      pSample->flags     = pChannel->result.flags;
+   }
+   while( read_seqretry( &pChannel->result.oLock, seq ) );
+   pSample->channel = pChannel->cannelNumber;
+   pSample->dummy   = 0;
+}
+
 /*!---------------------------------------------------------------------------
  * @brief Put the process sleeping to which belongs the given channel-object,
  *        until he becomes awake by wakeUpChannel.
@@ -245,6 +479,7 @@ typedef struct
 {
    ADC_CONST int gpioPin; //!<@brief The GPIO-input line of the ADS7924 alarms.
    int           irq;     //!<@brief From the gpioPin generated interrupt-number.
+   u64           timestamp; //!<@brief Time of the last hardware-interrupt in ns.
 } GPIO_INTERRUPT_T;
 #endif /* ifdef _ADS7924_NO_DEV_TREE */
 
@@ -265,7 +500,131 @@ typedef struct _ADS7924_T
    struct i2c_board_info i2cBoardInfo;
    struct i2c_client*    pI2cSlave;
    struct mutex          oI2cMutex;
+   /*!
+    * @brief Interrupt thread of this chip, its I2C-transfers have the
+    *        highest priority on the bus.
+    * @see BUS_CLASS_HARVEST
+    */
+   struct task_struct*   pHarvester;
    ADC_CHANNEL_T*        paChannel[ADC_CHANNELS_PER_CHIP];
+   /*!
+    * @brief Serializes the on-demand conversions.
+    * @see adcFreshConversion
+    */
+   struct mutex          oConvMutex;
+   /*!
+    * @brief Single-flight burst reads of the data registers on demand.
+    * @see adcCoalescedRead
+    */
+   struct
+   {
+      spinlock_t         oLock;     //!<@brief Guards request and started.
+      struct mutex       oMutex;    //!<@brief Held by the reader doing the burst.
+      u8                 request;   //!<@brief Channels of the waiting readers.
+      u8                 failed;    //!<@brief Channels failed in their last burst.
+      u8                 dropped;   //!<@brief Channels dropped by the pipeline in their last burst.
+      unsigned int       started;   //!<@brief Number of started bursts.
+      unsigned int       completed; //!<@brief Number of completed bursts.
+      unsigned int       served;    //!<@brief Requests served by a other reader's burst.
+   } burst;
+   /*!
+    * @brief ADS7924_STREAM_OFF, ADS7924_STREAM_CONVERSION or
+    *        ADS7924_STREAM_SCAN, set together with INTCONFIG.
+    * @see adcWriteStreamMode
+    * @see STREAMING
+    */
+   volatile u8           streamMode;
+   /*!
+    * @brief True whilst the chip is member of the running group,
+    *        set under sequencer.oMutex.
+    * @see GROUP
+    */
+   volatile bool         inGroup;
+   /*!
+    * @brief Virtual channels of this chip.
+    * @see VIRTUAL
+    */
+   VIRTUAL_CHANNEL_T     aVirtual[CONFIG_ADS7924_VIRTUAL_CHANNELS];
+   /*!
+    * @brief Time of the last hardware-interrupt in ns, becomes set in the
+    *        top half of the interrupt.
+    */
+   u64                   irqTimestamp;
+   /*!
+    * @brief Time in ns at which the last offset calibration has handed
+    *        back the chip; interrupts signaled before are discarded.
+    * @see adcOffsetCalibration
+    */
+   u64                   calibrationEnd;
+   /*!
+    * @brief Shadow of the registers which determines the timing,
+    *        guarded by oI2cMutex.
+    *
+    * It becomes invalid by each write access to one of these registers
+    * and will read again by the next use.
+    * @see adcReadTimingShadow
+    */
+   struct
+   {
+      bool valid;
+      u8   mode;
+      u8   aConfig[3]; //!<@brief SLPCONFIG, ACQCONFIG, PWRCONFIG
+      /*!
+       * @brief Time of the last write of MODECNTRL in ns, which starts
+       *        the first scan of a automatic mode.
+       */
+      u64  modeTimestamp;
+   } timingShadow;
+   /*!
+    * @brief Phase-locked loop which estimates the actual scan period
+    *        from the interrupt arrivals, all times in ns.
+    * @see adcUpdateScanEstimation
+    */
+   struct
+   {
+      struct mutex oMutex;
+      bool         correction; //!<@brief Correct the timestamps.
+      u64          nominal;    //!<@brief Period of the timing model.
+      u64          period;     //!<@brief Estimated period.
+      u64          phase;      //!<@brief Filtered time of the last scan end.
+      u64          jitter;     //!<@brief Mean absolute phase error.
+      unsigned int count;
+   } scanEstimation;
+   /*!
+    * @brief Objects of the automatic offset calibration.
+    * @see OFFSET_CALIBRATION
+    */
+   struct
+   {
+      struct delayed_work    oWork;
+      struct mutex           oMutex;   //!<@brief Guards interval and history.
+      unsigned int           interval; //!<@brief Milliseconds, 0: disabled
+      unsigned int           index;    //!<@brief Index of the newest entry.
+      unsigned int           count;
+      ADS7924_OFFSET_ENTRY_T aHistory[ADS7924_OFFSET_HISTORY_SIZE];
+   } offsetCal;
+   /*!
+    * @brief Objects of the channel sequencer.
+    * @see SEQUENCER
+    */
+   struct
+   {
+      /*!
+       * @brief Guards starting and stopping and the ownership of MODECNTRL.
+       * @see adcLockMode()
+       */
+      struct mutex        oMutex;
+      struct task_struct* pThread;
+      volatile u8         mode;     //!<@brief ADS7924_SEQ_OFF, ADS7924_SEQ_ROUND_ROBIN, ...
+      u8                  prevMode; //!<@brief MODECNTRL before starting.
+      unsigned int        switches; //!<@brief Number of channel switches.
+      ADS7924_SCHEDULE_T  schedule; //!<@brief Schedule table, count == 0: none
+      u8                  aOrder[ADS7924_SCHEDULE_SIZE]; //!<@brief Entry indexes by priority.
+      struct hrtimer      oTimer;   //!<@brief Releases the ticks of the schedule.
+      u64                 start;    //!<@brief Release time of tick 0 in ns.
+      struct mutex        oStatMutex; //!<@brief Guards stats.
+      ADS7924_SCHEDULE_STATS_T stats;
+   } sequencer;
 } ADS7924_T;
 
 
@@ -276,6 +635,59 @@ typedef struct _ADS7924_T
  * Forward chained list of hardware-I2C-buses in which
  * exist at least one analog to digital converter ADS7924.
  */
+/*!----------------------------------------------------------------------------
+ * @brief Priority classes of the I2C-transfers of a bus in descending
+ *        order.
+ * @see adcBusAcquire
+ */
+typedef enum
+{
+   BUS_CLASS_HARVEST = 0, //!<@brief Interrupt thread harvesting alarms and scans.
+   BUS_CLASS_USER,        //!<@brief Reads of the data registers on demand.
+   BUS_CLASS_CONFIG,      //!<@brief All other register accesses.
+   BUS_CLASS_DIAG,        //!<@brief Diagnostics like /proc.
+   BUS_CLASSES
+} BUS_CLASS_T;
+
+/*!----------------------------------------------------------------------------
+ * @brief Queueing statistics of a priority class.
+ */
+typedef struct
+{
+   unsigned int transfers;
+   u64          totalWait; //!<@brief Sum of the queueing latencies in ns.
+   u64          maxWait;   //!<@brief Longest queueing latency in ns.
+} BUS_CLASS_STATS_T;
+
+/*!----------------------------------------------------------------------------
+ * @brief Arbiter of the I2C-transfers of all chips on a bus.
+ * @see ads7924bus.h
+ */
+typedef struct
+{
+   spinlock_t         oLock;    //!<@brief Guards all other members.
+   bool               busy;     //!<@brief A transfer is running.
+   unsigned int       passed;   //!<@brief Consecutive grants whilst a lower class was waiting.
+   unsigned int       aWaiting[BUS_CLASSES];
+   wait_queue_head_t  oWaitQueue;
+   BUS_CLASS_STATS_T  aStats[BUS_CLASSES];
+} BUS_SCHEDULER_T;
+
+/*!----------------------------------------------------------------------------
+ * @brief Worker executing the asynchronous register operations of all
+ *        chips of a bus in the order of submission.
+ * @see ASYNC
+ * @see ads7924async.h
+ */
+typedef struct
+{
+   spinlock_t         oLock;     //!<@brief Guards oQueue and the counters.
+   struct list_head   oQueue;    //!<@brief Submitted operations ASYNC_OPERATION_T
+   struct work_struct oWork;     //!<@brief Runs on system_wq, never concurrently with itself.
+   unsigned int       submitted;
+   unsigned int       completed;
+} ASYNC_ENGINE_T;
+
 typedef struct _BUS_T
 {
    struct _BUS_T*      pNext;
@@ -284,6 +696,8 @@ typedef struct _BUS_T
 #endif
    struct i2c_adapter* pI2cAdapter;
    ADS7924_T*          paChip[ADC_CHIPS_PER_BUS];
+   BUS_SCHEDULER_T     scheduler;
+   ASYNC_ENGINE_T      async;
 } BUS_T;
 
 /*!----------------------------------------------------------------------------
@@ -293,6 +707,68 @@ typedef struct _BUS_T
 #define FOR_EACH_I2C_BUS( poBus ) \
   for( poBus = g_data.pI2cBusAncor; poBus != NULL; poBus = poBus->pNext )
 
+/*!----------------------------------------------------------------------------
+ * @brief Object represents the group device for the synchronized
+ *        acquisition of several chips.
+ * @see GROUP
+ */
+typedef struct
+{
+   int                   minor;
+   atomic_t              openCounter;
+   struct mutex          oMutex;   //!<@brief Guards configuration, starting and stopping.
+   ADS7924_GROUP_T       config;
+   ADS7924_T*            apMember[ADS7924_GROUP_MAX_MEMBERS];
+   u8                    aPrevMode[ADS7924_GROUP_MAX_MEMBERS];
+   struct task_struct*   pThread;
+   volatile bool         running;
+   u32                   sequence;
+   wait_queue_head_t     oWaitQueue;
+   /*!
+    * @brief Frame FIFO and statistics.
+    */
+   struct
+   {
+      struct mutex          oMutex;
+      ADS7924_FRAME_T*      paBuffer;
+      unsigned int          head; //!<@brief Free running write index.
+      unsigned int          tail; //!<@brief Free running read index.
+      ADS7924_GROUP_STATS_T stats;
+   } fifo;
+} GROUP_T;
+
+/*!----------------------------------------------------------------------------
+ * @brief Object represents the aggregate device /dev/adcall.
+ * @see MERGE
+ */
+typedef struct
+{
+   int                   minor;
+   atomic_t              openCounter;
+   /*!
+    * @brief Guards the subscription and the merge queues of all channels.
+    */
+   struct mutex          oMutex;
+   DECLARE_BITMAP( mask, ADS7924_MERGE_MAX_MINORS ); //!<@brief Subscribed minor numbers.
+   unsigned int          count;  //!<@brief Number of subscribed channels.
+   ADC_CHANNEL_T*        apChannel[ADS7924_MERGE_MAX_MINORS];
+   unsigned int          level;  //!<@brief Number of queued records of all channels, written by WRITE_ONCE().
+   unsigned int          lost;   //!<@brief Number of dropped records.
+   wait_queue_head_t     oWaitQueue;
+   struct hrtimer        oTimer; //!<@brief Wakes the readers when the hold back expires.
+} MERGE_T;
+
+/*!----------------------------------------------------------------------------
+ * @brief Object represents the device /dev/adcvalues of the shared page.
+ * @see VALUES
+ */
+typedef struct
+{
+   int                   minor;
+   atomic_t              openCounter;
+   ADS7924_VALUES_T*     pPage;  //!<@brief Page mapped into the user-space.
+} VALUES_T;
+
 /*!----------------------------------------------------------------------------
  * @brief Collection of the driver global variables.
  */
@@ -307,6 +783,15 @@ typedef struct
 #endif
    int                      maxMinor;
    BUS_T*                   pI2cBusAncor; //!<@brief Anchor of chained list.
+   GROUP_T                  group;
+   MERGE_T                  merge;
+   VALUES_T                 values;
+   /*!
+    * @brief Process dumping /proc, its I2C-transfers have the lowest
+    *        priority.
+    * @see BUS_CLASS_DIAG
+    */
+   struct task_struct*      pDiagnostic;
    volatile int             error;
 #ifdef CONFIG_PROC_FS
    struct proc_dir_entry*   poProcFile;
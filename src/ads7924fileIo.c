@@ -24,72 +24,117 @@
 #include "ads7924driver.h"
 #include "ads7924core.h"
 #include "ads7924fileIo.h"
+#include "ads7924calibration.h"
+#include "ads7924timing.h"
+#include "ads7924stream.h"
+#include "ads7924acquisition.h"
+#include "ads7924sequencer.h"
+#include "ads7924group.h"
+#include "ads7924merge.h"
+#include "ads7924capture.h"
+#include "ads7924virtual.h"
+#include "ads7924pipeline.h"
+#include "ads7924values.h"
 #include "ads7924_dev_tree_names.h"
 #include "ads7924ioctl.h"
 #include <linux/slab.h>
 #include <linux/poll.h>
+#include <linux/rcupdate.h>
 
 //#define _DEBUG_POLL
 
 #define IOCTL_ITEM( n, f ) { #n,   n, f    } //!<@brief Function-table item
 #define IOCTL_LIST_END     { NULL, 0, NULL } //!<@brief Table terminator
+#define STREAM_READ_BATCH  16 //!<@brief Samples per FIFO access in the streaming mode
 
 /* Device file operations begin **********************************************/
 /*!----------------------------------------------------------------------------
- * @ingroup IOCTL_CHIP
- * @ingroup IOCTL_CHANNEL
- * @brief Callback functions specialized either for entire chip access or 
- *        single channel access.
- * @see getObjectByMinor
+ * @brief Object and file operations behind a minor number.
+ *
+ * onOpen installs the file operations of the object type into the file
+ * instance and the object into pInstance->private_data, so all further
+ * calls reach the type specific callbacks directly. Only the chip devices
+ * replace private_data by their ASYNC_CONTEXT_T.
+ * @see MINOR_TABLE_T
  * @see onOpen
  */
 typedef struct
 {
    /*!
-    * @brief Placeholder for pointer to object ADS7924_T* or ADC_CHANNEL_T*
-    * @see getChipFromInstance
-    * @see getChannelFromInstance
+    * @brief Operations of the object type, NULL if the minor is unused.
+    */
+   const struct file_operations* pFops;
+
+   /*!
+    * @brief Pointer to object ADS7924_T*, ADC_CHANNEL_T*, GROUP_T*,
+    *        MERGE_T*, VIRTUAL_CHANNEL_T* or VALUES_T*
     */
-   void*        pPrivate;
-
-   int          (*pOnOpen)( struct inode* pInode, struct file* pInstance );
-   int          (*pOnClose)( struct inode *pInode, struct file* pInstance );
-   ssize_t      (*pOnRead)( struct file* pInstance, char __user* pBuffer,
-                            size_t len, loff_t* pOffset );
-   ssize_t      (*pOnWrite)( struct file *pInstance,  const char __user* pBuffer,
-                            size_t len, loff_t* pOffset );
-   unsigned int (*pOnPoll)( struct file* pInstance, poll_table* pPollTable );
-   long         (*pOnIoctrl)( struct file* pInstance, unsigned int cmd,
-                              unsigned long arg );
-} USER_INRTEFACE_T;
+   void*                         pObject;
+} MINOR_ENTRY_T;
+
+/*!----------------------------------------------------------------------------
+ * @brief Lookup table indexed by the minor number.
+ *
+ * Built once when the device files become created, unpublished by RCU
+ * before the objects becomes freed.
+ * @see adcBuildMinorTable
+ * @see adcFreeMinorTable
+ */
+typedef struct
+{
+   unsigned int  count;
+   MINOR_ENTRY_T aEntry[];
+} MINOR_TABLE_T;
+
+static MINOR_TABLE_T __rcu* mg_pMinorTable = NULL;
 
 /* Call-back functions for the entire chip ADS2974 begin *********************/
 /*!----------------------------------------------------------------------------
- * @see USER_INRTEFACE_T
+ * @brief The file instance of a chip device holds its asynchronous context.
+ * @see onChipOpen
  */
-static inline ADS7924_T* getChipFromInstance( struct file* pInstance )
+static inline ASYNC_CONTEXT_T* getAsyncFromInstance( struct file* pInstance )
 {
    BUG_ON( pInstance->private_data == NULL );
-   return (ADS7924_T*)(((USER_INRTEFACE_T*)pInstance->private_data)->pPrivate);
+   return (ASYNC_CONTEXT_T*)pInstance->private_data;
 }
 
 /*!----------------------------------------------------------------------------
- *  @brief Not really used for entire chip access. Dummy
+ * @see getAsyncFromInstance
+ */
+static inline ADS7924_T* getChipFromInstance( struct file* pInstance )
+{
+   return getAsyncFromInstance( pInstance )->pChip;
+}
+
+/*!----------------------------------------------------------------------------
+ *  @brief Allocates the context of the asynchronous operations of this
+ *         file descriptor.
+ *  @see ASYNC
  */
 static int onChipOpen( struct inode* pInode, struct file* pInstance )
 {
    ADS7924_T* poChip;
+   ASYNC_CONTEXT_T* pAsync;
 
    DEBUG_MESSAGE( ": Minor-number: %d\n", MINOR(pInode->i_rdev) );
 
-   poChip = getChipFromInstance( pInstance );
+   poChip = (ADS7924_T*)pInstance->private_data;
+   pAsync = adcCreateAsyncContext( poChip );
+   if( pAsync == NULL )
+   {
+      ERROR_MESSAGE( ": Unable to allocate ASYNC_CONTEXT_T!\n" );
+      return -ENOMEM;
+   }
+   pInstance->private_data = pAsync;
    atomic_inc( &poChip->openCounter );
    DEBUG_MESSAGE( ": Open-counter: %d\n", atomic_read(&poChip->openCounter) );
    return 0;
 };
 
 /*!----------------------------------------------------------------------------
- *  @brief Not really used for entire chip access. Dummy
+ *  @brief Waits for the running asynchronous operations of this file
+ *         descriptor and frees its context.
  */
 static int onChipClose( struct inode *pInode, struct file* pInstance )
 {
@@ -98,6 +143,8 @@ static int onChipClose( struct inode *pInode, struct file* pInstance )
    DEBUG_MESSAGE( ": Minor-number: %d\n", MINOR(pInode->i_rdev) );
 
    poChip = getChipFromInstance( pInstance );
+   adcDestroyAsyncContext( getAsyncFromInstance( pInstance ) );
+   pInstance->private_data = NULL;
    atomic_dec( &poChip->openCounter );
    DEBUG_MESSAGE( ": Open-counter: %d\n", atomic_read(&poChip->openCounter) );
    return 0;
@@ -132,13 +179,19 @@ static ssize_t onChipWrite( struct file *pInstance,
 }
 
 /*!----------------------------------------------------------------------------
- *  @brief At the moment not really used for entire chip access. Dummy
+ *  @brief Readable while results of asynchronous operations are pending.
+ *  @see ASYNC
  */
 static unsigned int onChipPoll( struct file* pInstance, poll_table* pPollTable )
 {
+   ASYNC_CONTEXT_T* pAsync = getAsyncFromInstance( pInstance );
+
 #ifdef _DEBUG_POLL
    DEBUG_MESSAGE( "\n" );
 #endif
+   poll_wait( pInstance, &pAsync->oWaitQueue, pPollTable );
+   if( adcAsyncHasResult( pAsync ) )
+      return POLLIN | POLLRDNORM;
    return 0;
 }
 
@@ -149,13 +202,19 @@ static unsigned int onChipPoll( struct file* pInstance, poll_table* pPollTable )
  */
 static long onIoctlChipReset( ADS7924_T* pChip, unsigned long arg )
 {
+   int ret;
+
    DEBUG_MESSAGE( "\n" );
    if( atomic_read( &pChip->openCounter ) > 1 )
    {
       ERROR_MESSAGE( ": Operation only for one opened instance permitted!\n" );
       return -EMFILE;
    }
-   if( adcChipReset( pChip ) < 0 )
+   if( adcLockMode( pChip ) < 0 )
+      return -EBUSY;
+   ret = adcChipReset( pChip );
+   adcUnlockMode( pChip );
+   if( ret < 0 )
    {
       ERROR_MESSAGE( ": adcChipReset() failed!\n" );
       return -EIO;
@@ -168,8 +227,14 @@ static long onIoctlChipReset( ADS7924_T* pChip, unsigned long arg )
  */
 static long onIoCtlChipSetMode( ADS7924_T* pChip, unsigned long arg )
 {
+   int ret;
+
    DEBUG_MESSAGE( ": Setting mode 0x%02X: %s\n", (int)arg, getModeName( arg ));
-   if( adcWriteModeByte( pChip, arg ) < 0 )
+   if( adcLockMode( pChip ) < 0 )
+      return -EBUSY;
+   ret = adcWriteModeByte( pChip, arg );
+   adcUnlockMode( pChip );
+   if( ret < 0 )
    {
       ERROR_MESSAGE( ": adcWriteModeByte() failed!\n" );
       return -EIO;
@@ -429,485 +494,1966 @@ static long onIoCtlChipEditPwrconfig( ADS7924_T* pChip, unsigned long arg )
 
 /*!----------------------------------------------------------------------------
  * @ingroup IOCTL_CHIP
- * @brief Initializer list of function table for entire chip specific ioctl().
- *
- * Alternative to switch-case statements, which would be very large
- * and very confusing.
- *
- * @see onChipIoctrl
- * @see IOC_CHIP_INFO_T
+ * @see OFFSET_CALIBRATION
  */
-const IOC_CHIP_INFO_T mg_fTabIoctrlChip[] =
+static long onIoCtlChipSetOffsetCalInterval( ADS7924_T* pChip, unsigned long arg )
 {
-   IOCTL_ITEM( ADS7924_IOCTL_RESET,          onIoctlChipReset ),
-   IOCTL_ITEM( ADS7924_IOCTL_SET_MODE,       onIoCtlChipSetMode ),
-   IOCTL_ITEM( ADS7924_IOCTL_GET_MODE,       onIoCtlChipGetMode ),
-   IOCTL_ITEM( ADS7924_IOCTL_SET_INTCONFIG,  onIoCtlChipSetIntconfig ),
-   IOCTL_ITEM( ADS7924_IOCTL_GET_INTCONFIG,  onIoCtlChipGetIntconfig ),
-   IOCTL_ITEM( ADS7924_IOCTL_EDIT_INTCONFIG, onIoCtlChipEditIntconfig ),
-   IOCTL_ITEM( ADS7924_IOCTL_SET_SLPCONFIG,  onIoCtlChipSetSlpconfig ),
-   IOCTL_ITEM( ADS7924_IOCTL_GET_SLPCONFIG,  onIoCtlChipGetSlpconfig ),
-   IOCTL_ITEM( ADS7924_IOCTL_EDIT_SLPCONFIG, onIoCtlChipEditSlpconfig ),
-   IOCTL_ITEM( ADS7924_IOCTL_SET_ACQCONFIG,  onIoCtlChipSetAcqconfig ),
-   IOCTL_ITEM( ADS7924_IOCTL_GET_ACQCONFIG,  onIoCtlChipGetAcqconfig ),
-   IOCTL_ITEM( ADS7924_IOCTL_EDIT_ACQCONFIG, onIoCtlChipEditAcqconfig ),
-   IOCTL_ITEM( ADS7924_IOCTL_SET_PWRCONFIG,  onIoCtlChipSetPwrconfig ),
-   IOCTL_ITEM( ADS7924_IOCTL_GET_PWRCONFIG,  onIoCtlChipGetPwrconfig ),
-   IOCTL_ITEM( ADS7924_IOCTL_EDIT_PWRCONFIG, onIoCtlChipEditPwrconfig ),
-   IOCTL_LIST_END
-};
+   u32 interval;
+
+   if( get_user( interval, (u32*)arg ) < 0 )
+   {
+      ERROR_MESSAGE( ": get_user() failed!\n" );
+      return -EFAULT;
+   }
+   DEBUG_MESSAGE( ": Offset calibration interval: %u ms\n", interval );
+   adcSetOffsetCalInterval( pChip, interval );
+   return 0;
+}
 
 /*!----------------------------------------------------------------------------
  * @ingroup IOCTL_CHIP
+ * @see OFFSET_CALIBRATION
  */
-static long onChipIoctrl( struct file* pInstance,
-                          unsigned int cmd,
-                          unsigned long arg )
+static long onIoCtlChipOffsetCalibrate( ADS7924_T* pChip, unsigned long arg )
 {
-   int ret = 0;
-   const IOC_CHIP_INFO_T* pCurrentItem;
-
-   DEBUG_MESSAGE( ": cmd = %d arg = %08lX\n", cmd, arg );
-   DEBUG_ACCESSMODE( pInstance );
-   BUG_ON( pInstance->private_data == NULL );
+   int ret;
 
-   for( pCurrentItem = mg_fTabIoctrlChip; pCurrentItem->function != NULL; pCurrentItem++ )
-   {
-      if( pCurrentItem->number != cmd )
-         continue;
-      DEBUG_MESSAGE( ": execute ioctl-command: %s\n", pCurrentItem->name );
-      ret = pCurrentItem->function( getChipFromInstance(pInstance), arg );
-      if( ret < 0 )
-         ERROR_MESSAGE( ": executing of ioctl-command %s failed!\n",
-                        pCurrentItem->name );
+   ret = adcDoOffsetCalibration( pChip );
+   if( ret == -EBUSY )
       return ret;
+   if( ret < 0 )
+   {
+      ERROR_MESSAGE( ": adcDoOffsetCalibration() failed!\n" );
+      return -EIO;
    }
-
-   ERROR_MESSAGE( ": Unknown ioctl-command: 0x%08X\n", cmd );
-   return -EINVAL;
+   return 0;
 }
-/* ioctrl call back functions for entire chip access END *********************/
-/* Call-back functions for the entire chip ADS2974 end ***********************/
 
-/* Call-back functions for single analog channel begin ***********************/
 /*!----------------------------------------------------------------------------
- *  @see USER_INRTEFACE_T
+ * @ingroup IOCTL_CHIP
+ * @see OFFSET_CALIBRATION
  */
-static inline ADC_CHANNEL_T* getChannelFromInstance( struct file* pInstance )
+static long onIoCtlChipGetOffsetHistory( ADS7924_T* pChip, unsigned long arg )
 {
-   BUG_ON( pInstance->private_data == NULL );
-   return (ADC_CHANNEL_T*)(((USER_INRTEFACE_T*)pInstance->private_data)->pPrivate);
+   ADS7924_OFFSET_HISTORY_T history;
+
+   adcGetOffsetHistory( pChip, &history );
+   if( copy_to_user( (void*)arg, &history, sizeof( ADS7924_OFFSET_HISTORY_T ) ) != 0 )
+   {
+      ERROR_MESSAGE( ": copy_to_user() failed!\n" );
+      return -EFAULT;
+   }
+   return 0;
 }
 
 /*!----------------------------------------------------------------------------
- * @brief Callback function for opening one of the analog channels for reading
- *        the received analog value or using ioctl().
+ * @ingroup IOCTL_CHIP
+ * @see ADS7924_RATE_T
  */
-static int onChannelOpen( struct inode* pInode, struct file* pInstance )
+static long onIoCtlChipSetRate( ADS7924_T* pChip, unsigned long arg )
 {
-   ADC_CHANNEL_T* poChannel;
-
-   DEBUG_MESSAGE( ": Minor-number: %d\n", MINOR(pInode->i_rdev) );
+   ADS7924_RATE_T rate;
+   u8 aConfig[3];
+   u8 aMask[ARRAY_SIZE( aConfig )];
+   int ret;
 
-   poChannel = getChannelFromInstance( pInstance );
-   BUG_ON( poChannel == NULL );
-   BUG_ON( poChannel->minor != MINOR(pInode->i_rdev) );
+   if( copy_from_user( &rate, (void*)arg, sizeof( ADS7924_RATE_T ) ) != 0 )
+   {
+      ERROR_MESSAGE( ": copy_from_user() failed!\n" );
+      return -EFAULT;
+   }
 
-   if( atomic_inc_return( &poChannel->openCounter ) == 1 )
-      poChannel->waitQueue.awoken = false;
+   ret = adcSolveRate( &rate, aMask );
+   if( ret < 0 )
+      return ret;
 
-   DEBUG_MESSAGE( ": Open-counter: %d\n", atomic_read(&poChannel->openCounter) );
-   DEBUG_MESSAGE( ": Channel number = %d\n", poChannel->cannelNumber );
+   if( adcLockMode( pChip ) < 0 )
+      return -EBUSY;
+   aConfig[0] = rate.slpConfig;
+   aConfig[1] = rate.acqConfig;
+   aConfig[2] = rate.pwrConfig;
+   ret = adcWriteTimingConfig( pChip, rate.mode, aConfig, aMask );
+   adcUnlockMode( pChip );
+   if( ret < 0 )
+   {
+      ERROR_MESSAGE( ": adcWriteTimingConfig() failed!\n" );
+      return -EIO;
+   }
+   rate.slpConfig = aConfig[0];
+   rate.acqConfig = aConfig[1];
+   rate.pwrConfig = aConfig[2];
 
+   if( copy_to_user( (void*)arg, &rate, sizeof( ADS7924_RATE_T ) ) != 0 )
+   {
+      ERROR_MESSAGE( ": copy_to_user() failed!\n" );
+      return -EFAULT;
+   }
    return 0;
 }
 
 /*!----------------------------------------------------------------------------
- * @brief Callback function for closing one of the analog channels.
+ * @ingroup IOCTL_CHIP
+ * @see ADS7924_SCAN_RATE_T
  */
-static int onChannelClose( struct inode *pInode, struct file* pInstance )
+static long onIoCtlChipGetScanRate( ADS7924_T* pChip, unsigned long arg )
 {
-   ADC_CHANNEL_T* poChannel;
-   DEBUG_MESSAGE( ": Minor-number: %d\n", MINOR(pInode->i_rdev) );
-
-   poChannel = getChannelFromInstance( pInstance );
-   BUG_ON( poChannel == NULL );
-   BUG_ON( poChannel->minor != MINOR(pInode->i_rdev) );
-
-   atomic_dec( &poChannel->openCounter );
-   DEBUG_MESSAGE( ": Open-counter: %d\n", atomic_read(&poChannel->openCounter) );
-   DEBUG_MESSAGE( ": Channel number = %d\n", poChannel->cannelNumber );
+   ADS7924_SCAN_RATE_T scanRate;
 
+   if( adcGetScanRate( pChip, &scanRate ) < 0 )
+   {
+      ERROR_MESSAGE( ": adcGetScanRate() failed!\n" );
+      return -EIO;
+   }
+   if( copy_to_user( (void*)arg, &scanRate, sizeof( ADS7924_SCAN_RATE_T ) ) != 0 )
+   {
+      ERROR_MESSAGE( ": copy_to_user() failed!\n" );
+      return -EFAULT;
+   }
    return 0;
 }
 
 /*!----------------------------------------------------------------------------
- * @brief Base function becomes invoked by the callback-function
- *        onChannelRead()
- * @see onChannelRead
+ * @ingroup IOCTL_CHIP
+ * @see ADS7924_SCAN_RATE_T
  */
-static inline ssize_t _onChannelRead( ADC_CHANNEL_T* pChannel,
-                                      char __user* pBuffer,
-                                      size_t len,
-                                      loff_t* pOffset )
+static long onIoCtlChipSetDriftCorrection( ADS7924_T* pChip, unsigned long arg )
 {
-   char tmp[16];
-   void* pOut;
-   ssize_t n;
-   size_t limit;
-   VALUE_T result;
+   u32 enable;
 
-   if( ((*pOffset) == 0) && !pChannel->result.isValid )
+   if( get_user( enable, (u32*)arg ) < 0 )
    {
-      if( readAnalogValue( pChannel ) < 0 )
-      {
-         ERROR_MESSAGE( ": Unable to read analog channel %d\n", pChannel->cannelNumber );
-         return -EIO;
-      }
-   //   pChannel->result.isValid = false;
+      ERROR_MESSAGE( ": get_user() failed!\n" );
+      return -EFAULT;
    }
-   pChannel->result.isValid = false;
+   DEBUG_MESSAGE( ": Drift correction: %u\n", enable );
+   adcSetDriftCorrection( pChip, enable != 0 );
+   return 0;
+}
 
-   result = getResult( pChannel );
-   limit = min( len, sizeof(tmp)-1 );
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHIP
+ * @see STREAMING
+ */
+static long onIoCtlChipSetStreaming( ADS7924_T* pChip, unsigned long arg )
+{
+   DEBUG_MESSAGE( ": Streaming mode: %d\n", (int)arg );
+   if( arg > U8_MAX )
+      return -EINVAL;
+   return adcSetStreaming( pChip, arg );
+}
 
-   //TODO: snprintf() is a little bit expensive.
-   //      Worry that they are called only once per user-read.
-   switch( pChannel->outputFormat )
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHIP
+ * @see STREAMING
+ */
+static long onIoCtlChipGetStreaming( ADS7924_T* pChip, unsigned long arg )
+{
+   if( put_user( pChip->streamMode, (u8*)arg ) < 0 )
    {
-      case OUT_BIN:
-      {
-         n = min( len, sizeof( result ));
-         break;
-      }
-      case OUT_DEC:
-      {
-         n = snprintf( tmp, limit, "%d", result );
-         tmp[n++] = '\0';
-         break;
-      }
-      case OUT_HEX:
-      {
-         n = snprintf( tmp, limit, "%03X", result );
-         tmp[n++] = '\0';
-         break;
-      }
-      default:
-      {
-         BUG_ON( true ); // respectively: assert( false )
-         break;
-      }
+      ERROR_MESSAGE( ": put_user() failed!\n" );
+      return -EFAULT;
    }
+   return 0;
+}
 
-   DEBUG_MESSAGE( ": n = %d\n", n );
-   n -= (*pOffset);
-   if( n <= 0 )
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHIP
+ * @see SEQUENCER
+ */
+static long onIoCtlChipSetSequencer( ADS7924_T* pChip, unsigned long arg )
+{
+   DEBUG_MESSAGE( ": Sequencer mode: %d\n", (int)arg );
+   if( arg > U8_MAX )
+      return -EINVAL;
+   return adcSetSequencer( pChip, arg );
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHIP
+ * @see SEQUENCER
+ */
+static long onIoCtlChipGetSequencer( ADS7924_T* pChip, unsigned long arg )
+{
+   if( put_user( pChip->sequencer.mode, (u8*)arg ) < 0 )
    {
-      *pOffset = 0;
-      //pChannel->waitQueue.waiting = true; //TEST
-      return 0;
+      ERROR_MESSAGE( ": put_user() failed!\n" );
+      return -EFAULT;
    }
+   return 0;
+}
 
-   if( pChannel->outputFormat == OUT_BIN )
-      pOut = &result;
-   else
-      pOut = tmp + *pOffset;
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHIP
+ * @see SEQUENCER
+ */
+static long onIoCtlChipSetSchedule( ADS7924_T* pChip, unsigned long arg )
+{
+   ADS7924_SCHEDULE_T schedule;
 
-   if( copy_to_user( pBuffer, pOut, n ) != 0 )
+   if( copy_from_user( &schedule, (void*)arg, sizeof( ADS7924_SCHEDULE_T ) ) != 0 )
    {
-      ERROR_MESSAGE( "copy_to_user: %d bytes\n", n );
+      ERROR_MESSAGE( ": copy_from_user() failed!\n" );
       return -EFAULT;
    }
+   return adcSetSchedule( pChip, &schedule );
+}
 
-   if( pChannel->outputFormat != OUT_BIN )
-      (*pOffset) += n;
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHIP
+ * @see SEQUENCER
+ */
+static long onIoCtlChipGetScheduleStats( ADS7924_T* pChip, unsigned long arg )
+{
+   ADS7924_SCHEDULE_STATS_T stats;
 
-   return n;
-   /* Number of bytes successfully read. */
+   adcGetScheduleStats( pChip, &stats );
+   if( copy_to_user( (void*)arg, &stats, sizeof( ADS7924_SCHEDULE_STATS_T ) ) != 0 )
+   {
+      ERROR_MESSAGE( ": copy_to_user() failed!\n" );
+      return -EFAULT;
+   }
+   return 0;
 }
 
 /*!----------------------------------------------------------------------------
- * @brief Callback function becomes invoked by the function read() from the
- *        user-space.
- * @note The kernel invokes onRead as many times till it returns 0 !!!
+ * @ingroup IOCTL_CHIP
+ * @brief Validates a entry of a batch.
+ * @see BATCH
  */
-static ssize_t onChannelRead( struct file* pInstance,   /*!< @see include/linux/fs.h   */
-                              char __user* pBuffer,     /*!< buffer to fill with data */
-                              size_t len,               /*!< length of the buffer     */
-                              loff_t* pOffset )
+static int checkBatchEntry( const ADS7924_BATCH_ENTRY_T* pEntry )
 {
-   ssize_t n;
-   ADC_CHANNEL_T* pChannel;
+   if( (pEntry->reg != ADS7924_REG_MODECNTRL) &&
+       ((pEntry->reg < ADS7924_REG_ULR( 0 )) || (pEntry->reg > ADS7924_REG_PWRCONFIG)) )
+      return -EINVAL;
+
+   switch( pEntry->operation )
+   {
+      case ADS7924_BATCH_READ:
+         return 0;
+      case ADS7924_BATCH_WRITE:
+      case ADS7924_BATCH_EDIT:
+         break;
+      default:
+         return -EINVAL;
+   }
+
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns true if the entry of a batch writes the register MODECNTRL.
+ * @see BATCH
+ */
+static inline bool isModeWrite( const ADS7924_BATCH_ENTRY_T* pEntry )
+{
+   return (pEntry->reg == ADS7924_REG_MODECNTRL) &&
+          (pEntry->operation != ADS7924_BATCH_READ);
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHIP
+ * @see BATCH
+ */
+static long onIoCtlChipBatch( ADS7924_T* pChip, unsigned long arg )
+{
+   ADS7924_BATCH_T batch;
+   unsigned int i, j, modeWrite;
+   int ret = 0;
+
+   if( copy_from_user( &batch, (void*)arg, sizeof( ADS7924_BATCH_T ) ) != 0 )
+   {
+      ERROR_MESSAGE( ": copy_from_user() failed!\n" );
+      return -EFAULT;
+   }
+   if( batch.count > ADS7924_BATCH_SIZE )
+      return -EINVAL;
+
+   modeWrite = batch.count;
+   for( i = 0; i < batch.count; i++ )
+   {
+      ret = checkBatchEntry( &batch.aEntry[i] );
+      if( ret < 0 )
+         break;
+      if( (modeWrite == batch.count) && isModeWrite( &batch.aEntry[i] ) )
+         modeWrite = i;
+   }
+
+   /* A batch which writes MODECNTRL owns the mode until it is done. */
+   if( (ret == 0) && (modeWrite < batch.count) )
+   {
+      ret = adcLockMode( pChip );
+      if( ret < 0 )
+         i = modeWrite;
+   }
+
+   if( ret == 0 )
+   {
+      batch.done = adcExecuteBatch( pChip, batch.aEntry, batch.count );
+      if( modeWrite < batch.count )
+         adcUnlockMode( pChip );
+      if( batch.done < batch.count )
+         ret = batch.aEntry[batch.done].status;
+   }
+   else
+   { /* Nothing becomes executed. */
+      for( j = 0; j < batch.count; j++ )
+         batch.aEntry[j].status = (j == i)? ret : -ECANCELED;
+      batch.done = 0;
+   }
+
+   if( copy_to_user( (void*)arg, &batch, sizeof( ADS7924_BATCH_T ) ) != 0 )
+   {
+      ERROR_MESSAGE( ": copy_to_user() failed!\n" );
+      return -EFAULT;
+   }
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHIP
+ * @brief Initializer list of function table for entire chip specific ioctl().
+ *
+ * Alternative to switch-case statements, which would be very large
+ * and very confusing.
+ *
+ * @see onChipIoctrl
+ * @see IOC_CHIP_INFO_T
+ */
+const IOC_CHIP_INFO_T mg_fTabIoctrlChip[] =
+{
+   IOCTL_ITEM( ADS7924_IOCTL_RESET,          onIoctlChipReset ),
+   IOCTL_ITEM( ADS7924_IOCTL_SET_MODE,       onIoCtlChipSetMode ),
+   IOCTL_ITEM( ADS7924_IOCTL_GET_MODE,       onIoCtlChipGetMode ),
+   IOCTL_ITEM( ADS7924_IOCTL_SET_INTCONFIG,  onIoCtlChipSetIntconfig ),
+   IOCTL_ITEM( ADS7924_IOCTL_GET_INTCONFIG,  onIoCtlChipGetIntconfig ),
+   IOCTL_ITEM( ADS7924_IOCTL_EDIT_INTCONFIG, onIoCtlChipEditIntconfig ),
+   IOCTL_ITEM( ADS7924_IOCTL_SET_SLPCONFIG,  onIoCtlChipSetSlpconfig ),
+   IOCTL_ITEM( ADS7924_IOCTL_GET_SLPCONFIG,  onIoCtlChipGetSlpconfig ),
+   IOCTL_ITEM( ADS7924_IOCTL_EDIT_SLPCONFIG, onIoCtlChipEditSlpconfig ),
+   IOCTL_ITEM( ADS7924_IOCTL_SET_ACQCONFIG,  onIoCtlChipSetAcqconfig ),
+   IOCTL_ITEM( ADS7924_IOCTL_GET_ACQCONFIG,  onIoCtlChipGetAcqconfig ),
+   IOCTL_ITEM( ADS7924_IOCTL_EDIT_ACQCONFIG, onIoCtlChipEditAcqconfig ),
+   IOCTL_ITEM( ADS7924_IOCTL_SET_PWRCONFIG,  onIoCtlChipSetPwrconfig ),
+   IOCTL_ITEM( ADS7924_IOCTL_GET_PWRCONFIG,  onIoCtlChipGetPwrconfig ),
+   IOCTL_ITEM( ADS7924_IOCTL_EDIT_PWRCONFIG, onIoCtlChipEditPwrconfig ),
+   IOCTL_ITEM( ADS7924_IOCTL_SET_OFFSET_CAL_INTERVAL, onIoCtlChipSetOffsetCalInterval ),
+   IOCTL_ITEM( ADS7924_IOCTL_OFFSET_CALIBRATE, onIoCtlChipOffsetCalibrate ),
+   IOCTL_ITEM( ADS7924_IOCTL_GET_OFFSET_HISTORY, onIoCtlChipGetOffsetHistory ),
+   IOCTL_ITEM( ADS7924_IOCTL_SET_RATE,       onIoCtlChipSetRate ),
+   IOCTL_ITEM( ADS7924_IOCTL_GET_SCAN_RATE,  onIoCtlChipGetScanRate ),
+   IOCTL_ITEM( ADS7924_IOCTL_SET_DRIFT_CORRECTION, onIoCtlChipSetDriftCorrection ),
+   IOCTL_ITEM( ADS7924_IOCTL_SET_STREAMING,  onIoCtlChipSetStreaming ),
+   IOCTL_ITEM( ADS7924_IOCTL_GET_STREAMING,  onIoCtlChipGetStreaming ),
+   IOCTL_ITEM( ADS7924_IOCTL_SET_SEQUENCER,  onIoCtlChipSetSequencer ),
+   IOCTL_ITEM( ADS7924_IOCTL_GET_SEQUENCER,  onIoCtlChipGetSequencer ),
+   IOCTL_ITEM( ADS7924_IOCTL_SET_SCHEDULE,   onIoCtlChipSetSchedule ),
+   IOCTL_ITEM( ADS7924_IOCTL_GET_SCHEDULE_STATS, onIoCtlChipGetScheduleStats ),
+   IOCTL_ITEM( ADS7924_IOCTL_BATCH,          onIoCtlChipBatch ),
+   IOCTL_LIST_END
+};
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHIP
+ * @see ASYNC
+ */
+static long onIoCtlAsyncSubmit( ASYNC_CONTEXT_T* pContext, unsigned long arg )
+{
+   ADS7924_ASYNC_T request;
+   int ret;
+
+   if( copy_from_user( &request, (void*)arg, sizeof( request ) ) != 0 )
+   {
+      ERROR_MESSAGE( ": copy_from_user() failed!\n" );
+      return -EFAULT;
+   }
+   ret = adcAsyncSubmitRequest( pContext, &request );
+   if( ret < 0 )
+      return ret;
+   if( put_user( request.token, &((ADS7924_ASYNC_T*)arg)->token ) < 0 )
+   {
+      ERROR_MESSAGE( ": put_user() failed!\n" );
+      return -EFAULT;
+   }
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHIP
+ * @see ASYNC
+ */
+static long onIoCtlAsyncResult( ASYNC_CONTEXT_T* pContext, unsigned long arg )
+{
+   ADS7924_ASYNC_RESULT_T result;
+   int ret;
+
+   ret = adcAsyncFetchResult( pContext, &result );
+   if( ret < 0 )
+      return ret;
+   if( copy_to_user( (void*)arg, &result, sizeof( result ) ) != 0 )
+   {
+      ERROR_MESSAGE( ": copy_to_user() failed!\n" );
+      return -EFAULT;
+   }
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHIP
+ * @see ASYNC
+ */
+static long onIoCtlAsyncSetEventFd( ASYNC_CONTEXT_T* pContext, unsigned long arg )
+{
+   DEBUG_MESSAGE( ": eventfd: %d\n", (int)arg );
+   return adcAsyncSetEventFd( pContext, (int)arg );
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHIP
+ * @brief Function table of the asynchronous ioctl-commands of the chip
+ *        devices, which need the file descriptor related context instead
+ *        of the chip.
+ * @see onChipIoctrl
+ * @see IOC_ASYNC_INFO_T
+ */
+const IOC_ASYNC_INFO_T mg_fTabIoctrlAsync[] =
+{
+   IOCTL_ITEM( ADS7924_IOCTL_ASYNC_SUBMIT,      onIoCtlAsyncSubmit ),
+   IOCTL_ITEM( ADS7924_IOCTL_ASYNC_RESULT,      onIoCtlAsyncResult ),
+   IOCTL_ITEM( ADS7924_IOCTL_ASYNC_SET_EVENTFD, onIoCtlAsyncSetEventFd ),
+   IOCTL_LIST_END
+};
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHIP
+ */
+static long onChipIoctrl( struct file* pInstance,
+                          unsigned int cmd,
+                          unsigned long arg )
+{
+   int ret = 0;
+   const IOC_CHIP_INFO_T* pCurrentItem;
+   const IOC_ASYNC_INFO_T* pAsyncItem;
+
+   DEBUG_MESSAGE( ": cmd = %d arg = %08lX\n", cmd, arg );
+   DEBUG_ACCESSMODE( pInstance );
+   BUG_ON( pInstance->private_data == NULL );
+
+   for( pAsyncItem = mg_fTabIoctrlAsync; pAsyncItem->function != NULL; pAsyncItem++ )
+   {
+      if( pAsyncItem->number != cmd )
+         continue;
+      DEBUG_MESSAGE( ": execute ioctl-command: %s\n", pAsyncItem->name );
+      ret = pAsyncItem->function( getAsyncFromInstance(pInstance), arg );
+      /* EAGAIN is the regular answer of a non-blocking event-loop. */
+      if( (ret < 0) && (ret != -EAGAIN) )
+         ERROR_MESSAGE( ": executing of ioctl-command %s failed!\n",
+                        pAsyncItem->name );
+      return ret;
+   }
+
+   for( pCurrentItem = mg_fTabIoctrlChip; pCurrentItem->function != NULL; pCurrentItem++ )
+   {
+      if( pCurrentItem->number != cmd )
+         continue;
+      DEBUG_MESSAGE( ": execute ioctl-command: %s\n", pCurrentItem->name );
+      ret = pCurrentItem->function( getChipFromInstance(pInstance), arg );
+      if( ret < 0 )
+         ERROR_MESSAGE( ": executing of ioctl-command %s failed!\n",
+                        pCurrentItem->name );
+      return ret;
+   }
+
+   ERROR_MESSAGE( ": Unknown ioctl-command: 0x%08X\n", cmd );
+   return -EINVAL;
+}
+/* ioctrl call back functions for entire chip access END *********************/
+/* Call-back functions for the entire chip ADS2974 end ***********************/
+
+/* Call-back functions for single analog channel begin ***********************/
+/*!----------------------------------------------------------------------------
+ *  @see onOpen
+ */
+static inline ADC_CHANNEL_T* getChannelFromInstance( struct file* pInstance )
+{
+   BUG_ON( pInstance->private_data == NULL );
+   return (ADC_CHANNEL_T*)pInstance->private_data;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Callback function for opening one of the analog channels for reading
+ *        the received analog value or using ioctl().
+ */
+static int onChannelOpen( struct inode* pInode, struct file* pInstance )
+{
+   ADC_CHANNEL_T* poChannel;
+
+   DEBUG_MESSAGE( ": Minor-number: %d\n", MINOR(pInode->i_rdev) );
+
+   poChannel = getChannelFromInstance( pInstance );
+   BUG_ON( poChannel == NULL );
+   BUG_ON( poChannel->minor != MINOR(pInode->i_rdev) );
+
+   if( atomic_inc_return( &poChannel->openCounter ) == 1 )
+      poChannel->waitQueue.awoken = false;
+
+   DEBUG_MESSAGE( ": Open-counter: %d\n", atomic_read(&poChannel->openCounter) );
+   DEBUG_MESSAGE( ": Channel number = %d\n", poChannel->cannelNumber );
+
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Callback function for closing one of the analog channels.
+ */
+static int onChannelClose( struct inode *pInode, struct file* pInstance )
+{
+   ADC_CHANNEL_T* poChannel;
+   DEBUG_MESSAGE( ": Minor-number: %d\n", MINOR(pInode->i_rdev) );
+
+   poChannel = getChannelFromInstance( pInstance );
+   BUG_ON( poChannel == NULL );
+   BUG_ON( poChannel->minor != MINOR(pInode->i_rdev) );
+
+   atomic_dec( &poChannel->openCounter );
+   DEBUG_MESSAGE( ": Open-counter: %d\n", atomic_read(&poChannel->openCounter) );
+   DEBUG_MESSAGE( ": Channel number = %d\n", poChannel->cannelNumber );
+
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Base function becomes invoked by the callback-function
+ *        onChannelRead()
+ * @see onChannelRead
+ */
+static inline ssize_t _onChannelRead( ADC_CHANNEL_T* pChannel,
+                                      char __user* pBuffer,
+                                      size_t len,
+                                      loff_t* pOffset )
+{
+   char tmp[16];
+   void* pOut;
+   ssize_t n;
+   size_t limit;
+   VALUE_T result;
+   const s32* pScaleTable;
+   ADS7924_SAMPLE_T sample;
+
+   /*
+    * In the cached-read mode provideFreshValue() has been already decided
+    * about the age of the result.
+    */
+   if( ((*pOffset) == 0) && !pChannel->result.isValid && (pChannel->maxAge == 0) )
+   {
+      if( adcCoalescedRead( pChannel ) < 0 )
+      {
+         ERROR_MESSAGE( ": Unable to read analog channel %d\n", pChannel->cannelNumber );
+         return -EIO;
+      }
+   //   pChannel->result.isValid = false;
+   }
+   pChannel->result.isValid = false;
+
+   result = getResult( pChannel );
+   limit = min( len, sizeof(tmp)-1 );
+
+   //TODO: snprintf() is a little bit expensive.
+   //      Worry that they are called only once per user-read.
+   switch( pChannel->outputFormat )
+   {
+      case OUT_BIN:
+      {
+         n = min( len, sizeof( result ));
+         break;
+      }
+      case OUT_DEC:
+      {
+         n = scnprintf( tmp, limit, "%d", result );
+         tmp[n++] = '\0';
+         break;
+      }
+      case OUT_HEX:
+      {
+         n = scnprintf( tmp, limit, "%03X", result );
+         tmp[n++] = '\0';
+         break;
+      }
+      case OUT_SCALED:
+      {
+         pScaleTable = adcGetScaleTable( pChannel );
+         if( pScaleTable == NULL )
+            return -ENOMEM;
+         n = scnprintf( tmp, limit, "%d", pScaleTable[result & ADS7924_MAX_VALUE] );
+         tmp[n++] = '\0';
+         break;
+      }
+      case OUT_SAMPLE:
+      {
+         getSample( pChannel, &sample );
+         n = min( len, sizeof( sample ));
+         break;
+      }
+      default:
+      {
+         BUG_ON( true ); // respectively: assert( false )
+         break;
+      }
+   }
+
+   /*
+    * scnprintf() returns the characters actually written within limit,
+    * the appended zero could exceed the user buffer only by len == 0.
+    */
+   n = min_t( int, n, len );
+   DEBUG_MESSAGE( ": n = %d\n", n );
+   n -= (*pOffset);
+   if( n <= 0 )
+   {
+      *pOffset = 0;
+      //pChannel->waitQueue.waiting = true; //TEST
+      return 0;
+   }
+
+   if( pChannel->outputFormat == OUT_BIN )
+      pOut = &result;
+   else if( pChannel->outputFormat == OUT_SAMPLE )
+      pOut = &sample;
+   else
+      pOut = tmp + *pOffset;
+
+   if( copy_to_user( pBuffer, pOut, n ) != 0 )
+   {
+      ERROR_MESSAGE( "copy_to_user: %d bytes\n", n );
+      return -EFAULT;
+   }
+
+   if( (pChannel->outputFormat != OUT_BIN) && (pChannel->outputFormat != OUT_SAMPLE) )
+      (*pOffset) += n;
+
+   return n;
+   /* Number of bytes successfully read. */
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Base function becomes invoked by the callback-function
+ *        onChannelRead() in the streaming mode.
+ *
+ * Copies as many samples of the FIFO as fit in the user buffer,
+ * in the ASCII formats one line per sample.
+ * @see STREAMING
+ * @see onChannelRead
+ */
+static ssize_t _onChannelStreamRead( ADC_CHANNEL_T* pChannel,
+                                     char __user* pBuffer,
+                                     size_t len )
+{
+   ADS7924_SAMPLE_T aSample[STREAM_READ_BATCH];
+   char tmp[16];
+   const void* pOut = tmp;
+   const s32* pScaleTable = NULL;
+   size_t recordSize;
+   size_t done = 0;
+   unsigned int i, n;
+   int m;
+
+   switch( pChannel->outputFormat )
+   {
+      case OUT_BIN:    recordSize = sizeof( VALUE_T );          break;
+      case OUT_SAMPLE: recordSize = sizeof( ADS7924_SAMPLE_T ); break;
+      default:         recordSize = sizeof( tmp );              break;
+   }
+   if( len < recordSize )
+      return -EINVAL;
+
+   if( pChannel->outputFormat == OUT_SCALED )
+   {
+      pScaleTable = adcGetScaleTable( pChannel );
+      if( pScaleTable == NULL )
+         return -ENOMEM;
+   }
+
+   while( (len - done) >= recordSize )
+   {
+      n = adcPopSamples( pChannel, aSample,
+                         min_t( size_t, STREAM_READ_BATCH, (len - done) / recordSize ) );
+      if( n == 0 )
+         break;
+
+      for( i = 0; i < n; i++ )
+      {
+         switch( pChannel->outputFormat )
+         {
+            case OUT_BIN:
+            {
+               pOut = &aSample[i].value;
+               m = sizeof( VALUE_T );
+               break;
+            }
+            case OUT_SAMPLE:
+            {
+               pOut = &aSample[i];
+               m = sizeof( ADS7924_SAMPLE_T );
+               break;
+            }
+            case OUT_HEX:
+            {
+               m = scnprintf( tmp, sizeof( tmp ), "%03X\n", aSample[i].value );
+               break;
+            }
+            case OUT_SCALED:
+            {
+               m = scnprintf( tmp, sizeof( tmp ), "%d\n",
+                              pScaleTable[aSample[i].value & ADS7924_MAX_VALUE] );
+               break;
+            }
+            default:
+            {
+               m = scnprintf( tmp, sizeof( tmp ), "%d\n", aSample[i].value );
+               break;
+            }
+         }
+         if( copy_to_user( pBuffer + done, pOut, m ) != 0 )
+         {
+            ERROR_MESSAGE( "copy_to_user: %d bytes\n", m );
+            return -EFAULT;
+         }
+         done += m;
+      }
+   }
+   return done;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Provides a fresh value in pChannel->result according to the read
+ *        policy of the channel.
+ * @retval ==0 OK or policy ADS7924_FRESH_READ_OFF without maximum age
+ * @retval <0  Error
+ * @see FRESH_READ
+ */
+static int provideFreshValue( ADC_CHANNEL_T* pChannel )
+{
+   int ret;
+
+   switch( pChannel->freshRead )
+   {
+      case ADS7924_FRESH_READ_CONVERSION:
+      {
+         ret = adcFreshConversion( pChannel );
+         break;
+      }
+      case ADS7924_FRESH_READ_NEXT_SCAN:
+      {
+         ret = adcWaitNextConversion( pChannel );
+         break;
+      }
+      default:
+      {
+         if( pChannel->maxAge == 0 )
+            return 0;
+         ret = adcCachedRead( pChannel );
+         break;
+      }
+   }
+
+   if( ret == -ERESTARTSYS )
+      return ret;
+   if( ret < 0 )
+   {
+      ERROR_MESSAGE( ": Unable to convert analog channel %d\n", pChannel->cannelNumber );
+      return -EIO;
+   }
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Callback function becomes invoked by the function read() from the
+ *        user-space.
+ * @note The kernel invokes onRead as many times till it returns 0 !!!
+ */
+static ssize_t onChannelRead( struct file* pInstance,   /*!< @see include/linux/fs.h   */
+                              char __user* pBuffer,     /*!< buffer to fill with data */
+                              size_t len,               /*!< length of the buffer     */
+                              loff_t* pOffset )
+{
+   ssize_t n;
+   ADC_CHANNEL_T* pChannel;
+
+   DEBUG_MESSAGE( ": len = %ld, offset = %lld\n", (long int)len, *pOffset );
+   DEBUG_ACCESSMODE( pInstance );
+
+   pChannel = getChannelFromInstance( pInstance );
+   BUG_ON( pChannel == NULL );
+
+   DEBUG_MESSAGE( ": Minor: %d\n", pChannel->minor );
+   DEBUG_MESSAGE( ": Open-counter: %d\n", atomic_read( &pChannel->openCounter ));
+   DEBUG_MESSAGE( ": *** Channel number = %d ***\n", pChannel->cannelNumber );
+
+   if( adcIsCapturing( pChannel ) )
+   {
+      if( !adcIsCaptureReady( pChannel ) )
+      {
+         if( (pInstance->f_flags & O_NONBLOCK) != 0 )
+            return -EAGAIN;
+         if( wait_event_interruptible( pChannel->waitQueue.queue,
+                                       adcIsCaptureReady( pChannel ) ||
+                                       !adcIsCapturing( pChannel ) ||
+                                       !adcIsStreaming( pChannel ) ) )
+         {
+            DEBUG_MESSAGE( ": Signal occurred.\n" );
+            return -ERESTARTSYS;
+         }
+      }
+      return adcReadCapture( pChannel, pBuffer, len );
+   }
+
+   if( adcIsStreaming( pChannel ) )
+   {
+      if( (pInstance->f_flags & O_NONBLOCK) != 0 )
+      {
+         if( adcFifoLevel( pChannel ) == 0 )
+            return -EAGAIN;
+      }
+      else if( !adcIsFifoReady( pChannel ) )
+      {
+         if( wait_event_interruptible( pChannel->waitQueue.queue,
+                                       adcIsFifoReady( pChannel ) ||
+                                       !adcIsStreaming( pChannel ) ) )
+         {
+            DEBUG_MESSAGE( ": Signal occurred.\n" );
+            return -ERESTARTSYS;
+         }
+      }
+      mutex_lock( &pChannel->oMutex );
+      n = _onChannelStreamRead( pChannel, pBuffer, len );
+      mutex_unlock( &pChannel->oMutex );
+      return n;
+   }
+
+   /*
+    * The on-demand conversion takes place before locking the channel,
+    * so concurrent readers can be coalesced.
+    */
+   if( (*pOffset) == 0 )
+   {
+      n = provideFreshValue( pChannel );
+      if( n < 0 )
+         return n;
+   }
+
+   if( pChannel->waitQueue.waiting && ((pInstance->f_flags & O_NONBLOCK) != 0) )
+   {
+      DEBUG_MESSAGE( ": No new analog data present.\n" );
+      return -EAGAIN;
+   }
+   if( sleepChannelIfNecessary( pChannel ) )
+   {
+      DEBUG_MESSAGE( ": Signal occurred.\n" );
+      return -ERESTARTSYS;
+   }
+
+   mutex_lock( &pChannel->oMutex );
+   n = _onChannelRead( pChannel, pBuffer, len, pOffset );
+   mutex_unlock( &pChannel->oMutex );
+
+   DEBUG_MESSAGE( ": Return %d\n", n );
+   return n;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Callback function becomes invoked by the function write() from the
+ *        user-space.
+ *
+ * At the moment this function will not really used it is a dummy.
+ */
+static ssize_t onChannelWrite( struct file *pInstance,
+                               const char __user* pBuffer,
+                               size_t len,
+                               loff_t* pOffset )
+{
+#ifdef CONFIG_DEBUG_ADS7924
+   ADC_CHANNEL_T* pChannel = getChannelFromInstance( pInstance );
+#endif
 
    DEBUG_MESSAGE( ": len = %ld, offset = %lld\n", (long int)len, *pOffset );
    DEBUG_ACCESSMODE( pInstance );
+   BUG_ON( pInstance->private_data == NULL );
+
+   DEBUG_MESSAGE( "   Minor: %d\n", pChannel->minor );
+   DEBUG_MESSAGE( "   Open-counter: %d\n",
+                   atomic_read( &pChannel->openCounter ));
+   DEBUG_MESSAGE( "Channel number = %d\n", pChannel->cannelNumber );
+   DEBUG_MESSAGE( "   Received: \"%s\"\n", pBuffer );
+   return len;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Callback function becomes invoked by the function select() from the
+ *        user-space.
+ */
+static unsigned int onChannelPoll( struct file* pInstance, poll_table* pPollTable )
+{
+   ADC_CHANNEL_T* pChannel = getChannelFromInstance( pInstance );
+#ifdef _DEBUG_POLL
+   DEBUG_MESSAGE( ": Channel number: %d\n", pChannel->cannelNumber );
+#endif
+   poll_wait( pInstance, &pChannel->waitQueue.queue, pPollTable );
+   if( adcIsCapturing( pChannel ) )
+   {
+      isAwoken( &pChannel->waitQueue );
+      return adcIsCaptureReady( pChannel )? (POLLIN | POLLRDNORM) : 0;
+   }
+   if( adcIsStreaming( pChannel ) )
+   {
+      isAwoken( &pChannel->waitQueue );
+      return adcIsFifoReady( pChannel )? (POLLIN | POLLRDNORM) : 0;
+   }
+   if( isAwoken( &pChannel->waitQueue ) )
+   {
+   #ifdef _DEBUG_POLL
+      DEBUG_MESSAGE( ": Return != 0\n" );
+   #endif
+      return (POLLIN | POLLRDNORM);
+   }
+   return 0;
+}
+
+/* ioctrl call back functions for single channel access BEGIN ****************/
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ * @see onIoctlSetReadmodeBin
+ * @see onIoctlSetReadmodeDec
+ * @see onIoctlSetReadmodeHex
+ * @see onIoctlSetReadmodeScaled
+ * @see onIoctlSetReadmodeSample
+ */
+static long setOutputFormat( ADC_CHANNEL_T* pChannel, OUTPUT_FORMAT_T outFormat )
+{
+   if( atomic_read( &pChannel->openCounter ) > 1 )
+   {
+      ERROR_MESSAGE( ": Operation only for one opened instance permitted!\n" );
+      return -EMFILE;
+   }
+   pChannel->outputFormat = outFormat;
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ */
+static long onIoctlSetReadmodeBin( ADC_CHANNEL_T* pChannel, unsigned long arg )
+{
+   DEBUG_MESSAGE( "\n" );
+   return setOutputFormat( pChannel, OUT_BIN );
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ */
+static long onIoctlSetReadmodeDec( ADC_CHANNEL_T* pChannel, unsigned long arg )
+{
+   DEBUG_MESSAGE( "\n" );
+   return setOutputFormat( pChannel, OUT_DEC );
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ */
+static long onIoctlSetReadmodeHex( ADC_CHANNEL_T* pChannel, unsigned long arg )
+{
+   DEBUG_MESSAGE( "\n" );
+   return setOutputFormat( pChannel, OUT_HEX );
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ * @see CALIBRATION
+ */
+static long onIoctlSetReadmodeScaled( ADC_CHANNEL_T* pChannel, unsigned long arg )
+{
+   DEBUG_MESSAGE( "\n" );
+   return setOutputFormat( pChannel, OUT_SCALED );
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ * @see CALIBRATION
+ */
+static long onIoCtlSetCalibration( ADC_CHANNEL_T* pChannel, unsigned long arg )
+{
+   ADS7924_CALIBRATION_T calibration;
+
+   if( copy_from_user( &calibration, (void*)arg, sizeof( ADS7924_CALIBRATION_T ) ) != 0 )
+   {
+      ERROR_MESSAGE( ": copy_from_user() failed!\n" );
+      return -EFAULT;
+   }
+   DEBUG_MESSAGE( ": gain: %d, offset: %d, points: %u\n",
+                  calibration.gain, calibration.offset, calibration.numPoints );
+   return adcSetCalibration( pChannel, &calibration );
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ * @see CALIBRATION
+ */
+static long onIoCtlGetCalibration( ADC_CHANNEL_T* pChannel, unsigned long arg )
+{
+   ADS7924_CALIBRATION_T calibration;
+
+   adcGetCalibration( pChannel, &calibration );
+   if( copy_to_user( (void*)arg, &calibration, sizeof( ADS7924_CALIBRATION_T ) ) != 0 )
+   {
+      ERROR_MESSAGE( ": copy_to_user() failed!\n" );
+      return -EFAULT;
+   }
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ * @see ADS7924_SAMPLE_T
+ */
+static long onIoctlSetReadmodeSample( ADC_CHANNEL_T* pChannel, unsigned long arg )
+{
+   DEBUG_MESSAGE( "\n" );
+   return setOutputFormat( pChannel, OUT_SAMPLE );
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ * @see ADS7924_SAMPLE_T
+ */
+static long onIoCtlGetSample( ADC_CHANNEL_T* pChannel, unsigned long arg )
+{
+   ADS7924_SAMPLE_T sample;
+   int ret;
+
+   if( (pChannel->freshRead != ADS7924_FRESH_READ_OFF) || (pChannel->maxAge != 0) )
+   {
+      ret = provideFreshValue( pChannel );
+      if( ret < 0 )
+         return ret;
+   }
+   else if( !pChannel->result.isValid && (adcCoalescedRead( pChannel ) < 0) )
+   {
+      ERROR_MESSAGE( ": Unable to read analog channel %d\n", pChannel->cannelNumber );
+      return -EIO;
+   }
+
+   getSample( pChannel, &sample );
+   if( copy_to_user( (void*)arg, &sample, sizeof( ADS7924_SAMPLE_T ) ) != 0 )
+   {
+      ERROR_MESSAGE( ": copy_to_user() failed!\n" );
+      return -EFAULT;
+   }
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ * @see ADS7924_IOCTL_SET_FRESH_READ
+ */
+static long onIoCtlSetFreshRead( ADC_CHANNEL_T* pChannel, unsigned long arg )
+{
+   DEBUG_MESSAGE( ": Fresh read of channel %d: %d\n", pChannel->cannelNumber, (int)arg );
+   if( arg > ADS7924_FRESH_READ_NEXT_SCAN )
+   {
+      ERROR_MESSAGE( ": Unknown read policy %ld\n", (long)arg );
+      return -EINVAL;
+   }
+   pChannel->freshRead = arg;
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ * @see ADS7924_IOCTL_SET_MAX_AGE
+ */
+static long onIoCtlSetMaxAge( ADC_CHANNEL_T* pChannel, unsigned long arg )
+{
+   DEBUG_MESSAGE( ": Maximum age of channel %d: %lu us\n", pChannel->cannelNumber, arg );
+   if( arg > U32_MAX )
+   {
+      ERROR_MESSAGE( ": Maximum age %lu us out of range\n", arg );
+      return -EINVAL;
+   }
+   WRITE_ONCE( pChannel->maxAge, arg );
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ * @see CAPTURE
+ */
+static long onIoCtlSetCapture( ADC_CHANNEL_T* pChannel, unsigned long arg )
+{
+   ADS7924_CAPTURE_T capture;
+
+   if( copy_from_user( &capture, (void*)arg, sizeof( ADS7924_CAPTURE_T ) ) != 0 )
+   {
+      ERROR_MESSAGE( ": copy_from_user() failed!\n" );
+      return -EFAULT;
+   }
+   return adcSetCapture( pChannel, &capture );
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ * @see ADS7924_WAKEUP_T
+ */
+static long onIoCtlSetWakeup( ADC_CHANNEL_T* pChannel, unsigned long arg )
+{
+   ADS7924_WAKEUP_T wakeup;
+
+   if( copy_from_user( &wakeup, (void*)arg, sizeof( ADS7924_WAKEUP_T ) ) != 0 )
+   {
+      ERROR_MESSAGE( ": copy_from_user() failed!\n" );
+      return -EFAULT;
+   }
+   return adcSetWakeup( pChannel, &wakeup );
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ * @see PIPELINE
+ */
+static long onIoCtlSetPipeline( ADC_CHANNEL_T* pChannel, unsigned long arg )
+{
+   ADS7924_PIPELINE_T pipeline;
+
+   if( copy_from_user( &pipeline, (void*)arg, sizeof( ADS7924_PIPELINE_T ) ) != 0 )
+   {
+      ERROR_MESSAGE( ": copy_from_user() failed!\n" );
+      return -EFAULT;
+   }
+   return adcSetPipeline( pChannel, &pipeline );
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ * @see PIPELINE
+ */
+static long onIoCtlGetPipeline( ADC_CHANNEL_T* pChannel, unsigned long arg )
+{
+   ADS7924_PIPELINE_T pipeline;
+
+   adcGetPipeline( pChannel, &pipeline );
+   if( copy_to_user( (void*)arg, &pipeline, sizeof( ADS7924_PIPELINE_T ) ) != 0 )
+   {
+      ERROR_MESSAGE( ": copy_to_user() failed!\n" );
+      return -EFAULT;
+   }
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ * @see PIPELINE
+ */
+static long onIoCtlGetPipelineStats( ADC_CHANNEL_T* pChannel, unsigned long arg )
+{
+   ADS7924_PIPELINE_STATS_T stats;
+
+   adcGetPipelineStats( pChannel, &stats );
+   if( copy_to_user( (void*)arg, &stats, sizeof( ADS7924_PIPELINE_STATS_T ) ) != 0 )
+   {
+      ERROR_MESSAGE( ": copy_to_user() failed!\n" );
+      return -EFAULT;
+   }
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ */
+static long onIoCtlSetUlr( ADC_CHANNEL_T* pChannel, unsigned long arg )
+{
+   DEBUG_MESSAGE( ": 0x%02X\n", (int)arg );
+   if( adcWriteUpperLimitThreshold( pChannel, arg ) < 0 )
+   {
+      ERROR_MESSAGE( ": adcWriteUpperLimitThreshold() failed!\n" );
+      return -EIO;
+   }
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ */
+static long onIoCtlSetLlr( ADC_CHANNEL_T* pChannel, unsigned long arg )
+{
+   DEBUG_MESSAGE( ": 0x%02X\n", (int)arg );
+   if( adcWriteLowerLimitThreshold( pChannel, arg ) < 0 )
+   {
+      ERROR_MESSAGE( ": adcWriteLowerLimitThreshold() failed!\n" );
+      return -EIO;
+   }
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ */
+static long onIoCtlGetUlr( ADC_CHANNEL_T* pChannel, unsigned long arg )
+{
+   u8 threshold;
+
+   if( adcReadUpperLimitThreshold( pChannel, &threshold ) < 0 )
+   {
+      ERROR_MESSAGE( ": adcReadUpperLimitThreshold() failed!\n" );
+      return -EIO;
+   }
+   DEBUG_MESSAGE( ": Reading ULR%d: 0x%02X\n", pChannel->cannelNumber, threshold );
+   if( put_user( threshold, (u8*)arg ) < 0 )
+   {
+      ERROR_MESSAGE( ": put_user() failed!\n" );
+      return -EFAULT;
+   }
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ */
+static long onIoCtlGetLlr( ADC_CHANNEL_T* pChannel, unsigned long arg )
+{
+   u8 threshold;
+
+   if( adcReadLowerLimitThreshold( pChannel, &threshold ) < 0 )
+   {
+      ERROR_MESSAGE( ": adcReadLowerLimitThreshold() failed!\n" );
+      return -EIO;
+   }
+   DEBUG_MESSAGE( ": Reading LLR%d: 0x%02X\n", pChannel->cannelNumber, threshold );
+   if( put_user( threshold, (u8*)arg ) < 0 )
+   {
+      ERROR_MESSAGE( ": put_user() failed!\n" );
+      return -EFAULT;
+   }
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ */
+static long onIoCtlAlarmEnable( ADC_CHANNEL_T* pChannel, unsigned long arg )
+{
+   if( adcAlarmEnable( pChannel ) < 0 )
+   {
+      ERROR_MESSAGE( ": adcAlarmEnable() failed!\n" );
+      return -EIO;
+   }
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ */
+static long onIoCtlAlarmDisable( ADC_CHANNEL_T* pChannel, unsigned long arg )
+{
+   if( adcAlarmDisable( pChannel ) < 0 )
+   {
+      ERROR_MESSAGE( ": adcAlarmDisable() failed!\n" );
+      return -EIO;
+   }
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ * @brief Initializer list of function table for channel specific ioctl().
+ *
+ * Alternative to switch-case statements, which would be very large
+ * and very confusing.
+ *
+ * @see IOC_CHANNEL_INFO_T
+ * @see onChannelIoctrl
+ */
+const IOC_CHANNEL_INFO_T mg_fTabIoctrlChannel[] =
+{
+   IOCTL_ITEM( ADS7924_IOCTL_READMODE_BIN,  onIoctlSetReadmodeBin ),
+   IOCTL_ITEM( ADS7924_IOCTL_READMODE_DEC,  onIoctlSetReadmodeDec ),
+   IOCTL_ITEM( ADS7924_IOCTL_READMODE_HEX,  onIoctlSetReadmodeHex ),
+   IOCTL_ITEM( ADS7924_IOCTL_SET_ULR,       onIoCtlSetUlr ),
+   IOCTL_ITEM( ADS7924_IOCTL_SET_LLR,       onIoCtlSetLlr ),
+   IOCTL_ITEM( ADS7924_IOCTL_GET_ULR,       onIoCtlGetUlr ),
+   IOCTL_ITEM( ADS7924_IOCTL_GET_LLR,       onIoCtlGetLlr ),
+   IOCTL_ITEM( ADS7924_IOCTL_ALARM_ENABLE,  onIoCtlAlarmEnable ),
+   IOCTL_ITEM( ADS7924_IOCTL_ALARM_DISABLE, onIoCtlAlarmDisable ),
+   IOCTL_ITEM( ADS7924_IOCTL_READMODE_SCALED, onIoctlSetReadmodeScaled ),
+   IOCTL_ITEM( ADS7924_IOCTL_SET_CALIBRATION, onIoCtlSetCalibration ),
+   IOCTL_ITEM( ADS7924_IOCTL_GET_CALIBRATION, onIoCtlGetCalibration ),
+   IOCTL_ITEM( ADS7924_IOCTL_READMODE_SAMPLE, onIoctlSetReadmodeSample ),
+   IOCTL_ITEM( ADS7924_IOCTL_GET_SAMPLE,      onIoCtlGetSample ),
+   IOCTL_ITEM( ADS7924_IOCTL_SET_FRESH_READ,  onIoCtlSetFreshRead ),
+   IOCTL_ITEM( ADS7924_IOCTL_SET_MAX_AGE,     onIoCtlSetMaxAge    ),
+   IOCTL_ITEM( ADS7924_IOCTL_SET_CAPTURE,     onIoCtlSetCapture ),
+   IOCTL_ITEM( ADS7924_IOCTL_SET_PIPELINE,    onIoCtlSetPipeline ),
+   IOCTL_ITEM( ADS7924_IOCTL_GET_PIPELINE,    onIoCtlGetPipeline ),
+   IOCTL_ITEM( ADS7924_IOCTL_GET_PIPELINE_STATS, onIoCtlGetPipelineStats ),
+   IOCTL_ITEM( ADS7924_IOCTL_SET_WAKEUP,      onIoCtlSetWakeup ),
+   IOCTL_LIST_END
+};
+
+/*!-----------------------------------------------------------------------------
+ * @ingroup IOCTL_CHANNEL
+ * @brief Callback function becomes invoked by the function ioctrl() from the
+ *        user-space.
+ */
+static long onChannelIoctrl( struct file* pInstance,
+                            unsigned int cmd,
+                            unsigned long arg )
+{
+   int ret = 0;
+   const IOC_CHANNEL_INFO_T* pCurrentItem;
+
+   DEBUG_MESSAGE( ": cmd = %d arg = %08lX\n", cmd, arg );
+   DEBUG_ACCESSMODE( pInstance );
+   BUG_ON( pInstance->private_data == NULL );
+   DEBUG_MESSAGE( "   Minor: %d\n", getChannelFromInstance(pInstance)->minor );
+   DEBUG_MESSAGE( "   Channel number: %d\n", getChannelFromInstance(pInstance)->cannelNumber );
+   DEBUG_MESSAGE( "   Open-counter: %d\n",
+                   atomic_read( &(getChannelFromInstance(pInstance)->openCounter) ));
 
-   pChannel = getChannelFromInstance( pInstance );
-   BUG_ON( pChannel == NULL );
+   for( pCurrentItem = mg_fTabIoctrlChannel; pCurrentItem->function != NULL; pCurrentItem++ )
+   {
+      if( pCurrentItem->number != cmd )
+         continue;
+      DEBUG_MESSAGE( ": execute ioctl-command: %s\n", pCurrentItem->name );
+      ret = pCurrentItem->function( getChannelFromInstance(pInstance), arg );
+      if( ret < 0 )
+         ERROR_MESSAGE( ": executing of ioctl-command %s failed!\n",
+                        pCurrentItem->name );
+      return ret;
+   }
 
-   DEBUG_MESSAGE( ": Minor: %d\n", pChannel->minor );
-   DEBUG_MESSAGE( ": Open-counter: %d\n", atomic_read( &pChannel->openCounter ));
-   DEBUG_MESSAGE( ": *** Channel number = %d ***\n", pChannel->cannelNumber );
+   ERROR_MESSAGE( ": Unknown ioctl-command: 0x%08X\n", cmd );
+   return -EINVAL;
+}
+
+/* ioctrl call back functions for single channel access END ******************/
+
+/* Call-back functions for single analog channel end *************************/
+
+/* Call-back functions for the group device begin ****************************/
+/*!----------------------------------------------------------------------------
+ * @see onOpen
+ */
+static inline GROUP_T* getGroupFromInstance( struct file* pInstance )
+{
+   BUG_ON( pInstance->private_data == NULL );
+   return (GROUP_T*)pInstance->private_data;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see GROUP
+ */
+static int onGroupOpen( struct inode* pInode, struct file* pInstance )
+{
+   GROUP_T* pGroup = getGroupFromInstance( pInstance );
+
+   atomic_inc( &pGroup->openCounter );
+   DEBUG_MESSAGE( ": Open-counter: %d\n", atomic_read( &pGroup->openCounter ) );
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief The acquisition of the group continues after closing, it becomes
+ *        stopped by ADS7924_IOCTL_GROUP_STOP only.
+ * @see GROUP
+ */
+static int onGroupClose( struct inode *pInode, struct file* pInstance )
+{
+   GROUP_T* pGroup = getGroupFromInstance( pInstance );
+
+   atomic_dec( &pGroup->openCounter );
+   DEBUG_MESSAGE( ": Open-counter: %d\n", atomic_read( &pGroup->openCounter ) );
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Copies whole frames of type ADS7924_FRAME_T to the user-space.
+ *
+ * Blocks until at least one frame is present, unless O_NONBLOCK is set.
+ * Returns 0 when the group isn't running and the FIFO is empty.
+ * @see GROUP
+ */
+static ssize_t onGroupRead( struct file* pInstance, /*!< @see include/linux/fs.h   */
+                            char __user* pBuffer,   /*!< buffer to fill with data */
+                            size_t len,             /*!< length of the buffer     */
+                            loff_t* pOffset )
+{
+   GROUP_T* pGroup = getGroupFromInstance( pInstance );
+   ADS7924_FRAME_T frame;
+   size_t done = 0;
+
+   DEBUG_MESSAGE( ": len = %ld, offset = %lld\n", (long int)len, *pOffset );
+   if( len < sizeof( ADS7924_FRAME_T ) )
+      return -EINVAL;
 
-   if( pChannel->waitQueue.waiting && ((pInstance->f_flags & O_NONBLOCK) != 0) )
+   if( adcGroupFifoLevel( pGroup ) == 0 )
    {
-      DEBUG_MESSAGE( ": No new analog data present.\n" );
-      return -EAGAIN;
+      if( !pGroup->running )
+         return 0;
+      if( (pInstance->f_flags & O_NONBLOCK) != 0 )
+         return -EAGAIN;
+      if( wait_event_interruptible( pGroup->oWaitQueue,
+                                    (adcGroupFifoLevel( pGroup ) != 0) ||
+                                    !pGroup->running ) )
+      {
+         DEBUG_MESSAGE( ": Signal occurred.\n" );
+         return -ERESTARTSYS;
+      }
    }
-   if( sleepChannelIfNecessary( pChannel ) )
+
+   while( ((len - done) >= sizeof( ADS7924_FRAME_T )) &&
+          (adcPopFrames( pGroup, &frame, 1 ) != 0) )
    {
-      DEBUG_MESSAGE( ": Signal occurred.\n" );
-      return -ERESTARTSYS;
+      if( copy_to_user( pBuffer + done, &frame, sizeof( ADS7924_FRAME_T ) ) != 0 )
+      {
+         ERROR_MESSAGE( "copy_to_user: %ld bytes\n", (long int)sizeof( ADS7924_FRAME_T ) );
+         return -EFAULT;
+      }
+      done += sizeof( ADS7924_FRAME_T );
    }
+   return done;
+}
 
-   mutex_lock( &pChannel->oMutex );
-   n = _onChannelRead( pChannel, pBuffer, len, pOffset );
-   mutex_unlock( &pChannel->oMutex );
+/*!----------------------------------------------------------------------------
+ * @brief The group device has nothing to write.
+ */
+static ssize_t onGroupWrite( struct file *pInstance,
+                             const char __user* pBuffer,
+                             size_t len,
+                             loff_t* pOffset )
+{
+   DEBUG_MESSAGE( ": len = %ld, offset = %lld\n", (long int)len, *pOffset );
+   return -EINVAL;
+}
 
-   DEBUG_MESSAGE( ": Return %d\n", n );
-   return n;
+/*!----------------------------------------------------------------------------
+ * @see GROUP
+ */
+static unsigned int onGroupPoll( struct file* pInstance, poll_table* pPollTable )
+{
+   GROUP_T* pGroup = getGroupFromInstance( pInstance );
+
+   poll_wait( pInstance, &pGroup->oWaitQueue, pPollTable );
+   if( adcGroupFifoLevel( pGroup ) != 0 )
+      return (POLLIN | POLLRDNORM);
+   return pGroup->running? 0 : POLLHUP;
 }
 
+/* ioctrl call back functions for the group device BEGIN *********************/
 /*!----------------------------------------------------------------------------
- * @brief Callback function becomes invoked by the function write() from the
- *        user-space.
- *
- * At the moment this function will not really used it is a dummy.
+ * @ingroup IOCTL_GROUP
  */
-static ssize_t onChannelWrite( struct file *pInstance,
-                               const char __user* pBuffer,
-                               size_t len,
-                               loff_t* pOffset )
+static long onIoCtlGroupSetMembers( GROUP_T* pGroup, unsigned long arg )
 {
-#ifdef CONFIG_DEBUG_ADS7924
-   ADC_CHANNEL_T* pChannel = getChannelFromInstance( pInstance );
-#endif
+   ADS7924_GROUP_T config;
 
-   DEBUG_MESSAGE( ": len = %ld, offset = %lld\n", (long int)len, *pOffset );
-   DEBUG_ACCESSMODE( pInstance );
-   BUG_ON( pInstance->private_data == NULL );
+   if( copy_from_user( &config, (void*)arg, sizeof( ADS7924_GROUP_T ) ) != 0 )
+   {
+      ERROR_MESSAGE( ": copy_from_user() failed!\n" );
+      return -EFAULT;
+   }
+   return adcSetGroupMembers( pGroup, &config );
+}
 
-   DEBUG_MESSAGE( "   Minor: %d\n", pChannel->minor );
-   DEBUG_MESSAGE( "   Open-counter: %d\n",
-                   atomic_read( &pChannel->openCounter ));
-   DEBUG_MESSAGE( "Channel number = %d\n", pChannel->cannelNumber );
-   DEBUG_MESSAGE( "   Received: \"%s\"\n", pBuffer );
-   return len;
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_GROUP
+ */
+static long onIoCtlGroupStart( GROUP_T* pGroup, unsigned long arg )
+{
+   return adcStartGroup( pGroup );
 }
 
 /*!----------------------------------------------------------------------------
- * @brief Callback function becomes invoked by the function select() from the
- *        user-space.
+ * @ingroup IOCTL_GROUP
  */
-static unsigned int onChannelPoll( struct file* pInstance, poll_table* pPollTable )
+static long onIoCtlGroupStop( GROUP_T* pGroup, unsigned long arg )
 {
-   ADC_CHANNEL_T* pChannel = getChannelFromInstance( pInstance );
-#ifdef _DEBUG_POLL
-   DEBUG_MESSAGE( ": Channel number: %d\n", pChannel->cannelNumber );
-#endif
-   poll_wait( pInstance, &pChannel->waitQueue.queue, pPollTable );
-   if( isAwoken( &pChannel->waitQueue ) )
+   return adcStopGroup( pGroup );
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_GROUP
+ */
+static long onIoCtlGroupGetStats( GROUP_T* pGroup, unsigned long arg )
+{
+   ADS7924_GROUP_STATS_T stats;
+
+   adcGetGroupStats( pGroup, &stats );
+   if( copy_to_user( (void*)arg, &stats, sizeof( ADS7924_GROUP_STATS_T ) ) != 0 )
    {
-   #ifdef _DEBUG_POLL
-      DEBUG_MESSAGE( ": Return != 0\n" );
-   #endif
-      return (POLLIN | POLLRDNORM);
+      ERROR_MESSAGE( ": copy_to_user() failed!\n" );
+      return -EFAULT;
    }
    return 0;
 }
 
-/* ioctrl call back functions for single channel access BEGIN ****************/
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_GROUP
+ * @brief Initializer list of function table for ioctl() of the group device.
+ * @see onGroupIoctrl
+ * @see IOC_GROUP_INFO_T
+ */
+const IOC_GROUP_INFO_T mg_fTabIoctrlGroup[] =
+{
+   IOCTL_ITEM( ADS7924_IOCTL_GROUP_SET_MEMBERS, onIoCtlGroupSetMembers ),
+   IOCTL_ITEM( ADS7924_IOCTL_GROUP_START,       onIoCtlGroupStart ),
+   IOCTL_ITEM( ADS7924_IOCTL_GROUP_STOP,        onIoCtlGroupStop ),
+   IOCTL_ITEM( ADS7924_IOCTL_GROUP_GET_STATS,   onIoCtlGroupGetStats ),
+   IOCTL_LIST_END
+};
 
 /*!----------------------------------------------------------------------------
- * @ingroup IOCTL_CHANNEL
- * @see onIoctlSetReadmodeBin
- * @see onIoctlSetReadmodeDec
- * @see onIoctlSetReadmodeHex
+ * @ingroup IOCTL_GROUP
  */
-static long setOutputFormat( ADC_CHANNEL_T* pChannel, OUTPUT_FORMAT_T outFormat )
+static long onGroupIoctrl( struct file* pInstance,
+                           unsigned int cmd,
+                           unsigned long arg )
 {
-   if( atomic_read( &pChannel->openCounter ) > 1 )
+   int ret = 0;
+   const IOC_GROUP_INFO_T* pCurrentItem;
+
+   DEBUG_MESSAGE( ": cmd = %d arg = %08lX\n", cmd, arg );
+   BUG_ON( pInstance->private_data == NULL );
+
+   for( pCurrentItem = mg_fTabIoctrlGroup; pCurrentItem->function != NULL; pCurrentItem++ )
    {
-      ERROR_MESSAGE( ": Operation only for one opened instance permitted!\n" );
-      return -EMFILE;
+      if( pCurrentItem->number != cmd )
+         continue;
+      DEBUG_MESSAGE( ": execute ioctl-command: %s\n", pCurrentItem->name );
+      ret = pCurrentItem->function( getGroupFromInstance( pInstance ), arg );
+      if( ret < 0 )
+         ERROR_MESSAGE( ": executing of ioctl-command %s failed!\n",
+                        pCurrentItem->name );
+      return ret;
    }
-   pChannel->outputFormat = outFormat;
+
+   ERROR_MESSAGE( ": Unknown ioctl-command: 0x%08X\n", cmd );
+   return -EINVAL;
+}
+/* ioctrl call back functions for the group device END ***********************/
+/* Call-back functions for the group device end ******************************/
+
+/* Call-back functions for the aggregate device begin ************************/
+/*!----------------------------------------------------------------------------
+ * @see onOpen
+ */
+static inline MERGE_T* getMergeFromInstance( struct file* pInstance )
+{
+   BUG_ON( pInstance->private_data == NULL );
+   return (MERGE_T*)pInstance->private_data;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see MERGE
+ */
+static int onMergeOpen( struct inode* pInode, struct file* pInstance )
+{
+   MERGE_T* pMerge = getMergeFromInstance( pInstance );
+
+   atomic_inc( &pMerge->openCounter );
+   DEBUG_MESSAGE( ": Open-counter: %d\n", atomic_read( &pMerge->openCounter ) );
    return 0;
 }
 
 /*!----------------------------------------------------------------------------
- * @ingroup IOCTL_CHANNEL
+ * @brief Closing of the last file descriptor clears the subscription,
+ *        so the channels doesn't fill queues which nobody reads.
+ * @see MERGE
  */
-static long onIoctlSetReadmodeBin( ADC_CHANNEL_T* pChannel, unsigned long arg )
+static int onMergeClose( struct inode *pInode, struct file* pInstance )
 {
-   DEBUG_MESSAGE( "\n" );
-   return setOutputFormat( pChannel, OUT_BIN );
+   MERGE_T* pMerge = getMergeFromInstance( pInstance );
+
+   if( atomic_dec_and_test( &pMerge->openCounter ) )
+      adcSetSubscription( pMerge, NULL );
+   DEBUG_MESSAGE( ": Open-counter: %d\n", atomic_read( &pMerge->openCounter ) );
+   return 0;
 }
 
 /*!----------------------------------------------------------------------------
- * @ingroup IOCTL_CHANNEL
+ * @brief Copies whole records of type ADS7924_RECORD_T in the order of
+ *        their timestamps to the user-space.
+ *
+ * Blocks until at least one record is released, unless O_NONBLOCK is set.
+ * Returns 0 when no channel is subscribed.
+ * @see MERGE
  */
-static long onIoctlSetReadmodeDec( ADC_CHANNEL_T* pChannel, unsigned long arg )
+static ssize_t onMergeRead( struct file* pInstance, /*!< @see include/linux/fs.h   */
+                            char __user* pBuffer,   /*!< buffer to fill with data */
+                            size_t len,             /*!< length of the buffer     */
+                            loff_t* pOffset )
 {
-   DEBUG_MESSAGE( "\n" );
-   return setOutputFormat( pChannel, OUT_DEC );
+   MERGE_T* pMerge = getMergeFromInstance( pInstance );
+   ADS7924_RECORD_T aRecord[STREAM_READ_BATCH];
+   size_t done = 0;
+   unsigned int level;
+   unsigned int n;
+
+   DEBUG_MESSAGE( ": len = %ld, offset = %lld\n", (long int)len, *pOffset );
+   if( len < sizeof( ADS7924_RECORD_T ) )
+      return -EINVAL;
+
+   if( adcMergeLevel( pMerge ) == 0 )
+   {
+      if( !adcHasSubscription( pMerge ) )
+         return 0;
+      if( (pInstance->f_flags & O_NONBLOCK) != 0 )
+         return -EAGAIN;
+      if( wait_event_interruptible( pMerge->oWaitQueue,
+                                    (adcMergeLevel( pMerge ) != 0) ||
+                                    !adcHasSubscription( pMerge ) ) )
+      {
+         DEBUG_MESSAGE( ": Signal occurred.\n" );
+         return -ERESTARTSYS;
+      }
+   }
+
+   while( (len - done) >= sizeof( ADS7924_RECORD_T ) )
+   {
+      level = adcMergeLevel( pMerge );
+      n = adcPopMerged( pMerge, aRecord,
+                        min_t( size_t, STREAM_READ_BATCH,
+                               (len - done) / sizeof( ADS7924_RECORD_T ) ) );
+      if( n == 0 )
+      {
+         if( (done != 0) || !adcHasSubscription( pMerge ) )
+            break;
+         if( (pInstance->f_flags & O_NONBLOCK) != 0 )
+            return -EAGAIN;
+         /*
+          * The queued records are held back by the watermark, a new record
+          * or the expiry of the hold back time can release them.
+          */
+         if( wait_event_interruptible_timeout( pMerge->oWaitQueue,
+                                               (adcMergeLevel( pMerge ) != level) ||
+                                               !adcHasSubscription( pMerge ),
+                                               msecs_to_jiffies( CONFIG_ADS7924_MERGE_HOLD_BACK_MS ) + 1 ) < 0 )
+         {
+            DEBUG_MESSAGE( ": Signal occurred.\n" );
+            return -ERESTARTSYS;
+         }
+         continue;
+      }
+      if( copy_to_user( pBuffer + done, aRecord, n * sizeof( ADS7924_RECORD_T ) ) != 0 )
+      {
+         ERROR_MESSAGE( "copy_to_user: %ld bytes\n", (long int)(n * sizeof( ADS7924_RECORD_T )) );
+         return -EFAULT;
+      }
+      done += n * sizeof( ADS7924_RECORD_T );
+   }
+   return done;
 }
 
 /*!----------------------------------------------------------------------------
- * @ingroup IOCTL_CHANNEL
+ * @brief The aggregate device has nothing to write.
  */
-static long onIoctlSetReadmodeHex( ADC_CHANNEL_T* pChannel, unsigned long arg )
+static ssize_t onMergeWrite( struct file *pInstance,
+                             const char __user* pBuffer,
+                             size_t len,
+                             loff_t* pOffset )
 {
-   DEBUG_MESSAGE( "\n" );
-   return setOutputFormat( pChannel, OUT_HEX );
+   DEBUG_MESSAGE( ": len = %ld, offset = %lld\n", (long int)len, *pOffset );
+   return -EINVAL;
 }
 
 /*!----------------------------------------------------------------------------
- * @ingroup IOCTL_CHANNEL
+ * @see MERGE
  */
-static long onIoCtlSetUlr( ADC_CHANNEL_T* pChannel, unsigned long arg )
+static unsigned int onMergePoll( struct file* pInstance, poll_table* pPollTable )
 {
-   DEBUG_MESSAGE( ": 0x%02X\n", (int)arg );
-   if( adcWriteUpperLimitThreshold( pChannel, arg ) < 0 )
+   MERGE_T* pMerge = getMergeFromInstance( pInstance );
+
+   poll_wait( pInstance, &pMerge->oWaitQueue, pPollTable );
+   return adcMergeReady( pMerge )? (POLLIN | POLLRDNORM) : 0;
+}
+
+/* ioctrl call back functions for the aggregate device BEGIN *****************/
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_MERGE
+ */
+static long onIoCtlMergeSetSubscription( MERGE_T* pMerge, unsigned long arg )
+{
+   ADS7924_SUBSCRIPTION_T subscription;
+   DECLARE_BITMAP( mask, ADS7924_MERGE_MAX_MINORS );
+   unsigned int minor;
+
+   if( copy_from_user( &subscription, (void*)arg, sizeof( subscription ) ) != 0 )
    {
-      ERROR_MESSAGE( ": adcWriteUpperLimitThreshold() failed!\n" );
-      return -EIO;
+      ERROR_MESSAGE( ": copy_from_user() failed!\n" );
+      return -EFAULT;
+   }
+   bitmap_zero( mask, ADS7924_MERGE_MAX_MINORS );
+   for( minor = 0; minor < ADS7924_MERGE_MAX_MINORS; minor++ )
+   {
+      if( (subscription.aMask[minor / 64] & BIT_ULL( minor % 64 )) != 0 )
+         __set_bit( minor, mask );
+   }
+   return adcSetSubscription( pMerge, mask );
+}
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_MERGE
+ */
+static long onIoCtlMergeGetSubscription( MERGE_T* pMerge, unsigned long arg )
+{
+   ADS7924_SUBSCRIPTION_T subscription;
+   unsigned int minor;
+
+   memset( &subscription, 0, sizeof( subscription ) );
+   for( minor = 0; minor < ADS7924_MERGE_MAX_MINORS; minor++ )
+   {
+      if( test_bit( minor, pMerge->mask ) )
+         subscription.aMask[minor / 64] |= BIT_ULL( minor % 64 );
+   }
+   if( copy_to_user( (void*)arg, &subscription, sizeof( subscription ) ) != 0 )
+   {
+      ERROR_MESSAGE( ": copy_to_user() failed!\n" );
+      return -EFAULT;
    }
    return 0;
 }
 
 /*!----------------------------------------------------------------------------
- * @ingroup IOCTL_CHANNEL
+ * @ingroup IOCTL_MERGE
+ * @brief Initializer list of function table for ioctl() of the aggregate
+ *        device.
+ * @see onMergeIoctrl
+ * @see IOC_MERGE_INFO_T
  */
-static long onIoCtlSetLlr( ADC_CHANNEL_T* pChannel, unsigned long arg )
+const IOC_MERGE_INFO_T mg_fTabIoctrlMerge[] =
 {
-   DEBUG_MESSAGE( ": 0x%02X\n", (int)arg );
-   if( adcWriteLowerLimitThreshold( pChannel, arg ) < 0 )
+   IOCTL_ITEM( ADS7924_IOCTL_MERGE_SET_SUBSCRIPTION, onIoCtlMergeSetSubscription ),
+   IOCTL_ITEM( ADS7924_IOCTL_MERGE_GET_SUBSCRIPTION, onIoCtlMergeGetSubscription ),
+   IOCTL_LIST_END
+};
+
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_MERGE
+ */
+static long onMergeIoctrl( struct file* pInstance,
+                           unsigned int cmd,
+                           unsigned long arg )
+{
+   int ret = 0;
+   const IOC_MERGE_INFO_T* pCurrentItem;
+
+   DEBUG_MESSAGE( ": cmd = %d arg = %08lX\n", cmd, arg );
+   BUG_ON( pInstance->private_data == NULL );
+
+   for( pCurrentItem = mg_fTabIoctrlMerge; pCurrentItem->function != NULL; pCurrentItem++ )
    {
-      ERROR_MESSAGE( ": adcWriteLowerLimitThreshold() failed!\n" );
-      return -EIO;
+      if( pCurrentItem->number != cmd )
+         continue;
+      DEBUG_MESSAGE( ": execute ioctl-command: %s\n", pCurrentItem->name );
+      ret = pCurrentItem->function( getMergeFromInstance( pInstance ), arg );
+      if( ret < 0 )
+         ERROR_MESSAGE( ": executing of ioctl-command %s failed!\n",
+                        pCurrentItem->name );
+      return ret;
    }
+
+   ERROR_MESSAGE( ": Unknown ioctl-command: 0x%08X\n", cmd );
+   return -EINVAL;
+}
+/* ioctrl call back functions for the aggregate device END *******************/
+/* Call-back functions for the aggregate device end **************************/
+
+/* Call-back functions for the virtual channels begin ************************/
+/*!----------------------------------------------------------------------------
+ * @see onOpen
+ */
+static inline VIRTUAL_CHANNEL_T* getVirtualFromInstance( struct file* pInstance )
+{
+   BUG_ON( pInstance->private_data == NULL );
+   return (VIRTUAL_CHANNEL_T*)pInstance->private_data;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see VIRTUAL
+ */
+static int onVirtualOpen( struct inode* pInode, struct file* pInstance )
+{
+   VIRTUAL_CHANNEL_T* pVirtual = getVirtualFromInstance( pInstance );
+
+   atomic_inc( &pVirtual->openCounter );
+   DEBUG_MESSAGE( ": Open-counter: %d\n", atomic_read( &pVirtual->openCounter ) );
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see VIRTUAL
+ */
+static int onVirtualClose( struct inode *pInode, struct file* pInstance )
+{
+   VIRTUAL_CHANNEL_T* pVirtual = getVirtualFromInstance( pInstance );
+
+   atomic_dec( &pVirtual->openCounter );
+   DEBUG_MESSAGE( ": Open-counter: %d\n", atomic_read( &pVirtual->openCounter ) );
    return 0;
 }
 
 /*!----------------------------------------------------------------------------
- * @ingroup IOCTL_CHANNEL
+ * @brief Reads one value of the virtual channel as decimal text like
+ *        the channel devices in the default output format.
+ *
+ * The binary value including timestamp is available by
+ * ADS7924_IOCTL_VIRTUAL_GET_SAMPLE.
+ * @see VIRTUAL
+ */
+static ssize_t onVirtualRead( struct file* pInstance, /*!< @see include/linux/fs.h   */
+                              char __user* pBuffer,   /*!< buffer to fill with data */
+                              size_t len,             /*!< length of the buffer     */
+                              loff_t* pOffset )
+{
+   VIRTUAL_CHANNEL_T* pVirtual = getVirtualFromInstance( pInstance );
+   ADS7924_VIRTUAL_SAMPLE_T sample;
+   char textBuffer[16];
+   ssize_t n;
+   int ret;
+
+   DEBUG_MESSAGE( ": len = %ld, offset = %lld\n", (long int)len, *pOffset );
+   if( *pOffset != 0 )
+      return 0;
+
+   ret = adcReadVirtual( pVirtual, &sample, (pInstance->f_flags & O_NONBLOCK) != 0 );
+   if( ret < 0 )
+      return ret;
+
+   n = snprintf( textBuffer, sizeof( textBuffer ), "%d\n", sample.value );
+   if( len < n )
+      return -EINVAL;
+   if( copy_to_user( pBuffer, textBuffer, n ) != 0 )
+   {
+      ERROR_MESSAGE( "copy_to_user: %ld bytes\n", (long int)n );
+      return -EFAULT;
+   }
+   *pOffset += n;
+   return n;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief A virtual channel has nothing to write.
+ */
+static ssize_t onVirtualWrite( struct file *pInstance,
+                               const char __user* pBuffer,
+                               size_t len,
+                               loff_t* pOffset )
+{
+   DEBUG_MESSAGE( ": len = %ld, offset = %lld\n", (long int)len, *pOffset );
+   return -EINVAL;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Outside of ADS7924_STREAM_SCAN a defined virtual channel is
+ *        always readable, because it will read on demand.
+ * @see VIRTUAL
  */
-static long onIoCtlGetUlr( ADC_CHANNEL_T* pChannel, unsigned long arg )
+static unsigned int onVirtualPoll( struct file* pInstance, poll_table* pPollTable )
 {
-   u8 threshold;
+   VIRTUAL_CHANNEL_T* pVirtual = getVirtualFromInstance( pInstance );
 
-   if( adcReadUpperLimitThreshold( pChannel, &threshold ) < 0 )
-   {
-      ERROR_MESSAGE( ": adcReadUpperLimitThreshold() failed!\n" );
-      return -EIO;
-   }
-   DEBUG_MESSAGE( ": Reading ULR%d: 0x%02X\n", pChannel->cannelNumber, threshold );
-   if( put_user( threshold, (u8*)arg ) < 0 )
-   {
-      ERROR_MESSAGE( ": put_user() failed!\n" );
-      return -EFAULT;
-   }
+   poll_wait( pInstance, &pVirtual->oWaitQueue, pPollTable );
+   if( pVirtual->definition.operation == ADS7924_VIRTUAL_OFF )
+      return 0;
+   if( pVirtual->isValid || (pVirtual->pParent->streamMode != ADS7924_STREAM_SCAN) )
+      return POLLIN | POLLRDNORM;
    return 0;
 }
 
+/* ioctrl call back functions for the virtual channels BEGIN *****************/
 /*!----------------------------------------------------------------------------
- * @ingroup IOCTL_CHANNEL
+ * @ingroup IOCTL_VIRTUAL
  */
-static long onIoCtlGetLlr( ADC_CHANNEL_T* pChannel, unsigned long arg )
+static long onIoCtlVirtualSet( VIRTUAL_CHANNEL_T* pVirtual, unsigned long arg )
 {
-   u8 threshold;
+   ADS7924_VIRTUAL_T definition;
+   int ret;
 
-   if( adcReadLowerLimitThreshold( pChannel, &threshold ) < 0 )
-   {
-      ERROR_MESSAGE( ": adcReadLowerLimitThreshold() failed!\n" );
-      return -EIO;
-   }
-   DEBUG_MESSAGE( ": Reading LLR%d: 0x%02X\n", pChannel->cannelNumber, threshold );
-   if( put_user( threshold, (u8*)arg ) < 0 )
+   if( copy_from_user( &definition, (void*)arg, sizeof( definition ) ) != 0 )
    {
-      ERROR_MESSAGE( ": put_user() failed!\n" );
+      ERROR_MESSAGE( ": copy_from_user() failed!\n" );
       return -EFAULT;
    }
-   return 0;
+   ret = adcSetVirtual( pVirtual, &definition );
+   wake_up_interruptible( &pVirtual->oWaitQueue );
+   return ret;
 }
 
 /*!----------------------------------------------------------------------------
- * @ingroup IOCTL_CHANNEL
+ * @ingroup IOCTL_VIRTUAL
  */
-static long onIoCtlAlarmEnable( ADC_CHANNEL_T* pChannel, unsigned long arg )
+static long onIoCtlVirtualGet( VIRTUAL_CHANNEL_T* pVirtual, unsigned long arg )
 {
-   if( adcAlarmEnable( pChannel ) < 0 )
+   ADS7924_VIRTUAL_T definition;
+
+   adcGetVirtual( pVirtual, &definition );
+   if( copy_to_user( (void*)arg, &definition, sizeof( definition ) ) != 0 )
    {
-      ERROR_MESSAGE( ": adcAlarmEnable() failed!\n" );
-      return -EIO;
+      ERROR_MESSAGE( ": copy_to_user() failed!\n" );
+      return -EFAULT;
    }
    return 0;
 }
 
 /*!----------------------------------------------------------------------------
- * @ingroup IOCTL_CHANNEL
+ * @ingroup IOCTL_VIRTUAL
  */
-static long onIoCtlAlarmDisable( ADC_CHANNEL_T* pChannel, unsigned long arg )
+static long onIoCtlVirtualGetSample( VIRTUAL_CHANNEL_T* pVirtual, unsigned long arg )
 {
-   if( adcAlarmDisable( pChannel ) < 0 )
+   ADS7924_VIRTUAL_SAMPLE_T sample;
+   int ret;
+
+   ret = adcReadVirtual( pVirtual, &sample, false );
+   if( ret < 0 )
+      return ret;
+   if( copy_to_user( (void*)arg, &sample, sizeof( sample ) ) != 0 )
    {
-      ERROR_MESSAGE( ": adcAlarmDisable() failed!\n" );
-      return -EIO;
+      ERROR_MESSAGE( ": copy_to_user() failed!\n" );
+      return -EFAULT;
    }
    return 0;
 }
 
 /*!----------------------------------------------------------------------------
- * @ingroup IOCTL_CHANNEL
- * @brief Initializer list of function table for channel specific ioctl().
- *
- * Alternative to switch-case statements, which would be very large
- * and very confusing.
- *
- * @see IOC_CHANNEL_INFO_T
- * @see onChannelIoctrl
+ * @ingroup IOCTL_VIRTUAL
+ * @brief Initializer list of function table for ioctl() of the virtual
+ *        channels.
+ * @see onVirtualIoctrl
+ * @see IOC_VIRTUAL_INFO_T
  */
-const IOC_CHANNEL_INFO_T mg_fTabIoctrlChannel[] =
+const IOC_VIRTUAL_INFO_T mg_fTabIoctrlVirtual[] =
 {
-   IOCTL_ITEM( ADS7924_IOCTL_READMODE_BIN,  onIoctlSetReadmodeBin ),
-   IOCTL_ITEM( ADS7924_IOCTL_READMODE_DEC,  onIoctlSetReadmodeDec ),
-   IOCTL_ITEM( ADS7924_IOCTL_READMODE_HEX,  onIoctlSetReadmodeHex ),
-   IOCTL_ITEM( ADS7924_IOCTL_SET_ULR,       onIoCtlSetUlr ),
-   IOCTL_ITEM( ADS7924_IOCTL_SET_LLR,       onIoCtlSetLlr ),
-   IOCTL_ITEM( ADS7924_IOCTL_GET_ULR,       onIoCtlGetUlr ),
-   IOCTL_ITEM( ADS7924_IOCTL_GET_LLR,       onIoCtlGetLlr ),
-   IOCTL_ITEM( ADS7924_IOCTL_ALARM_ENABLE,  onIoCtlAlarmEnable ),
-   IOCTL_ITEM( ADS7924_IOCTL_ALARM_DISABLE, onIoCtlAlarmDisable ),
+   IOCTL_ITEM( ADS7924_IOCTL_VIRTUAL_SET,        onIoCtlVirtualSet       ),
+   IOCTL_ITEM( ADS7924_IOCTL_VIRTUAL_GET,        onIoCtlVirtualGet       ),
+   IOCTL_ITEM( ADS7924_IOCTL_VIRTUAL_GET_SAMPLE, onIoCtlVirtualGetSample ),
    IOCTL_LIST_END
 };
 
-/*!-----------------------------------------------------------------------------
- * @ingroup IOCTL_CHANNEL
- * @brief Callback function becomes invoked by the function ioctrl() from the
- *        user-space.
+/*!----------------------------------------------------------------------------
+ * @ingroup IOCTL_VIRTUAL
  */
-static long onChannelIoctrl( struct file* pInstance,
-                            unsigned int cmd,
-                            unsigned long arg )
+static long onVirtualIoctrl( struct file* pInstance,
+                             unsigned int cmd,
+                             unsigned long arg )
 {
    int ret = 0;
-   const IOC_CHANNEL_INFO_T* pCurrentItem;
+   const IOC_VIRTUAL_INFO_T* pCurrentItem;
 
    DEBUG_MESSAGE( ": cmd = %d arg = %08lX\n", cmd, arg );
-   DEBUG_ACCESSMODE( pInstance );
    BUG_ON( pInstance->private_data == NULL );
-   DEBUG_MESSAGE( "   Minor: %d\n", getChannelFromInstance(pInstance)->minor );
-   DEBUG_MESSAGE( "   Channel number: %d\n", getChannelFromInstance(pInstance)->cannelNumber );
-   DEBUG_MESSAGE( "   Open-counter: %d\n",
-                   atomic_read( &(getChannelFromInstance(pInstance)->openCounter) ));
 
-   for( pCurrentItem = mg_fTabIoctrlChannel; pCurrentItem->function != NULL; pCurrentItem++ )
+   for( pCurrentItem = mg_fTabIoctrlVirtual; pCurrentItem->function != NULL; pCurrentItem++ )
    {
       if( pCurrentItem->number != cmd )
          continue;
       DEBUG_MESSAGE( ": execute ioctl-command: %s\n", pCurrentItem->name );
-      ret = pCurrentItem->function( getChannelFromInstance(pInstance), arg );
+      ret = pCurrentItem->function( getVirtualFromInstance( pInstance ), arg );
       if( ret < 0 )
          ERROR_MESSAGE( ": executing of ioctl-command %s failed!\n",
                         pCurrentItem->name );
@@ -917,227 +2463,307 @@ static long onChannelIoctrl( struct file* pInstance,
    ERROR_MESSAGE( ": Unknown ioctl-command: 0x%08X\n", cmd );
    return -EINVAL;
 }
+/* ioctrl call back functions for the virtual channels END *******************/
+/* Call-back functions for the virtual channels end **************************/
 
-/* ioctrl call back functions for single channel access END ******************/
-
-/* Call-back functions for single analog channel end *************************/
-
-/*!---------------------------------------------------------------------------
- * @brief Return-type for function getObjectByMinor
- * @see getObjectByMinor
+/* Call-back functions for the shared page of values begin *******************/
+/*!----------------------------------------------------------------------------
  * @see onOpen
  */
-typedef enum
+static inline VALUES_T* getValuesFromInstance( struct file* pInstance )
 {
-   IS_ADC_CHANNEL,
-   IS_ADC_CHIP,
-   NOT_FOUND
-} GET_OBJECT_RETURN_T;
+   BUG_ON( pInstance->private_data == NULL );
+   return (VALUES_T*)pInstance->private_data;
+}
 
 /*!----------------------------------------------------------------------------
- * @brief Helper function for the callback function onOpen().
- * 
- * Function searches the appropriate object by the given minor-number and
- * copy it in the first argument ppObject if found.
- *
- * @param  ppObject Copy target for the found object-pointer.
- * @param  minor Minor-number
- * @retval IS_ADC_CHIP *ppObject points to a object of type ADS7924_T.
- * @retval IS_ADC_CHANNEL *ppObject points to a object of type ADC_CHANNEL_T.
- * @retval NOT_FOUND No object found.
- * @see USER_INRTEFACE_T
- * @see onOpen
+ * @see VALUES
  */
-static inline GET_OBJECT_RETURN_T getObjectByMinor( void** ppObject, const int minor )
+static int onValuesOpen( struct inode* pInode, struct file* pInstance )
 {
-   int            chipIndex;
-   int            adcChannelIndex;
-   BUS_T*         pI2cBus;
-   ADS7924_T*     pAds7924;
-   ADC_CHANNEL_T* pChannel;
+   VALUES_T* pValues = getValuesFromInstance( pInstance );
 
-   FOR_EACH_I2C_BUS( pI2cBus )
+   if( (pInstance->f_mode & FMODE_WRITE) != 0 )
    {
-      for( chipIndex = 0; chipIndex < ADC_CHIPS_PER_BUS; chipIndex++ )
-      {
-         pAds7924 = pI2cBus->paChip[chipIndex];
-         if( pAds7924 == NULL )
-            continue;
-         if( pAds7924->minor == minor )
-         {
-            *ppObject = pAds7924;
-            return IS_ADC_CHIP;
-         }
-         for( adcChannelIndex = 0; adcChannelIndex < ADC_CHANNELS_PER_CHIP; adcChannelIndex++ )
-         {
-            pChannel = pAds7924->paChannel[adcChannelIndex];
-            if( pChannel == NULL )
-               continue;
-            if( pChannel->minor == minor )
-            {
-               *ppObject = pChannel;
-               return IS_ADC_CHANNEL;
-            }
-         }
-      }
+      ERROR_MESSAGE( ": %svalues is read-only!\n", g_data.pName );
+      return -EPERM;
    }
-   *ppObject = NULL;
-   return NOT_FOUND;
+   atomic_inc( &pValues->openCounter );
+   DEBUG_MESSAGE( ": Open-counter: %d\n", atomic_read( &pValues->openCounter ) );
+   return 0;
 }
 
 /*!----------------------------------------------------------------------------
- * @brief Callback function becomes invoked by the function open() from the
- *        user-space.
- * @see USER_INRTEFACE_T
+ * @see VALUES
  */
-static int onOpen( struct inode* pInode, struct file* pInstance )
+static int onValuesClose( struct inode *pInode, struct file* pInstance )
 {
-   USER_INRTEFACE_T* pUserInterface;
-   int               minor = MINOR(pInode->i_rdev);
-
-   DEBUG_MESSAGE( ": Minor-number: %d\n", minor );
-   BUG_ON( pInstance->private_data != NULL );
+   VALUES_T* pValues = getValuesFromInstance( pInstance );
 
-   pUserInterface = kmalloc( sizeof( USER_INRTEFACE_T ), GFP_KERNEL );
-   if( pUserInterface == NULL )
-   {
-      ERROR_MESSAGE( ": Unable to allocate kernel-memory for USER_INRTEFACE_T !\n" );
-      return -EIO;
-   }
+   atomic_dec( &pValues->openCounter );
+   DEBUG_MESSAGE( ": Open-counter: %d\n", atomic_read( &pValues->openCounter ) );
+   return 0;
+}
 
-   switch( getObjectByMinor( &pUserInterface->pPrivate, minor ) )
-   {
-      case IS_ADC_CHIP:
-      {
-         DEBUG_MESSAGE( ": Initializing user-interface for entire chip-access.\n" );
-         pUserInterface->pOnOpen   = onChipOpen;
-         pUserInterface->pOnClose  = onChipClose;
-         pUserInterface->pOnRead   = onChipRead;
-         pUserInterface->pOnWrite  = onChipWrite;
-         pUserInterface->pOnPoll   = onChipPoll;
-         pUserInterface->pOnIoctrl = onChipIoctrl;
-         break;
-      }
-      case IS_ADC_CHANNEL:
-      {
-         DEBUG_MESSAGE( ": Initializing user-interface for single channel access.\n" );
-         pUserInterface->pOnOpen   = onChannelOpen;
-         pUserInterface->pOnClose  = onChannelClose;
-         pUserInterface->pOnRead   = onChannelRead;
-         pUserInterface->pOnWrite  = onChannelWrite;
-         pUserInterface->pOnPoll   = onChannelPoll;
-         pUserInterface->pOnIoctrl = onChannelIoctrl;
-         break;
-      }
-      case NOT_FOUND:
-      {
-         ERROR_MESSAGE( ": Corrupt minor: %d\n", minor );
-         kfree( pUserInterface );
-         return -EIO;
-      }
-      default:
-      {
-         BUG_ON( true );
-         break;
-      }
-   }
-   pInstance->private_data = pUserInterface;
+/*!----------------------------------------------------------------------------
+ * @brief Copies the shared page for processes which can not use mmap().
+ * @note The copy isn't guarded by the sequence counters of the slots,
+ *       use ads7924ReadValue() on the copy only for a consistent slot.
+ * @see VALUES
+ */
+static ssize_t onValuesRead( struct file* pInstance, /*!< @see include/linux/fs.h   */
+                             char __user* pBuffer,   /*!< buffer to fill with data */
+                             size_t len,             /*!< length of the buffer     */
+                             loff_t* pOffset )
+{
+   VALUES_T* pValues = getValuesFromInstance( pInstance );
 
-   return pUserInterface->pOnOpen( pInode, pInstance );
+   DEBUG_MESSAGE( ": len = %ld, offset = %lld\n", (long int)len, *pOffset );
+   return simple_read_from_buffer( pBuffer, len, pOffset,
+                                   pValues->pPage, sizeof( ADS7924_VALUES_T ) );
 }
 
 /*!----------------------------------------------------------------------------
- * @brief Callback function becomes invoked by the function close() from the
- *        user-space.
+ * @brief The shared page is read-only.
  */
-static int onClose( struct inode *pInode, struct file* pInstance )
+static ssize_t onValuesWrite( struct file *pInstance,
+                              const char __user* pBuffer,
+                              size_t len,
+                              loff_t* pOffset )
 {
-   int ret;
-   DEBUG_MESSAGE( ": Minor-number: %d\n", MINOR(pInode->i_rdev) );
-   BUG_ON( pInstance->private_data == NULL );
-   BUG_ON((((USER_INRTEFACE_T*)pInstance->private_data)->pOnClose != onChipClose) &&
-          (((USER_INRTEFACE_T*)pInstance->private_data)->pOnClose != onChannelClose)
-         );
+   return -EINVAL;
+}
 
-   ret = ((USER_INRTEFACE_T*)pInstance->private_data)->pOnClose( pInode, pInstance );
+/*!----------------------------------------------------------------------------
+ * @brief The shared page is always readable, the readers shall compare the
+ *        sequence counters of the slots.
+ */
+static unsigned int onValuesPoll( struct file* pInstance, poll_table* pPollTable )
+{
+   return POLLIN | POLLRDNORM;
+}
 
-   kfree( pInstance->private_data );
-   pInstance->private_data = NULL;
+/*!----------------------------------------------------------------------------
+ * @brief The device of the shared page has no ioctl-commands.
+ */
+static long onValuesIoctrl( struct file* pInstance,
+                            unsigned int cmd,
+                            unsigned long arg )
+{
+   ERROR_MESSAGE( ": Unknown ioctl-command: 0x%08X\n", cmd );
+   return -EINVAL;
+}
 
-   return ret;
+/*!----------------------------------------------------------------------------
+ * @see VALUES
+ */
+static int onValuesMmap( struct file* pInstance, struct vm_area_struct* pVma )
+{
+   return adcMapValues( getValuesFromInstance( pInstance ), pVma );
 }
+/* Call-back functions for the shared page of values end *********************/
 
 /*!----------------------------------------------------------------------------
- * @brief Callback function becomes invoked by the function read() from the
- *        user-space.
- * @note The kernel invokes onRead as many times till it returns 0 !!!
+ * @brief File operations of the entire chip devices /dev/adc[0-n][A-B]
  */
-static ssize_t onRead( struct file* pInstance,   /*!< @see include/linux/fs.h   */
-                       char __user* pBuffer,     /*!< buffer to fill with data */
-                       size_t len,               /*!< length of the buffer     */
-                       loff_t* pOffset )
+static const struct file_operations mg_chipFops =
 {
-   DEBUG_MESSAGE( ": len = %ld, offset = %lld\n", (long int)len, *pOffset );
-   DEBUG_ACCESSMODE( pInstance );
-   BUG_ON( pInstance->private_data == NULL );
-   BUG_ON((((USER_INRTEFACE_T*)pInstance->private_data)->pOnRead != onChipRead) &&
-          (((USER_INRTEFACE_T*)pInstance->private_data)->pOnRead != onChannelRead)
-         );
+  .owner          = THIS_MODULE,
+  .open           = onChipOpen,
+  .release        = onChipClose,
+  .read           = onChipRead,
+  .write          = onChipWrite,
+  .poll           = onChipPoll,
+  .unlocked_ioctl = onChipIoctrl
+};
+
+/*!----------------------------------------------------------------------------
+ * @brief File operations of the single channel devices.
+ */
+static const struct file_operations mg_channelFops =
+{
+  .owner          = THIS_MODULE,
+  .open           = onChannelOpen,
+  .release        = onChannelClose,
+  .read           = onChannelRead,
+  .write          = onChannelWrite,
+  .poll           = onChannelPoll,
+  .unlocked_ioctl = onChannelIoctrl
+};
+
+/*!----------------------------------------------------------------------------
+ * @brief File operations of the group device.
+ */
+static const struct file_operations mg_groupFops =
+{
+  .owner          = THIS_MODULE,
+  .open           = onGroupOpen,
+  .release        = onGroupClose,
+  .read           = onGroupRead,
+  .write          = onGroupWrite,
+  .poll           = onGroupPoll,
+  .unlocked_ioctl = onGroupIoctrl
+};
+
+/*!----------------------------------------------------------------------------
+ * @brief File operations of the aggregate device.
+ */
+static const struct file_operations mg_mergeFops =
+{
+  .owner          = THIS_MODULE,
+  .open           = onMergeOpen,
+  .release        = onMergeClose,
+  .read           = onMergeRead,
+  .write          = onMergeWrite,
+  .poll           = onMergePoll,
+  .unlocked_ioctl = onMergeIoctrl
+};
+
+/*!----------------------------------------------------------------------------
+ * @brief File operations of the virtual channels.
+ */
+static const struct file_operations mg_virtualFops =
+{
+  .owner          = THIS_MODULE,
+  .open           = onVirtualOpen,
+  .release        = onVirtualClose,
+  .read           = onVirtualRead,
+  .write          = onVirtualWrite,
+  .poll           = onVirtualPoll,
+  .unlocked_ioctl = onVirtualIoctrl
+};
+
+/*!----------------------------------------------------------------------------
+ * @brief File operations of the shared page of values.
+ */
+static const struct file_operations mg_valuesFops =
+{
+  .owner          = THIS_MODULE,
+  .open           = onValuesOpen,
+  .release        = onValuesClose,
+  .read           = onValuesRead,
+  .write          = onValuesWrite,
+  .poll           = onValuesPoll,
+  .unlocked_ioctl = onValuesIoctrl,
+  .mmap           = onValuesMmap
+};
 
-   return ((USER_INRTEFACE_T*)pInstance->private_data)->pOnRead( pInstance, pBuffer, len, pOffset );
+/*!----------------------------------------------------------------------------
+ * @brief Helper function for adcBuildMinorTable.
+ */
+static inline void setMinorEntry( MINOR_TABLE_T* pTable, int minor,
+                                  const struct file_operations* pFops,
+                                  void* pObject )
+{
+   BUG_ON( (minor < 0) || ((unsigned int)minor >= pTable->count) );
+   pTable->aEntry[minor].pFops   = pFops;
+   pTable->aEntry[minor].pObject = pObject;
 }
 
 /*!----------------------------------------------------------------------------
- * @brief Callback function becomes invoked by the function write() from the
- *        user-space.
+ * @see ads7924fileIo.h
  */
-static ssize_t onWrite( struct file *pInstance,
-                        const char __user* pBuffer,
-                        size_t len,
-                        loff_t* pOffset )
+int adcBuildMinorTable( void )
 {
-   DEBUG_MESSAGE( ": len = %ld, offset = %lld\n", (long int)len, *pOffset );
-   DEBUG_ACCESSMODE( pInstance );
-   BUG_ON( pInstance->private_data == NULL );
-   BUG_ON((((USER_INRTEFACE_T*)pInstance->private_data)->pOnWrite != onChipWrite) &&
-          (((USER_INRTEFACE_T*)pInstance->private_data)->pOnWrite != onChannelWrite)
-         );
+   MINOR_TABLE_T* pTable;
+   BUS_T*         pI2cBus;
+   ADS7924_T*     pChip;
+   int            chipIndex;
+   int            channelIndex;
+
+   BUG_ON( rcu_access_pointer( mg_pMinorTable ) != NULL );
+
+   pTable = kzalloc( sizeof( MINOR_TABLE_T ) +
+                     g_data.maxMinor * sizeof( MINOR_ENTRY_T ), GFP_KERNEL );
+   if( pTable == NULL )
+   {
+      ERROR_MESSAGE( ": Unable to allocate the minor table!\n" );
+      return -ENOMEM;
+   }
+   pTable->count = g_data.maxMinor;
+
+   setMinorEntry( pTable, g_data.group.minor,  &mg_groupFops,  &g_data.group );
+   setMinorEntry( pTable, g_data.merge.minor,  &mg_mergeFops,  &g_data.merge );
+   setMinorEntry( pTable, g_data.values.minor, &mg_valuesFops, &g_data.values );
+
+   FOR_EACH_I2C_BUS( pI2cBus )
+   {
+      for( chipIndex = 0; chipIndex < ADC_CHIPS_PER_BUS; chipIndex++ )
+      {
+         pChip = pI2cBus->paChip[chipIndex];
+         if( pChip == NULL )
+            continue;
+         setMinorEntry( pTable, pChip->minor, &mg_chipFops, pChip );
+         for( channelIndex = 0; channelIndex < ADC_CHANNELS_PER_CHIP; channelIndex++ )
+         {
+            if( pChip->paChannel[channelIndex] == NULL )
+               continue;
+            setMinorEntry( pTable, pChip->paChannel[channelIndex]->minor,
+                           &mg_channelFops, pChip->paChannel[channelIndex] );
+         }
+         for( channelIndex = 0; channelIndex < ARRAY_SIZE( pChip->aVirtual ); channelIndex++ )
+         {
+            setMinorEntry( pTable, pChip->aVirtual[channelIndex].minor,
+                           &mg_virtualFops, &pChip->aVirtual[channelIndex] );
+         }
+      }
+   }
 
-   return ((USER_INRTEFACE_T*)pInstance->private_data)->pOnWrite( pInstance, pBuffer, len, pOffset );
+   rcu_assign_pointer( mg_pMinorTable, pTable );
+   return 0;
 }
 
 /*!----------------------------------------------------------------------------
- * @brief Callback function becomes invoked by the function select() from the
- *        user-space.
+ * @see ads7924fileIo.h
  */
-static unsigned int onPoll( struct file* pInstance, poll_table* pPollTable )
+void adcFreeMinorTable( void )
 {
-#ifdef _DEBUG_POLL
-   DEBUG_MESSAGE( "\n" );
-#endif
-   BUG_ON( pInstance->private_data == NULL );
-   BUG_ON((((USER_INRTEFACE_T*)pInstance->private_data)->pOnPoll != onChipPoll) &&
-          (((USER_INRTEFACE_T*)pInstance->private_data)->pOnPoll != onChannelPoll)
-         );
-   return ((USER_INRTEFACE_T*)pInstance->private_data)->pOnPoll( pInstance, pPollTable );
+   MINOR_TABLE_T* pTable;
+
+   pTable = rcu_dereference_protected( mg_pMinorTable, true );
+   if( pTable == NULL )
+      return;
+   RCU_INIT_POINTER( mg_pMinorTable, NULL );
+   /* No open() may use the table any longer. */
+   synchronize_rcu();
+   kfree( pTable );
 }
 
 /*!----------------------------------------------------------------------------
- * @brief Callback function becomes invoked by the function ioctrl() from the
+ * @brief Callback function becomes invoked by the function open() from the
  *        user-space.
+ *
+ * Looks up the object by the minor number and installs the file
+ * operations of its type, so no further dispatching is necessary.
+ * @see MINOR_ENTRY_T
  */
-static long onIoctrl( struct file* pInstance,
-                      unsigned int cmd,
-                      unsigned long arg )
+static int onOpen( struct inode* pInode, struct file* pInstance )
 {
-   DEBUG_MESSAGE( ": cmd = %d arg = %08lX\n", cmd, arg );
-   DEBUG_ACCESSMODE( pInstance );
-   BUG_ON( pInstance->private_data == NULL );
-   BUG_ON((((USER_INRTEFACE_T*)pInstance->private_data)->pOnIoctrl != onChipIoctrl) &&
-          (((USER_INRTEFACE_T*)pInstance->private_data)->pOnIoctrl != onChannelIoctrl)
-         );
+   const struct file_operations* pFops = NULL;
+   MINOR_TABLE_T* pTable;
+   unsigned int   minor = MINOR(pInode->i_rdev);
+
+   DEBUG_MESSAGE( ": Minor-number: %d\n", minor );
+   BUG_ON( pInstance->private_data != NULL );
+
+   rcu_read_lock();
+   pTable = rcu_dereference( mg_pMinorTable );
+   if( (pTable != NULL) && (minor < pTable->count) )
+   {
+      pFops = fops_get( pTable->aEntry[minor].pFops );
+      pInstance->private_data = pTable->aEntry[minor].pObject;
+   }
+   rcu_read_unlock();
+
+   if( pFops == NULL )
+   {
+      ERROR_MESSAGE( ": Corrupt minor: %d\n", minor );
+      pInstance->private_data = NULL;
+      return -ENODEV;
+   }
 
-   return ((USER_INRTEFACE_T*)pInstance->private_data)->pOnIoctrl( pInstance, cmd, arg );
+   replace_fops( pInstance, pFops );
+   return pInstance->f_op->open( pInode, pInstance );
 }
 
 /*-----------------------------------------------------------------------------
@@ -1145,12 +2771,7 @@ static long onIoctrl( struct file* pInstance,
 const struct file_operations mg_fops =
 {
   .owner          = THIS_MODULE,
-  .open           = onOpen,
-  .release        = onClose,
-  .read           = onRead,
-  .write          = onWrite,
-  .poll           = onPoll,
-  .unlocked_ioctl = onIoctrl
+  .open           = onOpen
 };
 
 /* Device file operations end ************************************************/
@@ -23,6 +23,7 @@
  */
 #ifndef _ADS7924FILEIO_H
 #include "ads7924driver.h"
+#include "ads7924async.h"
 
 /*!----------------------------------------------------------------------------
  * @brief Item object of function-table for ioctl of the entire chip-access.
@@ -87,9 +88,152 @@ typedef struct
 
 extern const IOC_CHANNEL_INFO_T mg_fTabIoctrlChannel[];
 
+/*!----------------------------------------------------------------------------
+ * @brief Item object of function-table for ioctl of the group device.
+ * @see mg_fTabIoctrlGroup
+ * @see onGroupIoctrl
+ */
+typedef struct
+{
+   /*!
+    * @brief The name will be used for debug- and/or error-messages and
+    *        (if CONFIG_ADS7924_SHOW_IOCTL_COMMANDS_IN_PROC_FS defined,)
+    *        in the process-files system.
+    */
+   const char*        name;
+
+   /*!
+    * @brief Operation code, corresponds to the second parameter
+    *        of the user-space-function ioctl().
+    */
+   const unsigned int number;
+
+   /*!
+    * @brief Pointer of to the opcode related callback-function.
+    * @param pGroup Pointer to the group object.
+    * @param arg Corresponds to the third parameter of the
+    *            user-space function ioctl().
+    */
+   long (*function)( GROUP_T* pGroup, unsigned long arg );
+} IOC_GROUP_INFO_T;
+
+extern const IOC_GROUP_INFO_T mg_fTabIoctrlGroup[];
+
+/*!----------------------------------------------------------------------------
+ * @brief Item object of function-table for ioctl of the aggregate device.
+ * @see mg_fTabIoctrlMerge
+ * @see onMergeIoctrl
+ */
+typedef struct
+{
+   /*!
+    * @brief The name will be used for debug- and/or error-messages and
+    *        (if CONFIG_ADS7924_SHOW_IOCTL_COMMANDS_IN_PROC_FS defined,)
+    *        in the process-files system.
+    */
+   const char*        name;
+
+   /*!
+    * @brief Operation code, corresponds to the second parameter
+    *        of the user-space-function ioctl().
+    */
+   const unsigned int number;
+
+   /*!
+    * @brief Pointer of to the opcode related callback-function.
+    * @param pMerge Pointer to the aggregate object.
+    * @param arg Corresponds to the third parameter of the
+    *            user-space function ioctl().
+    */
+   long (*function)( MERGE_T* pMerge, unsigned long arg );
+} IOC_MERGE_INFO_T;
+
+extern const IOC_MERGE_INFO_T mg_fTabIoctrlMerge[];
+
+/*!----------------------------------------------------------------------------
+ * @brief Item object of function-table for ioctl of the virtual channels.
+ * @see mg_fTabIoctrlVirtual
+ * @see onVirtualIoctrl
+ */
+typedef struct
+{
+   /*!
+    * @brief The name will be used for debug- and/or error-messages and
+    *        (if CONFIG_ADS7924_SHOW_IOCTL_COMMANDS_IN_PROC_FS defined,)
+    *        in the process-files system.
+    */
+   const char*        name;
+
+   /*!
+    * @brief Operation code, corresponds to the second parameter
+    *        of the user-space-function ioctl().
+    */
+   const unsigned int number;
+
+   /*!
+    * @brief Pointer of to the opcode related callback-function.
+    * @param pVirtual Pointer to the virtual channel object.
+    * @param arg Corresponds to the third parameter of the
+    *            user-space function ioctl().
+    */
+   long (*function)( VIRTUAL_CHANNEL_T* pVirtual, unsigned long arg );
+} IOC_VIRTUAL_INFO_T;
+
+extern const IOC_VIRTUAL_INFO_T mg_fTabIoctrlVirtual[];
+
+/*!----------------------------------------------------------------------------
+ * @brief Item object of function-table for the asynchronous ioctl-commands
+ *        of the chip devices.
+ * @see mg_fTabIoctrlAsync
+ * @see onChipIoctrl
+ */
+typedef struct
+{
+   /*!
+    * @brief The name will be used for debug- and/or error-messages and
+    *        (if CONFIG_ADS7924_SHOW_IOCTL_COMMANDS_IN_PROC_FS defined,)
+    *        in the process-files system.
+    */
+   const char*        name;
+
+   /*!
+    * @brief Operation code, corresponds to the second parameter
+    *        of the user-space-function ioctl().
+    */
+   const unsigned int number;
+
+   /*!
+    * @brief Pointer of to the opcode related callback-function.
+    * @param pContext Pointer to the asynchronous context of the file
+    *                 descriptor.
+    * @param arg Corresponds to the third parameter of the
+    *            user-space function ioctl().
+    */
+   long (*function)( ASYNC_CONTEXT_T* pContext, unsigned long arg );
+} IOC_ASYNC_INFO_T;
+
+extern const IOC_ASYNC_INFO_T mg_fTabIoctrlAsync[];
+
 /*!----------------------------------------------------------------------------
  */
 extern const struct file_operations mg_fops;
 
+/*!----------------------------------------------------------------------------
+ * @brief Builds the lookup table of the objects by their minor numbers.
+ *
+ * Has to be invoked after all minor numbers are assigned and before the
+ * device files becomes accessible.
+ * @retval ==0 OK
+ * @retval <0  Out of memory.
+ */
+extern int adcBuildMinorTable( void );
+
+/*!----------------------------------------------------------------------------
+ * @brief Removes the lookup table, following open() calls fail by ENODEV.
+ *
+ * Has to be invoked before the objects becomes freed.
+ */
+extern void adcFreeMinorTable( void );
+
 #endif /* ifndef _ADS7924FILEIO_H */
 /*================================== EOF ====================================*/
@@ -0,0 +1,475 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924group.c
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Synchronized acquisition of several chips in time-aligned frames.
+ *
+ * The group thread starts each frame period a manual scan of all members
+ * by adcGroupWriteMode(), waits until the slowest member has finished
+ * its scan and reads afterwards the data registers of each member.
+ * The conversion instants becomes calculated from the time of the
+ * MODECNTRL-write of each member and its timing registers.
+ *
+ * @date 2026.10.18
+ * @see ads7924group.h
+ * @see GROUP
+ */
+#include "ads7924core.h"
+#include "ads7924timing.h"
+#include "ads7924sequencer.h"
+#include "ads7924group.h"
+#include <linux/kthread.h>
+
+#define GROUP_FIFO_SIZE 64 //!<@brief Number of frames in the FIFO, power of two.
+#define GROUP_FIFO_MASK (GROUP_FIFO_SIZE - 1)
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924group.h
+ */
+void _ADS7924_INIT adcInitGroup( GROUP_T* pGroup )
+{
+   BUILD_BUG_ON( (GROUP_FIFO_SIZE & GROUP_FIFO_MASK) != 0 );
+
+   pGroup->minor = -1;
+   atomic_set( &pGroup->openCounter, 0 );
+   mutex_init( &pGroup->oMutex );
+   mutex_init( &pGroup->fifo.oMutex );
+   init_waitqueue_head( &pGroup->oWaitQueue );
+   pGroup->config.count  = 0;
+   pGroup->pThread       = NULL;
+   pGroup->running       = false;
+   pGroup->fifo.paBuffer = NULL;
+   pGroup->fifo.head     = 0;
+   pGroup->fifo.tail     = 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns the chip object of /dev/adc<bus><'A' + chip>, NULL if
+ *        not present.
+ */
+static ADS7924_T* findChip( const ADS7924_GROUP_MEMBER_T* pMember )
+{
+   BUS_T* pBus;
+
+   if( pMember->chip >= ADC_CHIPS_PER_BUS )
+      return NULL;
+
+   FOR_EACH_I2C_BUS( pBus )
+   {
+      if( pBus->pI2cAdapter->nr == pMember->bus )
+         return pBus->paChip[pMember->chip];
+   }
+   return NULL;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924group.h
+ */
+int adcSetGroupMembers( GROUP_T* pGroup, const ADS7924_GROUP_T* pConfig )
+{
+   ADS7924_T* apMember[ADS7924_GROUP_MAX_MEMBERS];
+   int i, j;
+   int ret = 0;
+
+   if( (pConfig->count == 0) || (pConfig->count > ADS7924_GROUP_MAX_MEMBERS) )
+   {
+      ERROR_MESSAGE( ": Invalid number of group members: %u\n", pConfig->count );
+      return -EINVAL;
+   }
+   if( pConfig->period < ADS7924_GROUP_MIN_PERIOD )
+   {
+      ERROR_MESSAGE( ": Frame period of %u us is too short!\n", pConfig->period );
+      return -EINVAL;
+   }
+
+   for( i = 0; i < pConfig->count; i++ )
+   {
+      apMember[i] = findChip( &pConfig->aMember[i] );
+      if( apMember[i] == NULL )
+      {
+         ERROR_MESSAGE( ": Group member %d%c doesn't exist!\n",
+                        pConfig->aMember[i].bus, 'A' + pConfig->aMember[i].chip );
+         return -ENODEV;
+      }
+      for( j = 0; j < i; j++ )
+      {
+         if( apMember[j] == apMember[i] )
+         {
+            ERROR_MESSAGE( ": Group member %d%c is more than once in the group!\n",
+                           pConfig->aMember[i].bus, 'A' + pConfig->aMember[i].chip );
+            return -EINVAL;
+         }
+      }
+   }
+
+   mutex_lock( &pGroup->oMutex );
+   if( pGroup->running )
+   {
+      ret = -EBUSY;
+      goto L_UNLOCK;
+   }
+   pGroup->config = *pConfig;
+   memcpy( pGroup->apMember, apMember, pConfig->count * sizeof( apMember[0] ) );
+
+L_UNLOCK:
+   mutex_unlock( &pGroup->oMutex );
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Puts a frame in the FIFO, by a full FIFO the oldest frame
+ *        becomes dropped.
+ */
+static void pushFrame( GROUP_T* pGroup, const ADS7924_FRAME_T* pFrame )
+{
+   mutex_lock( &pGroup->fifo.oMutex );
+   if( (pGroup->fifo.head - pGroup->fifo.tail) >= GROUP_FIFO_SIZE )
+   {
+      WRITE_ONCE( pGroup->fifo.tail, pGroup->fifo.tail + 1 );
+      pGroup->fifo.stats.lost++;
+   }
+   pGroup->fifo.paBuffer[pGroup->fifo.head & GROUP_FIFO_MASK] = *pFrame;
+   smp_store_release( &pGroup->fifo.head, pGroup->fifo.head + 1 );
+   mutex_unlock( &pGroup->fifo.oMutex );
+   wake_up_interruptible( &pGroup->oWaitQueue );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Counts a failed acquisition.
+ */
+static void addError( GROUP_T* pGroup )
+{
+   mutex_lock( &pGroup->fifo.oMutex );
+   pGroup->fifo.stats.errors++;
+   mutex_unlock( &pGroup->fifo.oMutex );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Starts the scans of all members, reads their values and
+ *        delivers the frame.
+ */
+static void acquireFrame( GROUP_T* pGroup )
+{
+   const unsigned int count = pGroup->config.count;
+   ADS7924_FRAME_T frame;
+   ADS7924_FRAME_MEMBER_T* pMember;
+   VALUE_T aValue[ADC_CHANNELS_PER_CHIP];
+   u64 aStart[ADS7924_GROUP_MAX_MEMBERS];
+   u32 aPwrUp[ADS7924_GROUP_MAX_MEMBERS];
+   u32 aConv[ADS7924_GROUP_MAX_MEMBERS];
+   u8 aConfig[PWRCONFIG - SLPCONFIG + 1];
+   u8 mode;
+   u64 end, scanEnd, now;
+   u32 skew;
+   unsigned int i, c;
+
+   for( i = 0; i < count; i++ )
+   {
+      if( adcReadTimingShadow( pGroup->apMember[i], &mode, aConfig ) < 0 )
+      {
+         addError( pGroup );
+         return;
+      }
+      aPwrUp[i] = (aConfig[PWRCONFIG - SLPCONFIG] & ADS7924_PWRUPTIME_MASK) * 2 * NSEC_PER_USEC;
+      aConv[i]  = adcGetConvTime( aConfig[ACQCONFIG - SLPCONFIG] );
+   }
+
+   if( adcGroupWriteMode( pGroup->apMember, count, ADS7924_MODE_MANUAL_SCAN, aStart ) < 0 )
+   {
+      ERROR_MESSAGE( ": Group: starting of the scans failed!\n" );
+      addError( pGroup );
+      return;
+   }
+
+   /* Waiting for the slowest member. */
+   end = 0;
+   for( i = 0; i < count; i++ )
+   {
+      scanEnd = aStart[i] + aPwrUp[i] + ADC_CHANNELS_PER_CHIP * aConv[i];
+      end = max( end, scanEnd );
+   }
+   now = ktime_get_ns();
+   if( now < end )
+      usleep_range( DIV_ROUND_UP( end - now, NSEC_PER_USEC ),
+                    DIV_ROUND_UP( end - now, NSEC_PER_USEC ) + 10 );
+
+   frame.timestamp = aStart[0];
+   frame.sequence  = pGroup->sequence++;
+   frame.count     = count;
+   for( i = 0; i < count; i++ )
+   {
+      if( adcReadAllAnalogValues( pGroup->apMember[i], aValue ) < 0 )
+      {
+         ERROR_MESSAGE( ": Group: reading of member %d%c failed!\n",
+                        pGroup->config.aMember[i].bus, 'A' + pGroup->config.aMember[i].chip );
+         addError( pGroup );
+         return;
+      }
+      pMember = &frame.aMember[i];
+      pMember->skew  = (u32)(aStart[i] - aStart[0]);
+      pMember->bus   = pGroup->config.aMember[i].bus;
+      pMember->chip  = pGroup->config.aMember[i].chip;
+      pMember->dummy = 0;
+      for( c = 0; c < ADC_CHANNELS_PER_CHIP; c++ )
+      {
+         /* The conversion instant is tCONV before the end of the conversion. */
+         pMember->aDelay[c] = pMember->skew + aPwrUp[i] + (c + 1) * aConv[i] - ADS7924_CONV_TIME_NS;
+         pMember->aValue[c] = aValue[c];
+      }
+   }
+   memset( &frame.aMember[count], 0, (ADS7924_GROUP_MAX_MEMBERS - count) * sizeof( frame.aMember[0] ) );
+
+   skew = frame.aMember[count - 1].skew;
+   mutex_lock( &pGroup->fifo.oMutex );
+   pGroup->fifo.stats.frames++;
+   pGroup->fifo.stats.lastSkew = skew;
+   pGroup->fifo.stats.maxSkew  = max( pGroup->fifo.stats.maxSkew, skew );
+   mutex_unlock( &pGroup->fifo.oMutex );
+
+   pushFrame( pGroup, &frame );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Body of the group thread.
+ *
+ * The frames becomes released on a absolute time grid, so the frame
+ * period doesn't stretch by the duration of the acquisition. Periods
+ * which has been missed completely becomes counted as late.
+ */
+static int onGroupThread( void* pData )
+{
+   GROUP_T* pGroup = pData;
+   const u64 period = (u64)pGroup->config.period * NSEC_PER_USEC;
+   u64 next = ktime_get_ns();
+   u64 now, missed;
+   ktime_t expires;
+
+   DEBUG_MESSAGE( ": Group of %u chips started\n", pGroup->config.count );
+   while( !kthread_should_stop() )
+   {
+      acquireFrame( pGroup );
+
+      next += period;
+      now = ktime_get_ns();
+      if( now >= next + period )
+      {
+         missed = div64_u64( now - next, period );
+         next += missed * period;
+         mutex_lock( &pGroup->fifo.oMutex );
+         pGroup->fifo.stats.late += missed;
+         mutex_unlock( &pGroup->fifo.oMutex );
+      }
+
+      expires = ns_to_ktime( next );
+      set_current_state( TASK_INTERRUPTIBLE );
+      if( kthread_should_stop() )
+         break;
+      schedule_hrtimeout_range( &expires, ADS7924_CONV_TIME_NS, HRTIMER_MODE_ABS );
+   }
+   __set_current_state( TASK_RUNNING );
+   DEBUG_MESSAGE( ": Group stopped\n" );
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns true when the chip is streaming or sequencing and
+ *        therefore can not become member of the running group.
+ */
+static inline bool isMemberBusy( ADS7924_T* pChip )
+{
+   return (READ_ONCE( pChip->streamMode ) != ADS7924_STREAM_OFF) ||
+          adcIsSequencing( pChip );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Restores the saved modes and releases the first count members.
+ */
+static int releaseMembers( GROUP_T* pGroup, unsigned int count )
+{
+   unsigned int i;
+   int ret = 0;
+
+   for( i = 0; i < count; i++ )
+   {
+      if( adcWriteModeByte( pGroup->apMember[i], pGroup->aPrevMode[i] ) < 0 )
+      {
+         ERROR_MESSAGE( ": Restoring of mode 0x%02X failed!\n", pGroup->aPrevMode[i] );
+         ret = -EIO;
+      }
+      pGroup->apMember[i]->inGroup = false;
+   }
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924group.h
+ */
+int adcStartGroup( GROUP_T* pGroup )
+{
+   ADS7924_T* pChip;
+   u8 aConfig[PWRCONFIG - SLPCONFIG + 1];
+   unsigned int i;
+   int ret = 0;
+
+   mutex_lock( &pGroup->oMutex );
+   if( pGroup->running )
+      goto L_UNLOCK;
+
+   if( pGroup->config.count == 0 )
+   {
+      ERROR_MESSAGE( ": Group has no members!\n" );
+      ret = -EINVAL;
+      goto L_UNLOCK;
+   }
+
+   if( pGroup->fifo.paBuffer == NULL )
+   {
+      pGroup->fifo.paBuffer = kmalloc_array( GROUP_FIFO_SIZE, sizeof( ADS7924_FRAME_T ),
+                                             GFP_KERNEL );
+      if( pGroup->fifo.paBuffer == NULL )
+      {
+         ERROR_MESSAGE( ": Unable to allocate the frame FIFO!\n" );
+         ret = -ENOMEM;
+         goto L_UNLOCK;
+      }
+   }
+
+   /*
+    * Check and take of each member under its sequencer.oMutex, which
+    * serializes the group with the starts of streaming and sequencer and
+    * with the ioctls rewriting the mode.
+    */
+   for( i = 0; i < pGroup->config.count; i++ )
+   {
+      pChip = pGroup->apMember[i];
+      mutex_lock( &pChip->sequencer.oMutex );
+      if( isMemberBusy( pChip ) )
+      {
+         mutex_unlock( &pChip->sequencer.oMutex );
+         ERROR_MESSAGE( ": Member %u is streaming or sequencing!\n", i );
+         ret = -EBUSY;
+         break;
+      }
+      if( adcReadTimingShadow( pChip, &pGroup->aPrevMode[i], aConfig ) < 0 )
+      {
+         mutex_unlock( &pChip->sequencer.oMutex );
+         ret = -EIO;
+         break;
+      }
+      pChip->inGroup = true;
+      mutex_unlock( &pChip->sequencer.oMutex );
+   }
+   if( ret < 0 )
+   {
+      while( i-- > 0 )
+         pGroup->apMember[i]->inGroup = false;
+      goto L_UNLOCK;
+   }
+
+   mutex_lock( &pGroup->fifo.oMutex );
+   WRITE_ONCE( pGroup->fifo.head, 0 );
+   WRITE_ONCE( pGroup->fifo.tail, 0 );
+   memset( &pGroup->fifo.stats, 0, sizeof( pGroup->fifo.stats ) );
+   mutex_unlock( &pGroup->fifo.oMutex );
+   pGroup->sequence = 0;
+
+   pGroup->pThread = kthread_run( onGroupThread, pGroup, "ads7924group" );
+   if( IS_ERR( pGroup->pThread ) )
+   {
+      ERROR_MESSAGE( ": Unable to start the group thread!\n" );
+      ret = PTR_ERR( pGroup->pThread );
+      pGroup->pThread = NULL;
+      releaseMembers( pGroup, pGroup->config.count );
+      goto L_UNLOCK;
+   }
+   pGroup->running = true;
+
+L_UNLOCK:
+   mutex_unlock( &pGroup->oMutex );
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924group.h
+ */
+int adcStopGroup( GROUP_T* pGroup )
+{
+   int ret = 0;
+
+   mutex_lock( &pGroup->oMutex );
+   if( pGroup->running )
+   {
+      kthread_stop( pGroup->pThread );
+      pGroup->pThread = NULL;
+      pGroup->running = false;
+      ret = releaseMembers( pGroup, pGroup->config.count );
+      wake_up_interruptible( &pGroup->oWaitQueue );
+   }
+   mutex_unlock( &pGroup->oMutex );
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924group.h
+ */
+void adcFreeGroup( GROUP_T* pGroup )
+{
+   adcStopGroup( pGroup );
+   kfree( pGroup->fifo.paBuffer );
+   pGroup->fifo.paBuffer = NULL;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924group.h
+ */
+void adcGetGroupStats( GROUP_T* pGroup, ADS7924_GROUP_STATS_T* pStats )
+{
+   mutex_lock( &pGroup->fifo.oMutex );
+   *pStats = pGroup->fifo.stats;
+   mutex_unlock( &pGroup->fifo.oMutex );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924group.h
+ */
+unsigned int adcGroupFifoLevel( GROUP_T* pGroup )
+{
+   unsigned int tail = READ_ONCE( pGroup->fifo.tail );
+
+   return smp_load_acquire( &pGroup->fifo.head ) - tail;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924group.h
+ */
+unsigned int adcPopFrames( GROUP_T* pGroup, ADS7924_FRAME_T* paFrame,
+                           unsigned int max )
+{
+   unsigned int n;
+
+   mutex_lock( &pGroup->fifo.oMutex );
+   for( n = 0; (n < max) && (pGroup->fifo.head != pGroup->fifo.tail); n++ )
+   {
+      paFrame[n] = pGroup->fifo.paBuffer[pGroup->fifo.tail & GROUP_FIFO_MASK];
+      WRITE_ONCE( pGroup->fifo.tail, pGroup->fifo.tail + 1 );
+   }
+   mutex_unlock( &pGroup->fifo.oMutex );
+   return n;
+}
+
+/*================================== EOF ====================================*/
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924group.h
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Synchronized acquisition of several chips in time-aligned frames.
+ * @date 2026.10.18
+ * @see ads7924group.c
+ * @see GROUP
+ */
+#ifndef _ADS7924GROUP_H
+#define _ADS7924GROUP_H
+
+#include "ads7924driver.h"
+
+/*!----------------------------------------------------------------------------
+ * @brief Initializes the group object.
+ */
+extern void adcInitGroup( GROUP_T* pGroup );
+
+/*!----------------------------------------------------------------------------
+ * @brief Checks and stores the members of the group.
+ * @retval ==0 OK
+ * @retval <0  Error (-EINVAL, -ENODEV if a chip doesn't exist or -EBUSY
+ *             if the group is running)
+ */
+extern int adcSetGroupMembers( GROUP_T* pGroup, const ADS7924_GROUP_T* pConfig );
+
+/*!----------------------------------------------------------------------------
+ * @brief Starts the synchronized acquisition of the members.
+ *
+ * Saves the modes of the members, allocates the frame FIFO and starts
+ * the group thread.
+ * @retval ==0 OK
+ * @retval <0  Error (-EINVAL if no member, -EBUSY if a member is streaming
+ *             or sequencing, -ENOMEM)
+ */
+extern int adcStartGroup( GROUP_T* pGroup );
+
+/*!----------------------------------------------------------------------------
+ * @brief Stops the acquisition, restores the modes of the members and
+ *        wakes the waiting readers.
+ */
+extern int adcStopGroup( GROUP_T* pGroup );
+
+/*!----------------------------------------------------------------------------
+ * @brief Stops the group if running and frees the frame FIFO, used when
+ *        the driver becomes unloaded.
+ */
+extern void adcFreeGroup( GROUP_T* pGroup );
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns the statistics of the group since its last start.
+ */
+extern void adcGetGroupStats( GROUP_T* pGroup, ADS7924_GROUP_STATS_T* pStats );
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns the number of frames in the FIFO.
+ *
+ * Lockless snapshot, usable as condition of wait_event_interruptible().
+ */
+extern unsigned int adcGroupFifoLevel( GROUP_T* pGroup );
+
+/*!----------------------------------------------------------------------------
+ * @brief Moves up to max frames from the FIFO to paFrame.
+ * @return Number of moved frames.
+ */
+extern unsigned int adcPopFrames( GROUP_T* pGroup, ADS7924_FRAME_T* paFrame,
+                                  unsigned int max );
+
+#endif /* ifndef _ADS7924GROUP_H */
+/*================================== EOF ====================================*/
@@ -214,25 +214,1338 @@ STATIC_ASSERT( sizeof( ADS7924_BIT_EDIT_T ) == 2 );
 #define ACQTIME2   (1 << 2)
 #define ACQTIME1   (1 << 1)
 #define ACQTIME0   (1 << 0)
+
+#define ADS7924_ACQTIME_MASK (ACQTIME4 | ACQTIME3 | ACQTIME2 | ACQTIME1 | ACQTIME0)
 /*! @} End of defgroup ACQ_CONFIG */
 
 /*!
- * @defgroup PWR_CONFIG
- * @see PWRCONFIG
- * @see ADS7924_IOCTL_SET_PWRCONFIG
- * @see ADS7924_IOCTL_GET_PWRCONFIG
- * @see ADS7924_IOCTL_EDIT_PWRCONFIG
+ * @defgroup PWR_CONFIG
+ * @see PWRCONFIG
+ * @see ADS7924_IOCTL_SET_PWRCONFIG
+ * @see ADS7924_IOCTL_GET_PWRCONFIG
+ * @see ADS7924_IOCTL_EDIT_PWRCONFIG
+ * @{
+ */
+#define CALCNTL    (1 << 7)
+#define PWRCONPOL  (1 << 6)
+#define PWRCONEN   (1 << 5)
+#define PWRUPTIME4 (1 << 4)
+#define PWRUPTIME3 (1 << 3)
+#define PWRUPTIME2 (1 << 2)
+#define PWRUPTIME1 (1 << 1)
+#define PWRUPTIME0 (1 << 0)
+
+#define ADS7924_PWRUPTIME_MASK (PWRUPTIME4 | PWRUPTIME3 | PWRUPTIME2 | PWRUPTIME1 | PWRUPTIME0)
+/*! @} End of defgroup PWR_CONFIG*/
+
+/*!----------------------------------------------------------------------------
+ * @defgroup CALIBRATION Calibration of analog channels
+ *
+ * The calibration converts the raw 12 bit analog value into a signed
+ * engineering unit (e.g. millivolt) when the read-mode
+ * ADS7924_IOCTL_READMODE_SCALED is selected.\n
+ * If ADS7924_CALIBRATION_T::numPoints is zero, the linear equation\n
+ * scaled = ((raw * gain) >> 16) + offset\n
+ * becomes used, otherwise the piecewise-linear table in
+ * ADS7924_CALIBRATION_T::aPoint. Raw values outside of the table becomes
+ * extrapolated by the first respectively last segment.
+ *
+ * Example: 3.3 V reference in millivolt:
+ * @code
+ * ADS7924_CALIBRATION_T calib = { .gain = (3300 << 16) / 4096 };
+ * ioctl( fd, ADS7924_IOCTL_SET_CALIBRATION, &calib );
+ * ioctl( fd, ADS7924_IOCTL_READMODE_SCALED );
+ * @endcode
+ * @see ADS7924_IOCTL_SET_CALIBRATION
+ * @see ADS7924_IOCTL_GET_CALIBRATION
+ * @see ADS7924_IOCTL_READMODE_SCALED
+ * @{
+ */
+
+/*!
+ * @brief Maximum number of points of a piecewise-linear calibration table.
+ */
+#define ADS7924_MAX_CALIB_POINTS 8
+
+/*!
+ * @brief Single point of a piecewise-linear calibration table.
+ */
+typedef struct
+{
+   uint16_t raw;    //!<@brief Raw analog value 0 to ADS7924_MAX_VALUE
+   uint16_t dummy;  //!<@brief Padding, shall be zero.
+   int32_t  scaled; //!<@brief Appropriate value in engineering unit.
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_CALIB_POINT_T;
+
+/*!
+ * @brief Calibration of a single analog channel.
+ */
+typedef struct
+{
+   int32_t               gain;      //!<@brief Fixed point gain Q16.16
+   int32_t               offset;    //!<@brief Offset in engineering unit.
+   uint32_t              numPoints; //!<@brief 0: linear, 2..ADS7924_MAX_CALIB_POINTS: table
+   ADS7924_CALIB_POINT_T aPoint[ADS7924_MAX_CALIB_POINTS]; //!<@brief Ascending by raw
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_CALIBRATION_T;
+
+/*! @} End of defgroup CALIBRATION */
+
+/*!----------------------------------------------------------------------------
+ * @defgroup OFFSET_CALIBRATION Automatic offset calibration
+ *
+ * During the offset calibration the inputs of the ADS7924 becomes
+ * internally connected to AGND (CALCNTL), all four channels becomes
+ * converted once and the results are the offsets which will subtracted
+ * from each following analog value of the related channel. Afterwards
+ * a normal scan overwrites the data registers before the previous mode
+ * becomes restored.
+ *
+ * Whilst the sequencer or a group owns the mode of the chip, the periodic
+ * calibration is skipped until the next interval.
+ * @see ADS7924_IOCTL_SET_OFFSET_CAL_INTERVAL
+ * @see ADS7924_IOCTL_OFFSET_CALIBRATE
+ * @see ADS7924_IOCTL_GET_OFFSET_HISTORY
+ * @{
+ */
+
+/*!
+ * @brief Number of stored offset calibrations per chip.
+ */
+#define ADS7924_OFFSET_HISTORY_SIZE 16
+
+/*!
+ * @brief Result of a single offset calibration.
+ */
+typedef struct
+{
+   uint64_t timestamp; //!<@brief Monotonic time of calibration in nanoseconds.
+   int16_t  offset[4]; //!<@brief Measured offset of channel 0 to 3.
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_OFFSET_ENTRY_T;
+
+/*!
+ * @brief Offset history of a chip, the newest entry is aEntry[0].
+ */
+typedef struct
+{
+   uint32_t               count;    //!<@brief Number of valid entries.
+   uint32_t               interval; //!<@brief Current interval in milliseconds.
+   ADS7924_OFFSET_ENTRY_T aEntry[ADS7924_OFFSET_HISTORY_SIZE];
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_OFFSET_HISTORY_T;
+
+/*! @} End of defgroup OFFSET_CALIBRATION */
+
+/*!----------------------------------------------------------------------------
+ * @brief Argument of ADS7924_IOCTL_SET_RATE
+ *
+ * Example: 100 Hz per channel in auto-scan with sleep mode.
+ * @code
+ * ADS7924_RATE_T rate = { .rate = 100000, .mode = ADS7924_MODE_AUTO_SCAN_SLEEP };
+ * if( ioctl( fd, ADS7924_IOCTL_SET_RATE, &rate ) == 0 )
+ *    printf( "Achieved: %u.%03u Hz\n", rate.rate / 1000, rate.rate % 1000 );
+ * @endcode
+ * @see ADS7924_IOCTL_SET_RATE
+ */
+typedef struct
+{
+   uint32_t rate;         //!<@brief In: requested, out: achieved sample-rate per channel in mHz.
+   uint32_t minAcqTime;   //!<@brief In: minimum acquire time tACQ in ns.
+   uint32_t minPwrUpTime; //!<@brief In: minimum power-up time tPWRUP in ns (sleep-modes only).
+   uint32_t convTime;     //!<@brief Out: conversion time per channel tACQ + tCONV in ns.
+   uint64_t period;       //!<@brief Out: achieved sample period per channel in ns.
+   uint8_t  mode;         //!<@brief In: one of the automatic modes, @see OP_MODES
+   uint8_t  slpConfig;    //!<@brief Out: written value of SLPCONFIG
+   uint8_t  acqConfig;    //!<@brief Out: written value of ACQCONFIG
+   uint8_t  pwrConfig;    //!<@brief Out: written value of PWRCONFIG
+   uint32_t dummy;        //!<@brief Padding, shall be zero.
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_RATE_T;
+
+/*!----------------------------------------------------------------------------
+ * @brief Measured scan rate of a chip.
+ *
+ * The timing of the ADS7924 runs on its internal oscillator which
+ * drifts against CLOCK_MONOTONIC. The driver estimates the actual period
+ * continuously from the arrivals of the hardware-interrupts by a
+ * phase-locked loop.
+ * @see ADS7924_IOCTL_GET_SCAN_RATE
+ * @see ADS7924_IOCTL_SET_DRIFT_CORRECTION
+ */
+typedef struct
+{
+   uint64_t nominalPeriod;  //!<@brief Period by the datasheet timing model in ns, 0: no automatic mode.
+   uint64_t measuredPeriod; //!<@brief Estimated period in ns.
+   uint64_t jitter;         //!<@brief Mean deviation of the interrupt arrivals in ns.
+   uint32_t rate;           //!<@brief Estimated rate in mHz.
+   uint32_t confidence;     //!<@brief 0 (none) to 1000 (locked without jitter)
+   uint32_t count;          //!<@brief Number of interrupts since the last reset of the estimation.
+   uint32_t correction;     //!<@brief 1: timestamps becomes corrected, 0: not.
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_SCAN_RATE_T;
+
+/*!----------------------------------------------------------------------------
+ * @brief Analog value including its conversion instant.
+ *
+ * In the automatic modes the timestamp is the reconstructed instant of the
+ * conversion of this channel: The driver takes the time of the hardware
+ * interrupt as end of the scan and goes back by the timing of the current
+ * register configuration (SLPCONFIG, ACQCONFIG, PWRCONFIG).
+ * In all other cases it is the time of reading via the I2C-bus.
+ * @see ADS7924_IOCTL_GET_SAMPLE
+ * @see ADS7924_IOCTL_READMODE_SAMPLE
+ */
+typedef struct
+{
+   uint64_t timestamp; //!<@brief Monotonic time (CLOCK_MONOTONIC) in nanoseconds.
+   uint16_t value;     //!<@brief Analog value.
+   uint8_t  channel;   //!<@brief Channel number 0 to 3.
+   uint8_t  flags;     //!<@brief ADS7924_SAMPLE_RECONSTRUCTED or 0
+   uint32_t dummy;     //!<@brief Padding.
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_SAMPLE_T;
+
+/*!
+ * @brief Flag of ADS7924_SAMPLE_T: Samples before this one are lost
+ *        because the FIFO of the channel was full.
+ * @see STREAMING
+ */
+#define ADS7924_SAMPLE_OVERRUN       (1 << 1)
+
+/*!----------------------------------------------------------------------------
+ * @defgroup STREAMING Data-ready streaming
+ *
+ * In the streaming mode the INT-pin signals the end of each conversion
+ * respectively of each scan instead of alarms (INTCNFG1, INTCNFG0,
+ * BUSY_nINT of INTCONFIG). The interrupt reads the analog values of all
+ * channels by a single I2C-transfer and puts each sample in the FIFO of
+ * the related opened channel, independent of thresholds and alarm enables.
+ *
+ * The function read() of a channel returns the samples of the FIFO,
+ * in the binary formats as many as fit in the buffer, in the ASCII formats
+ * one line per sample.
+ *
+ * Example:
+ * @code
+ * ioctl( fdChip, ADS7924_IOCTL_SET_MODE, ADS7924_MODE_AUTO_SCAN_SLEEP );
+ * ioctl( fdChip, ADS7924_IOCTL_SET_STREAMING, ADS7924_STREAM_SCAN );
+ * ioctl( fdChannel, ADS7924_IOCTL_READMODE_SAMPLE );
+ * n = read( fdChannel, aSample, sizeof( aSample ) );
+ * @endcode
+ * @see ADS7924_IOCTL_SET_STREAMING
+ * @see ADS7924_IOCTL_GET_STREAMING
+ * @{
+ */
+#define ADS7924_STREAM_OFF        0 //!<@brief Alarm-interrupts only (default).
+#define ADS7924_STREAM_CONVERSION 1 //!<@brief Interrupt by each conversion.
+#define ADS7924_STREAM_SCAN       2 //!<@brief Interrupt by each scan of all four channels.
+
+/*!
+ * @brief Bits of INTCONFIG which determines the function of the INT-pin.
+ */
+#define ADS7924_INTCNFG_MASK           (INTCNFG1 | INTCNFG0 | BUSY_nINT)
+#define ADS7924_INTCNFG_ALARM          0                     //!<@brief INT by alarm
+#define ADS7924_INTCNFG_DATA_READY_ONE (INTCNFG0)            //!<@brief INT by each conversion
+#define ADS7924_INTCNFG_DATA_READY_ALL (INTCNFG1 | INTCNFG0) //!<@brief INT by each completed scan
+
+/*!
+ * @brief Wakeup condition of the readers of a channel FIFO.
+ *
+ * A blocking read() and poll() of the channel wait until at least
+ * watermark samples are in the FIFO or the oldest sample waits longer
+ * than timeout microseconds, whichever comes first. A timeout of zero
+ * waits for the watermark only. The default {1, 0} wakes by each sample.
+ *
+ * The FIFO is shared by all file descriptors of the channel, so is the
+ * wakeup condition. A read() with O_NONBLOCK returns the present samples
+ * regardless of the watermark.
+ *
+ * Example: Wake a logger by 200 samples, but at least every 250 ms.
+ * @code
+ * ADS7924_WAKEUP_T wakeup = { .watermark = 200, .timeout = 250000 };
+ * ioctl( fdChannel, ADS7924_IOCTL_SET_WAKEUP, &wakeup );
+ * @endcode
+ * @see ADS7924_IOCTL_SET_WAKEUP
+ */
+typedef struct
+{
+   uint32_t watermark; //!<@brief 1 to CONFIG_ADS7924_FIFO_SIZE samples.
+   uint32_t timeout;   //!<@brief Maximum latency in microseconds, 0: none.
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_WAKEUP_T;
+
+/*! @} End of defgroup STREAMING */
+
+/*!----------------------------------------------------------------------------
+ * @defgroup FRESH_READ Read policies of a channel
+ *
+ * Determines whether read() and ADS7924_IOCTL_GET_SAMPLE return the last
+ * stored value or wait for a fresh one.
+ *
+ * ADS7924_FRESH_READ_NEXT_SCAN is meant for request/response consumers in
+ * the automatic modes, e.g. ADS7924_MODE_AUTO_SCAN_SLEEP, without enabling
+ * alarms by each scan: The driver predicts the end of the next conversion
+ * of the channel from the timing registers and the last known scan end and
+ * sleeps by a high-resolution timer until this point.
+ * The last known scan end is the one of the scan period estimation if
+ * interrupts has been occurred, otherwise the time of the last write
+ * of MODECNTRL. The waiting time is limited to one period plus the
+ * tolerance of the sleep oscillator, so the returned value is in any
+ * case converted after the request.
+ *
+ * Example:
+ * @code
+ * ioctl( fdChip, ADS7924_IOCTL_SET_MODE, ADS7924_MODE_AUTO_SCAN_SLEEP );
+ * ioctl( fdChannel, ADS7924_IOCTL_SET_FRESH_READ, ADS7924_FRESH_READ_NEXT_SCAN );
+ * ioctl( fdChannel, ADS7924_IOCTL_GET_SAMPLE, &sample );
+ * @endcode
+ *
+ * With ADS7924_FRESH_READ_OFF a maximum age of the stored value can be set
+ * by ADS7924_IOCTL_SET_MAX_AGE: read() and ADS7924_IOCTL_GET_SAMPLE return
+ * the stored value including its timestamp as long as it is younger than
+ * this age, otherwise the data register becomes read again, coalesced with
+ * the concurrent readers of the same chip. So the bus load of any number
+ * of polling processes is limited to one transfer per channel and age.
+ * @code
+ * ioctl( fdChannel, ADS7924_IOCTL_SET_MAX_AGE, 50000 ); // 50 ms
+ * @endcode
+ * @see ADS7924_IOCTL_SET_FRESH_READ
+ * @see ADS7924_IOCTL_SET_MAX_AGE
+ * @{
+ */
+#define ADS7924_FRESH_READ_OFF        0 //!<@brief Last stored value (default).
+#define ADS7924_FRESH_READ_CONVERSION 1 //!<@brief Conversion on demand in the non-automatic modes.
+#define ADS7924_FRESH_READ_NEXT_SCAN  2 //!<@brief Waits for the next conversion in the automatic modes.
+
+/*! @} End of defgroup FRESH_READ */
+
+/*!----------------------------------------------------------------------------
+ * @defgroup SEQUENCER Channel sequencer of the driver
+ *
+ * If only a part of the channels is in use, the sequencer of the driver
+ * delivers just these, that means the channels whose device files are
+ * currently open or which are subscribed by the aggregate stream.
+ *
+ * By ADS7924_SEQ_ROUND_ROBIN the chip runs in ADS7924_MODE_AUTO_SINGLE
+ * if only one channel is in use, otherwise in ADS7924_MODE_AUTO_SCAN.
+ * Once per period the sequencer reads the data registers from the first
+ * to the last channel in use by a single I2C burst transfer and delivers
+ * the values like in the streaming mode: read() of a channel returns the
+ * samples of its FIFO. So each channel in use gets one sample per period,
+ * unless the I2C-bus is slower; between the bursts the sequencer sleeps
+ * for the period, but at least 20 us, to leave the I2C-bus to other users.
+ *
+ * Whilst the sequencer is running the chip mode is owned by the driver,
+ * ADS7924_IOCTL_SET_MODE, ADS7924_IOCTL_SET_STREAMING, ADS7924_IOCTL_SET_RATE,
+ * ADS7924_IOCTL_RESET and ADS7924_IOCTL_OFFSET_CALIBRATE are refused
+ * by EBUSY. Stopping the sequencer restores the previous mode.
+ *
+ * Example:
+ * @code
+ * fd0 = open( "/dev/adc1A0", O_RDONLY );
+ * fd1 = open( "/dev/adc1A1", O_RDONLY );
+ * ioctl( fdChip, ADS7924_IOCTL_SET_SEQUENCER, ADS7924_SEQ_ROUND_ROBIN );
+ * ioctl( fd0, ADS7924_IOCTL_READMODE_SAMPLE );
+ * n = read( fd0, aSample, sizeof( aSample ) );
+ * @endcode
+ *
+ * By ADS7924_SEQ_SCHEDULE the sequencer executes a user-defined schedule
+ * table instead, see ADS7924_SCHEDULE_T: A periodic high-resolution timer
+ * releases a tick each base period and each entry becomes converted in
+ * each divider-th tick, so each channel becomes delivered by its own rate.
+ * Within a tick the due entries becomes converted in the order of their
+ * priority. Entries which can't start before the next tick, e.g. because
+ * of a overloaded I2C-bus, becomes skipped and counted as deadline-miss,
+ * so the entries of low priority becomes shed first.
+ * @code
+ * ADS7924_SCHEDULE_T schedule =
+ * {
+ *    .period = 1000, // 1 ms
+ *    .count  = 2,
+ *    .aEntry =
+ *    {
+ *       { .channel = 0, .priority = 10, .divider = 1 },   // 1 kHz current
+ *       { .channel = 3, .priority = 0,  .divider = 1000 } // 1 Hz temperature
+ *    }
+ * };
+ * ioctl( fdChip, ADS7924_IOCTL_SET_SCHEDULE, &schedule );
+ * ioctl( fdChip, ADS7924_IOCTL_SET_SEQUENCER, ADS7924_SEQ_SCHEDULE );
+ * @endcode
+ * @see ADS7924_IOCTL_SET_SEQUENCER
+ * @see ADS7924_IOCTL_GET_SEQUENCER
+ * @see ADS7924_IOCTL_SET_SCHEDULE
+ * @see ADS7924_IOCTL_GET_SCHEDULE_STATS
+ * @{
+ */
+#define ADS7924_SEQ_OFF         0 //!<@brief Chip runs in the mode by ADS7924_IOCTL_SET_MODE (default).
+#define ADS7924_SEQ_ROUND_ROBIN 1 //!<@brief Burst reading of the opened channels.
+#define ADS7924_SEQ_SCHEDULE    2 //!<@brief Execution of the schedule table.
+
+#define ADS7924_SCHEDULE_SIZE       8   //!<@brief Maximum number of schedule entries.
+#define ADS7924_SCHEDULE_MIN_PERIOD 100 //!<@brief Minimum base period in microseconds.
+
+/*!
+ * @brief Entry of the schedule table.
+ */
+typedef struct
+{
+   uint8_t  channel;  //!<@brief Channel number 0 to 3.
+   uint8_t  priority; //!<@brief Higher values becomes converted first within a tick.
+   uint16_t divider;  //!<@brief Conversion in each divider-th tick, 1 to 65535.
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_SCHEDULE_ENTRY_T;
+
+/*!
+ * @brief Schedule table of the sequencer.
+ * @see ADS7924_IOCTL_SET_SCHEDULE
+ */
+typedef struct
+{
+   uint32_t                 period; //!<@brief Base period of the ticks in microseconds.
+   uint32_t                 count;  //!<@brief Number of valid entries in aEntry.
+   ADS7924_SCHEDULE_ENTRY_T aEntry[ADS7924_SCHEDULE_SIZE];
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_SCHEDULE_T;
+
+/*!
+ * @brief Statistics of a schedule entry, all times in nanoseconds.
+ *
+ * The latency is the distance between the release of the tick and the
+ * conversion instant. A deadline-miss is a conversion which has been
+ * skipped or has been completed after the next release of the same entry.
+ */
+typedef struct
+{
+   uint32_t samples;     //!<@brief Number of delivered samples.
+   uint32_t misses;      //!<@brief Number of deadline-misses.
+   uint32_t minLatency;
+   uint32_t maxLatency;
+   uint32_t meanLatency; //!<@brief Floating mean over 16 samples.
+   uint32_t jitter;      //!<@brief Floating mean deviation of the latency.
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_SCHEDULE_STAT_T;
+
+/*!
+ * @brief Statistics of the running schedule.
+ * @see ADS7924_IOCTL_GET_SCHEDULE_STATS
+ */
+typedef struct
+{
+   uint32_t                ticks;    //!<@brief Number of processed ticks.
+   uint32_t                overruns; //!<@brief Number of ticks which has been lost completely.
+   ADS7924_SCHEDULE_STAT_T aEntry[ADS7924_SCHEDULE_SIZE]; //!<@brief In order of ADS7924_SCHEDULE_T::aEntry
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_SCHEDULE_STATS_T;
+
+/*! @} End of defgroup SEQUENCER */
+
+/*!----------------------------------------------------------------------------
+ * @defgroup GROUP Synchronized acquisition of several chips
+ *
+ * The group device /dev/adcgroup acquires the selected chips of all
+ * I2C-buses together: Each frame period the driver starts a manual scan
+ * of all members by back-to-back writes of MODECNTRL whilst holding the
+ * bus-locks of all members, records the time after each write and reads
+ * afterwards the four data registers of each member.
+ * The result is a time-aligned frame of type ADS7924_FRAME_T, which
+ * contains the skew of each member against the first one and the delay
+ * of each conversion instant against the frame timestamp. So values of
+ * different chips can be compared without resampling.
+ *
+ * Because each frame starts new scans, the internal oscillators of the
+ * chips can't drift apart. Whilst the group is running the modes of the
+ * members are owned by the driver, ADS7924_IOCTL_SET_MODE,
+ * ADS7924_IOCTL_SET_STREAMING, ADS7924_IOCTL_SET_SEQUENCER,
+ * ADS7924_IOCTL_SET_RATE, ADS7924_IOCTL_RESET and
+ * ADS7924_IOCTL_OFFSET_CALIBRATE of the members are refused by EBUSY.
+ *
+ * The function read() of the group device returns whole frames only.
+ *
+ * Example:
+ * @code
+ * ADS7924_GROUP_T group =
+ * {
+ *    .period  = 1000, // 1 ms
+ *    .count   = 2,
+ *    .aMember = { { .bus = 1, .chip = 0 }, { .bus = 1, .chip = 1 } }
+ * };
+ * fd = open( "/dev/adcgroup", O_RDONLY );
+ * ioctl( fd, ADS7924_IOCTL_GROUP_SET_MEMBERS, &group );
+ * ioctl( fd, ADS7924_IOCTL_GROUP_START );
+ * n = read( fd, aFrame, sizeof( aFrame ) );
+ * @endcode
+ * @{
+ */
+#define ADS7924_GROUP_MAX_MEMBERS 8   //!<@brief Maximum number of chips in the group.
+#define ADS7924_GROUP_MIN_PERIOD  500 //!<@brief Minimum frame period in microseconds.
+
+/*!
+ * @brief Identification of a chip: /dev/adc<bus><'A' + chip>
+ */
+typedef struct
+{
+   uint8_t  bus;   //!<@brief Number of the I2C-bus.
+   uint8_t  chip;  //!<@brief 0 (A) or 1 (B)
+   uint16_t dummy; //!<@brief Padding.
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_GROUP_MEMBER_T;
+
+/*!
+ * @brief Configuration of the group.
+ * @see ADS7924_IOCTL_GROUP_SET_MEMBERS
+ */
+typedef struct
+{
+   uint32_t               period; //!<@brief Frame period in microseconds.
+   uint32_t               count;  //!<@brief Number of valid members.
+   ADS7924_GROUP_MEMBER_T aMember[ADS7924_GROUP_MAX_MEMBERS];
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_GROUP_T;
+
+/*!
+ * @brief Values of one chip within a frame.
+ */
+typedef struct
+{
+   uint32_t skew;      //!<@brief Start of the scan after the one of the first member in ns.
+   uint32_t aDelay[4]; //!<@brief Conversion instant of each channel after ADS7924_FRAME_T::timestamp in ns.
+   uint16_t aValue[4]; //!<@brief Offset corrected analog values of channel 0 to 3.
+   uint8_t  bus;
+   uint8_t  chip;
+   uint16_t dummy;     //!<@brief Padding.
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_FRAME_MEMBER_T;
+
+/*!
+ * @brief Time-aligned frame of the group device.
+ *
+ * Conversion instant of channel c of member m:
+ * timestamp + aMember[m].aDelay[c]
+ */
+typedef struct
+{
+   uint64_t               timestamp; //!<@brief Start of the scan of the first member, CLOCK_MONOTONIC in ns.
+   uint32_t               sequence;  //!<@brief Frame counter, gaps mark lost frames.
+   uint32_t               count;     //!<@brief Number of valid members.
+   ADS7924_FRAME_MEMBER_T aMember[ADS7924_GROUP_MAX_MEMBERS];
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_FRAME_T;
+
+/*!
+ * @brief Statistics of the group since its last start.
+ * @see ADS7924_IOCTL_GROUP_GET_STATS
+ */
+typedef struct
+{
+   uint32_t frames;   //!<@brief Number of acquired frames.
+   uint32_t late;     //!<@brief Number of frame periods which has been missed.
+   uint32_t lost;     //!<@brief Number of frames lost by a full FIFO.
+   uint32_t errors;   //!<@brief Number of failed acquisitions.
+   uint32_t lastSkew; //!<@brief Skew between first and last member of the last frame in ns.
+   uint32_t maxSkew;  //!<@brief Maximum skew in ns.
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_GROUP_STATS_T;
+
+/*! @} End of defgroup GROUP */
+
+/*!
+ * @defgroup MERGE Aggregate stream of all channels
+ *
+ * The device /dev/adcall delivers the samples of all subscribed channels
+ * of all chips and I2C-buses in a single stream of records of type
+ * ADS7924_RECORD_T, ordered by their timestamps. So one reader can serve
+ * the whole board by a single file descriptor.
+ *
+ * The subscription is a bit mask of the minor numbers of the channel
+ * device files of type ADS7924_SUBSCRIPTION_T, bit n % 64 of aMask[n / 64]
+ * stands for the channel of minor number n (see "ls -l /dev/adc*"). The records are produced by the streaming
+ * mode or by the sequencer of the chips, which have to be started by
+ * the chip devices as usual; a subscribed channel is treated like an
+ * opened one.
+ *
+ * Each subscribed channel has its own queue of CONFIG_ADS7924_FIFO_SIZE
+ * records, read() merges the heads of these queues by a k-way merge.
+ * A record becomes released when no subscribed channel can deliver an
+ * older one anymore, or at the latest after CONFIG_ADS7924_MERGE_HOLD_BACK_MS
+ * (default 10 ms). So a subscribed but idle channel delays the stream by
+ * this time, and only records delayed by more than this time can appear
+ * out of order.
+ * When the queue of a channel is full its oldest record becomes dropped,
+ * this is visible as a gap in ADS7924_RECORD_T::sequence of the channel.
+ * The subscription becomes cleared when the last file descriptor of
+ * /dev/adcall becomes closed.
+ *
+ * Example:
+ * @code
+ * ADS7924_SUBSCRIPTION_T subscription = { { (1ULL << 2) | (1ULL << 3), // minor 2 and 3
+ *                                            1ULL << (70 - 64) } };    // minor 70
+ * fd = open( "/dev/adcall", O_RDONLY );
+ * ioctl( fd, ADS7924_IOCTL_MERGE_SET_SUBSCRIPTION, &subscription );
+ * n = read( fd, aRecord, sizeof( aRecord ) );
+ * @endcode
+ * @{
+ */
+
+/*!
+ * @brief Record of the aggregate stream.
+ */
+typedef struct
+{
+   uint64_t timestamp; //!<@brief Conversion instant, CLOCK_MONOTONIC in ns.
+   uint32_t sequence;  //!<@brief Record counter of the channel, gaps mark lost records.
+   uint16_t value;     //!<@brief Offset corrected analog value.
+   uint8_t  minor;     //!<@brief Minor number of the channel device file.
+   uint8_t  flags;     //!<@brief ADS7924_SAMPLE_RECONSTRUCTED and/or ADS7924_SAMPLE_OVERRUN
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_RECORD_T;
+
+/*!
+ * @brief Number of minor numbers which can be subscribed, minor numbers
+ *        of channels beyond are refused.
+ */
+#define ADS7924_MERGE_MAX_MINORS 128
+
+/*!
+ * @brief Subscription of the aggregate stream, bit n % 64 of aMask[n / 64]
+ *        stands for the channel of minor number n.
+ */
+typedef struct
+{
+   uint64_t aMask[ADS7924_MERGE_MAX_MINORS / 64];
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_SUBSCRIPTION_T;
+
+/*! @} End of defgroup MERGE */
+
+/*!
+ * @defgroup CAPTURE Pre- and post-trigger capture windows
+ *
+ * In the capture mode each sample of the channel, delivered by the
+ * streaming mode or by the sequencer of the chip, becomes kept in a
+ * circular pre-trigger history. When a sample leaves the window between
+ * ADS7924_CAPTURE_T::lower and ADS7924_CAPTURE_T::upper, the driver
+ * collects the given number of following samples and delivers the whole
+ * window as one record on the channel device file:
+ * A ADS7924_CAPTURE_RECORD_T followed by ADS7924_CAPTURE_RECORD_T::count
+ * samples of type ADS7924_SAMPLE_T.
+ *
+ * The condition is the one of the hardware alarm (see ADS7924_IOCTL_SET_ULR
+ * and ADS7924_IOCTL_SET_LLR) but in full 12-bit resolution. It becomes
+ * evaluated by software for each sample, because in the streaming modes
+ * the interrupt line signals the data-ready events. Only the transition
+ * into the alarm zone is a trigger.
+ *
+ * The capture mode can be armed only whilst the streaming mode or the
+ * sequencer of the chip is running, otherwise ADS7924_IOCTL_SET_CAPTURE
+ * fails with EBUSY.
+ *
+ * Whilst the capture mode is active read() of the channel returns whole
+ * records only and blocks until a window is complete, unless O_NONBLOCK
+ * is set. When the streaming mode or the sequencer becomes stopped,
+ * a blocking read() returns 0. In ADS7924_CAPTURE_SINGLE the capture stops after the first
+ * window, in ADS7924_CAPTURE_CONTINUOUS it becomes re-armed after the
+ * record has been read. Triggers whilst a record waits for reading
+ * are counted in ADS7924_CAPTURE_RECORD_T::missed.
+ *
+ * Example:
+ * @code
+ * ADS7924_CAPTURE_T capture =
+ * {
+ *    .mode        = ADS7924_CAPTURE_SINGLE,
+ *    .preTrigger  = 100,
+ *    .postTrigger = 50,
+ *    .upper       = 3500,
+ *    .lower       = 500
+ * };
+ * ioctl( fdChip, ADS7924_IOCTL_SET_STREAMING, ADS7924_STREAM_CONVERSION );
+ * ioctl( fd, ADS7924_IOCTL_SET_CAPTURE, &capture );
+ * n = read( fd, buffer, sizeof( buffer ) );
+ * @endcode
+ * @{
+ */
+#define ADS7924_CAPTURE_OFF        0 //!<@brief Capture mode off (default).
+#define ADS7924_CAPTURE_SINGLE     1 //!<@brief Capture of one window.
+#define ADS7924_CAPTURE_CONTINUOUS 2 //!<@brief Re-arming after each read window.
+
+/*!
+ * @brief Maximum of preTrigger + postTrigger + 1.
+ */
+#define ADS7924_CAPTURE_MAX_SAMPLES 1024
+
+/*!
+ * @brief Configuration of the capture mode.
+ * @see ADS7924_IOCTL_SET_CAPTURE
+ */
+typedef struct
+{
+   uint8_t  mode;        //!<@brief ADS7924_CAPTURE_OFF, _SINGLE or _CONTINUOUS
+   uint8_t  dummy;       //!<@brief Padding.
+   uint16_t preTrigger;  //!<@brief Number of samples before the trigger sample.
+   uint16_t postTrigger; //!<@brief Number of samples after the trigger sample.
+   uint16_t upper;       //!<@brief Trigger if a value becomes greater.
+   uint16_t lower;       //!<@brief Trigger if a value becomes smaller.
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_CAPTURE_T;
+
+/*!
+ * @brief Header of a capture window, followed by count samples of
+ *        type ADS7924_SAMPLE_T.
+ */
+typedef struct
+{
+   uint64_t timestamp;    //!<@brief Timestamp of the trigger sample.
+   uint32_t sequence;     //!<@brief Window counter since arming.
+   uint32_t missed;       //!<@brief Triggers lost since the previous window.
+   uint16_t count;        //!<@brief Number of the following samples.
+   uint16_t triggerIndex; //!<@brief Index of the trigger sample.
+   uint32_t dummy;        //!<@brief Padding.
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_CAPTURE_RECORD_T;
+
+/*! @} End of defgroup CAPTURE */
+
+/*!
+ * @defgroup VIRTUAL Virtual derived channels
+ *
+ * Each chip has CONFIG_ADS7924_VIRTUAL_CHANNELS virtual channels with the
+ * device files /dev/adc<bus><chip>v<n>. A virtual channel combines two
+ * channels A and B of the same chip by a fixed-point expression:
+ *
+ * ADS7924_VIRTUAL_LINEAR (sum, difference, weighted mean):
+ * @code
+ * value = (gainA * A + gainB * B + offset) >> shift
+ * @endcode
+ * ADS7924_VIRTUAL_RATIO (ratiometric sensors):
+ * @code
+ * value = ((gainA * A + offset) << shift) / (gainB * B)
+ * @endcode
+ *
+ * Both inputs are taken from the same burst-read of the four data
+ * registers: In ADS7924_STREAM_SCAN from the scan harvested by the
+ * interrupt, otherwise by a single I2C-transfer when read() becomes
+ * invoked. So the inputs are time-coherent and a consumer needs one read
+ * instead of two. Without ADS7924_STREAM_SCAN read() starts a manual scan
+ * before and restores the mode afterwards, in the automatic scan modes
+ * too, because a read of their data registers could straddle two scans.
+ * Whilst the sequencer or a group owns the mode read() fails with EBUSY.
+ *
+ * read() returns the value as ASCII-decimal line, the binary sample
+ * including timestamp is available by ADS7924_IOCTL_VIRTUAL_GET_SAMPLE.
+ * Whilst the chip is streaming in ADS7924_STREAM_SCAN, read() waits for
+ * the next scan unless O_NONBLOCK is set.
+ *
+ * Example: Difference of channel 1 and 0.
+ * @code
+ * ADS7924_VIRTUAL_T virt =
+ * {
+ *    .operation = ADS7924_VIRTUAL_LINEAR,
+ *    .channelA  = 1, .gainA = 1,
+ *    .channelB  = 0, .gainB = -1
+ * };
+ * fd = open( "/dev/adc1Av0", O_RDWR );
+ * ioctl( fd, ADS7924_IOCTL_VIRTUAL_SET, &virt );
+ * @endcode
+ * @{
+ */
+#define ADS7924_VIRTUAL_OFF    0 //!<@brief Virtual channel not defined (default).
+#define ADS7924_VIRTUAL_LINEAR 1 //!<@brief Linear combination of A and B.
+#define ADS7924_VIRTUAL_RATIO  2 //!<@brief Ratio of A and B.
+
+/*!
+ * @brief Flag in ADS7924_VIRTUAL_SAMPLE_T::flags: The divisor was zero.
+ */
+#define ADS7924_VIRTUAL_INVALID (1 << 7)
+
+/*!
+ * @brief Definition of a virtual channel.
+ * @see ADS7924_IOCTL_VIRTUAL_SET
+ */
+typedef struct
+{
+   uint8_t  operation; //!<@brief ADS7924_VIRTUAL_OFF, _LINEAR or _RATIO
+   uint8_t  channelA;  //!<@brief Channel number 0 to 3 of input A.
+   uint8_t  channelB;  //!<@brief Channel number 0 to 3 of input B.
+   uint8_t  shift;     //!<@brief Number of fraction bits of the gains, at most 24.
+   int16_t  gainA;
+   int16_t  gainB;
+   int32_t  offset;
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_VIRTUAL_T;
+
+/*!
+ * @brief Value of a virtual channel including its timestamp.
+ * @see ADS7924_IOCTL_VIRTUAL_GET_SAMPLE
+ */
+typedef struct
+{
+   uint64_t timestamp; //!<@brief Mean conversion instant of A and B, CLOCK_MONOTONIC in ns.
+   int32_t  value;
+   uint8_t  number;    //!<@brief Number of the virtual channel.
+   uint8_t  flags;     //!<@brief ADS7924_SAMPLE_RECONSTRUCTED and/or ADS7924_VIRTUAL_INVALID
+   uint16_t dummy;     //!<@brief Padding.
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_VIRTUAL_SAMPLE_T;
+
+/*! @} End of defgroup VIRTUAL */
+
+/*!
+ * @defgroup PIPELINE Processing pipeline of a channel
+ *
+ * Each channel has a pipeline of up to ADS7924_PIPELINE_MAX_STAGES stages
+ * which run in the given order on each new sample, once in the driver
+ * and before any consumer gets the sample: The result of read() and
+ * ADS7924_IOCTL_GET_SAMPLE, the streaming FIFO, the aggregate device and
+ * the capture mode. A stage either modifies the value or drops the whole
+ * sample, then the following stages and the consumers don't see it.
+ * For polling reads a dropped sample leaves the previous result valid.
+ *
+ * The pipeline works in the raw 12-bit domain, so the conversion into
+ * engineering units by ADS7924_IOCTL_READMODE_SCALED remains applicable.
+ *
+ * Stages:
+ * - ADS7924_STAGE_CALIBRATE: value = ((value * arg0) >> 16) + arg1,
+ *   limited to ADS7924_MIN_VALUE..ADS7924_MAX_VALUE.
+ * - ADS7924_STAGE_FILTER: Filter kind arg0:
+ *   - ADS7924_FILTER_AVERAGE: Moving average over arg1 samples, at most
+ *     ADS7924_FILTER_MAX_LENGTH.
+ *   - ADS7924_FILTER_MEDIAN: Median of the last arg1 samples, arg1 is
+ *     3, 5 or 7. Removes single-sample spikes completely.
+ *   - ADS7924_FILTER_IIR: First order low-pass
+ *     y += (x - y) / 2^arg1, arg1 is 1 to ADS7924_FILTER_MAX_SHIFT.
+ * - ADS7924_STAGE_DECIMATE: Passes each arg0-th sample only.
+ * - ADS7924_STAGE_THRESHOLD: Passes samples outside of arg0..arg1 only.
+ * - ADS7924_STAGE_DEADBAND: Passes a sample only if it differs from the
+ *   last passed one by more than arg0.
+ *
+ * The effort of each stage is constant per sample. If
+ * ADS7924_STAGE_T::budget isn't zero the driver measures the execution
+ * time of the stage and counts the exceedings of the budget in
+ * ADS7924_STAGE_STATS_T::overBudget.
+ *
+ * A median filter followed by a threshold stage suppresses the wakeups of
+ * the readers by single-sample spikes, also when the hardware alarm of
+ * ADS7924_IOCTL_SET_ULR and ADS7924_IOCTL_SET_LLR has been triggered by
+ * the spike: The sample becomes dropped and nobody becomes woken.
+ * @code
+ * ADS7924_PIPELINE_T pipeline =
+ * {
+ *    .count  = 2,
+ *    .aStage =
+ *    {
+ *       { .type = ADS7924_STAGE_FILTER, .arg0 = ADS7924_FILTER_MEDIAN, .arg1 = 5 },
+ *       { .type = ADS7924_STAGE_THRESHOLD, .arg0 = 500, .arg1 = 3500 }
+ *    }
+ * };
+ * @endcode
+ *
+ * Example: Average of 8 samples, reported on changes greater 2 LSB only.
+ * @code
+ * ADS7924_PIPELINE_T pipeline =
+ * {
+ *    .count  = 2,
+ *    .aStage =
+ *    {
+ *       { .type = ADS7924_STAGE_FILTER, .arg0 = ADS7924_FILTER_AVERAGE, .arg1 = 8 },
+ *       { .type = ADS7924_STAGE_DEADBAND, .arg0 = 2 }
+ *    }
+ * };
+ * ioctl( fd, ADS7924_IOCTL_SET_PIPELINE, &pipeline );
+ * @endcode
+ * @{
+ */
+#define ADS7924_STAGE_CALIBRATE 1 //!<@brief Gain and offset correction.
+#define ADS7924_STAGE_FILTER    2 //!<@brief Low pass filter.
+#define ADS7924_STAGE_DECIMATE  3 //!<@brief Reduction of the sample rate.
+#define ADS7924_STAGE_THRESHOLD 4 //!<@brief Passing of out of range samples only.
+#define ADS7924_STAGE_DEADBAND  5 //!<@brief Passing of changes only.
+
+#define ADS7924_FILTER_AVERAGE  0 //!<@brief Moving average, arg1: length.
+#define ADS7924_FILTER_MEDIAN   1 //!<@brief Median, arg1: length 3, 5 or 7.
+#define ADS7924_FILTER_IIR      2 //!<@brief First order IIR low-pass, arg1: shift.
+
+/*!
+ * @brief Maximum number of stages of a pipeline.
+ */
+#define ADS7924_PIPELINE_MAX_STAGES 8
+
+/*!
+ * @brief Maximum length of a filter in samples.
+ */
+#define ADS7924_FILTER_MAX_LENGTH 16
+
+/*!
+ * @brief Maximum coefficient shift of ADS7924_FILTER_IIR.
+ */
+#define ADS7924_FILTER_MAX_SHIFT  16
+
+/*!
+ * @brief Flag of ADS7924_SAMPLE_T: The value has been modified by the
+ *        pipeline.
+ */
+#define ADS7924_SAMPLE_PROCESSED (1 << 2)
+
+/*!
+ * @brief Definition of a single stage.
+ */
+typedef struct
+{
+   uint8_t  type;   //!<@brief ADS7924_STAGE_CALIBRATE ... ADS7924_STAGE_DEADBAND
+   uint8_t  dummy;  //!<@brief Padding.
+   uint16_t budget; //!<@brief Execution time budget in ns, 0: not measured.
+   int32_t  arg0;   //!<@brief First parameter, depends on type.
+   int32_t  arg1;   //!<@brief Second parameter, depends on type.
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_STAGE_T;
+
+/*!
+ * @brief Definition of the pipeline of a channel.
+ * @see ADS7924_IOCTL_SET_PIPELINE
+ * @see ADS7924_IOCTL_GET_PIPELINE
+ */
+typedef struct
+{
+   uint8_t         count; //!<@brief Number of used stages, 0: pipeline off.
+   uint8_t         dummy[3];
+   ADS7924_STAGE_T aStage[ADS7924_PIPELINE_MAX_STAGES];
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_PIPELINE_T;
+
+/*!
+ * @brief Counters of a single stage since the pipeline has been set.
+ */
+typedef struct
+{
+   uint32_t input;      //!<@brief Number of samples entering the stage.
+   uint32_t dropped;    //!<@brief Number of samples dropped by the stage.
+   uint32_t overBudget; //!<@brief Number of executions exceeding the budget.
+   uint32_t maxTime;    //!<@brief Longest measured execution time in ns.
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_STAGE_STATS_T;
+
+/*!
+ * @brief Counters of all stages of a pipeline.
+ * @see ADS7924_IOCTL_GET_PIPELINE_STATS
+ */
+typedef struct
+{
+   ADS7924_STAGE_STATS_T aStage[ADS7924_PIPELINE_MAX_STAGES];
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_PIPELINE_STATS_T;
+
+/*! @} End of defgroup PIPELINE */
+
+/*!
+ * @defgroup VALUES Shared page of the latest values
+ *
+ * The device /dev/adcvalues can be mapped read-only into the user-space.
+ * The page of type ADS7924_VALUES_T holds the latest value, timestamp and
+ * flags of each channel in the slot indexed by the minor number of the
+ * channel device. The driver updates a slot whenever a new result of the
+ * channel becomes published, in the interrupt thread, by the sequencer
+ * or by a read of any other process.
+ *
+ * Each slot is guarded like a sequence lock: The driver increments
+ * ADS7924_VALUE_SLOT_T::sequence before and after the update, so a odd
+ * sequence or a sequence which has changed during the reading marks a
+ * inconsistent copy which has to be read again. The function
+ * ads7924ReadValue() does this in the user-space without any system call
+ * and without any I2C-traffic.
+ *
+ * Example:
+ * @code
+ * struct stat st;
+ * ADS7924_SAMPLE_T sample;
+ * int fd = open( "/dev/adcvalues", O_RDONLY );
+ * const ADS7924_VALUES_T* pValues = mmap( NULL, sizeof( ADS7924_VALUES_T ),
+ *                                         PROT_READ, MAP_SHARED, fd, 0 );
+ * stat( "/dev/adc1A0", &st );
+ * if( ads7924ReadValue( pValues, minor( st.st_rdev ), &sample ) == 0 )
+ *    printf( "%u\n", sample.value );
+ * @endcode
+ * @{
+ */
+
+/*!
+ * @brief Content of ADS7924_VALUES_T::magic.
+ */
+#define ADS7924_VALUES_MAGIC 0x37393234 // "7924"
+
+/*!
+ * @brief Number of slots, so ADS7924_VALUES_T fills 4096 bytes.
+ */
+#define ADS7924_VALUES_SLOTS 255
+
+/*!
+ * @brief ADS7924_VALUE_SLOT_T::channel of a slot without channel.
+ */
+#define ADS7924_VALUES_UNUSED 0xFF
+
+/*!
+ * @brief Latest value of a single channel.
+ */
+typedef struct
+{
+   uint32_t sequence;  //!<@brief Odd whilst the driver updates the slot.
+   uint16_t value;     //!<@brief Analog value.
+   uint8_t  flags;     //!<@brief Flags like ADS7924_SAMPLE_T::flags
+   uint8_t  channel;   //!<@brief Channel number 0 to 3 or ADS7924_VALUES_UNUSED
+   uint64_t timestamp; //!<@brief Monotonic time (CLOCK_MONOTONIC) in nanoseconds.
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_VALUE_SLOT_T;
+
+/*!
+ * @brief Layout of the page of /dev/adcvalues.
+ */
+typedef struct
+{
+   uint32_t             magic;  //!<@brief ADS7924_VALUES_MAGIC
+   uint16_t             count;  //!<@brief Number of valid slots: highest channel minor + 1
+   uint16_t             dummy0; //!<@brief Padding.
+   uint64_t             dummy1; //!<@brief Padding.
+   ADS7924_VALUE_SLOT_T aSlot[ADS7924_VALUES_SLOTS];
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_VALUES_T;
+
+STATIC_ASSERT( sizeof( ADS7924_VALUES_T ) == 4096 );
+
+#if !defined( __KERNEL__ ) || defined(__DOXYGEN__)
+/*!
+ * @brief Reads a consistent copy of a slot of the mapped page.
+ * @param pValues Address of the mapped page.
+ * @param minor Minor number of the channel device.
+ * @param pSample Target of the value.
+ * @retval ==0 OK
+ * @retval <0  No channel with this minor number or no value yet.
+ */
+static inline int ads7924ReadValue( const ADS7924_VALUES_T* pValues,
+                                    unsigned int minor,
+                                    ADS7924_SAMPLE_T* pSample )
+{
+   const ADS7924_VALUE_SLOT_T* pSlot;
+   uint32_t sequence;
+
+   if( (minor >= pValues->count) || (minor >= ADS7924_VALUES_SLOTS) )
+      return -1;
+   pSlot = &pValues->aSlot[minor];
+   if( pSlot->channel == ADS7924_VALUES_UNUSED )
+      return -1;
+   do
+   {
+      sequence = __atomic_load_n( &pSlot->sequence, __ATOMIC_ACQUIRE );
+      pSample->value     = pSlot->value;
+      pSample->flags     = pSlot->flags;
+      pSample->timestamp = pSlot->timestamp;
+      __atomic_thread_fence( __ATOMIC_ACQUIRE );
+   }
+   while( ((sequence & 1) != 0) ||
+          (sequence != __atomic_load_n( &pSlot->sequence, __ATOMIC_RELAXED )) );
+   pSample->channel = pSlot->channel;
+   pSample->dummy   = 0;
+   return (sequence == 0)? -1 : 0;
+}
+#endif
+
+/*! @} End of defgroup VALUES */
+
+/*!----------------------------------------------------------------------------
+ * @defgroup ASYNC Asynchronous register access
+ *
+ * The ioctl-commands like ADS7924_IOCTL_SET_INTCONFIG block the caller
+ * until the I2C-transfer is done, even if the file has been opened by
+ * O_NONBLOCK. A event-loop can submit the same register operations by
+ * ADS7924_IOCTL_ASYNC_SUBMIT instead, which returns immediately with a
+ * token identifying the operation.
+ *
+ * A worker of each I2C-bus executes the submitted operations of all chips
+ * on this bus in the order of submission, operations of different buses
+ * run in parallel. Each completed operation becomes a result of type
+ * ADS7924_ASYNC_RESULT_T, which can be fetched by ADS7924_IOCTL_ASYNC_RESULT
+ * in the order of completion. poll() of the chip device reports POLLIN
+ * while at least one result is pending, additionally a eventfd registered
+ * by ADS7924_IOCTL_ASYNC_SET_EVENTFD becomes signaled by each completion.
+ *
+ * Operations and results belong to the file descriptor by which they
+ * have been submitted, close() waits for the operations still running.
+ *
+ * Example:
+ * @code
+ * ADS7924_ASYNC_T        request;
+ * ADS7924_ASYNC_RESULT_T result;
+ * struct pollfd          pfd;
+ *
+ * pfd.fd = open( "/dev/adc1A", O_RDWR | O_NONBLOCK );
+ * pfd.events = POLLIN;
+ * request.operation = ADS7924_ASYNC_EDIT;
+ * request.reg       = ADS7924_ASYNC_REG_INTCONFIG;
+ * request.value     = BUSY_nINT;
+ * request.clear     = 0;
+ * ioctl( pfd.fd, ADS7924_IOCTL_ASYNC_SUBMIT, &request );
+ * poll( &pfd, 1, -1 );
+ * while( ioctl( pfd.fd, ADS7924_IOCTL_ASYNC_RESULT, &result ) == 0 )
+ *    printf( "Token %u: %d\n", result.token, result.status );
+ * @endcode
  * @{
  */
-#define CALCNTL    (1 << 7)
-#define PWRCONPOL  (1 << 6)
-#define PWRCONEN   (1 << 5)
-#define PWRUPTIME4 (1 << 4)
-#define PWRUPTIME3 (1 << 3)
-#define PWRUPTIME2 (1 << 2)
-#define PWRUPTIME1 (1 << 1)
-#define PWRUPTIME0 (1 << 0)
-/*! @} End of defgroup PWR_CONFIG*/
+
+/*!
+ * @brief Operation of ADS7924_ASYNC_T: Reads the register.
+ */
+#define ADS7924_ASYNC_READ  0
+
+/*!
+ * @brief Operation of ADS7924_ASYNC_T: Writes ADS7924_ASYNC_T::value.
+ */
+#define ADS7924_ASYNC_WRITE 1
+
+/*!
+ * @brief Operation of ADS7924_ASYNC_T: Sets the bits of
+ *        ADS7924_ASYNC_T::value and clears the bits of ADS7924_ASYNC_T::clear
+ *        by a single read-modify-write. Not for ADS7924_ASYNC_REG_MODE.
+ */
+#define ADS7924_ASYNC_EDIT  2
+
+#define ADS7924_ASYNC_REG_MODE      0 //!<@brief Operation mode, see OP_MODES
+#define ADS7924_ASYNC_REG_INTCONFIG 1 //!<@brief see INT_CONFIG
+#define ADS7924_ASYNC_REG_SLPCONFIG 2 //!<@brief see SLEEP_CONF
+#define ADS7924_ASYNC_REG_ACQCONFIG 3 //!<@brief see ACQ_CONFIG
+#define ADS7924_ASYNC_REG_PWRCONFIG 4 //!<@brief see PWR_CONFIG
+
+/*!
+ * @brief Maximum number of operations of a file descriptor which are
+ *        submitted but whose result has not been fetched yet.
+ */
+#define ADS7924_ASYNC_MAX_OUTSTANDING 64
+
+/*!
+ * @brief Argument of ADS7924_IOCTL_ASYNC_SUBMIT
+ */
+typedef struct
+{
+   uint32_t token;     //!<@brief Output: Identifier of the operation.
+   uint8_t  operation; //!<@brief ADS7924_ASYNC_READ, ADS7924_ASYNC_WRITE or ADS7924_ASYNC_EDIT
+   uint8_t  reg;       //!<@brief ADS7924_ASYNC_REG_MODE ... ADS7924_ASYNC_REG_PWRCONFIG
+   uint8_t  value;     //!<@brief Value to write respectively bits to set by edit.
+   uint8_t  clear;     //!<@brief Bits to clear by edit.
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_ASYNC_T;
+
+/*!
+ * @brief Argument of ADS7924_IOCTL_ASYNC_RESULT
+ */
+typedef struct
+{
+   uint64_t timestamp; //!<@brief Time of completion (CLOCK_MONOTONIC) in nanoseconds.
+   uint32_t token;     //!<@brief Token given by ADS7924_IOCTL_ASYNC_SUBMIT
+   int32_t  status;    //!<@brief 0: OK, otherwise negative errno like -EIO or -EBUSY
+   uint8_t  operation; //!<@brief Copy of ADS7924_ASYNC_T::operation
+   uint8_t  reg;       //!<@brief Copy of ADS7924_ASYNC_T::reg
+   uint8_t  value;     //!<@brief Value read by ADS7924_ASYNC_READ, otherwise the submitted value.
+   uint8_t  dummy[5];  //!<@brief Padding.
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_ASYNC_RESULT_T;
+
+/*! @} End of defgroup ASYNC */
+
+/*!----------------------------------------------------------------------------
+ * @defgroup BATCH Register batches
+ *
+ * ADS7924_IOCTL_BATCH executes up to ADS7924_BATCH_SIZE register operations
+ * of a chip in the given order by a single system call and under a single
+ * hold of the I2C-lock of the chip, e.g. to apply a complete configuration.
+ * Consecutive entries of the same operation on ascending registers become
+ * merged into a single auto-increment transfer; a run of
+ * ADS7924_BATCH_EDIT entries needs one read and one write transfer.
+ *
+ * The registers are addressed by the register map of the data sheet.
+ * Permitted are ADS7924_REG_MODECNTRL and ADS7924_REG_ULR(0) up to
+ * ADS7924_REG_PWRCONFIG. INTCNTRL and the data registers are left out,
+ * because reading them acknowledges alarms respectively belongs to the
+ * channel devices.
+ *
+ * A invalid entry refuses the whole batch by EINVAL before any transfer.
+ * The execution stops at the first failed transfer: ADS7924_BATCH_T::done
+ * holds the number of successful entries and ADS7924_BATCH_ENTRY_T::status
+ * the result of each entry, -ECANCELED for the entries not executed.
+ *
+ * Example:
+ * @code
+ * ADS7924_BATCH_T batch =
+ * {
+ *    .count  = 4,
+ *    .aEntry =
+ *    {
+ *       { .operation = ADS7924_BATCH_WRITE, .reg = ADS7924_REG_ULR(0), .value = 0x01 },
+ *       { .operation = ADS7924_BATCH_WRITE, .reg = ADS7924_REG_LLR(0), .value = 0x02 },
+ *       { .operation = ADS7924_BATCH_WRITE, .reg = ADS7924_REG_SLPCONFIG, .value = 0x03 },
+ *       { .operation = ADS7924_BATCH_WRITE, .reg = ADS7924_REG_MODECNTRL,
+ *         .value = ADS7924_MODE_AUTO_SCAN }
+ *    }
+ * };
+ * ioctl( fd, ADS7924_IOCTL_BATCH, &batch );
+ * @endcode
+ * @{
+ */
+
+#define ADS7924_REG_MODECNTRL     0x00              //!<@brief ADC Mode Control Register
+#define ADS7924_REG_ULR( n )      (0x0A + 2 * (n))  //!<@brief Upper limit threshold of channel n
+#define ADS7924_REG_LLR( n )      (0x0B + 2 * (n))  //!<@brief Lower limit threshold of channel n
+#define ADS7924_REG_INTCONFIG     0x12              //!<@brief see INT_CONFIG
+#define ADS7924_REG_SLPCONFIG     0x13              //!<@brief see SLEEP_CONF
+#define ADS7924_REG_ACQCONFIG     0x14              //!<@brief see ACQ_CONFIG
+#define ADS7924_REG_PWRCONFIG     0x15              //!<@brief see PWR_CONFIG
+
+#define ADS7924_BATCH_READ  0 //!<@brief Reads the register into ADS7924_BATCH_ENTRY_T::value
+#define ADS7924_BATCH_WRITE 1 //!<@brief Writes ADS7924_BATCH_ENTRY_T::value
+#define ADS7924_BATCH_EDIT  2 //!<@brief Sets the bits of ::set and clears the bits of ::clear
+
+/*!
+ * @brief Maximum number of entries of a batch.
+ */
+#define ADS7924_BATCH_SIZE 32
+
+/*!
+ * @brief A single register operation of ADS7924_BATCH_T
+ */
+typedef struct
+{
+   uint8_t operation; //!<@brief ADS7924_BATCH_READ, ADS7924_BATCH_WRITE or ADS7924_BATCH_EDIT
+   uint8_t reg;       //!<@brief Register address ADS7924_REG_...
+   uint8_t set;       //!<@brief Bits to set by ADS7924_BATCH_EDIT
+   uint8_t clear;     //!<@brief Bits to clear by ADS7924_BATCH_EDIT
+   uint8_t value;     //!<@brief In: value to write. Out: register content after the operation.
+   uint8_t dummy;     //!<@brief Padding.
+   int16_t status;    //!<@brief Out: 0 or negative errno.
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_BATCH_ENTRY_T;
+
+STATIC_ASSERT( sizeof( ADS7924_BATCH_ENTRY_T ) == 8 );
+
+/*!
+ * @brief Argument of ADS7924_IOCTL_BATCH
+ */
+typedef struct
+{
+   uint32_t              count; //!<@brief Number of valid entries.
+   uint32_t              done;  //!<@brief Out: Number of successful entries.
+   ADS7924_BATCH_ENTRY_T aEntry[ADS7924_BATCH_SIZE];
+}
+#ifndef __DOXYGEN__
+__attribute__ ((packed))
+#endif
+ADS7924_BATCH_T;
+
+/*! @} End of defgroup BATCH */
+
+/*!
+ * @brief Minimum confidence of the scan rate estimation to correct the
+ *        timestamps.
+ * @see ADS7924_SCAN_RATE_T
+ */
+#define ADS7924_DRIFT_MIN_CONFIDENCE 500
+
+/*!
+ * @brief Flag of ADS7924_SAMPLE_T: Timestamp is reconstructed by the
+ *        timing model, otherwise it is the time of reading.
+ */
+#define ADS7924_SAMPLE_RECONSTRUCTED (1 << 0)
 
 /*!----------------------------------------------------------------------------
  * Begin of ioctl-commands
@@ -365,6 +1678,127 @@ STATIC_ASSERT( sizeof( ADS7924_BIT_EDIT_T ) == 2 );
  */
 #define ADS7924_IOCTL_EDIT_PWRCONFIG   _IOW( ADS7924_IOCTL_MAGIC, 14, ADS7924_BIT_EDIT_T )
 
+/*!
+ * @brief Sets the interval in milliseconds of the automatic offset
+ *        calibration, 0 disables it.
+ * @see OFFSET_CALIBRATION
+ */
+#define ADS7924_IOCTL_SET_OFFSET_CAL_INTERVAL _IOW( ADS7924_IOCTL_MAGIC, 15, uint32_t )
+
+/*!
+ * @brief Performs a offset calibration immediately.
+ * @see OFFSET_CALIBRATION
+ */
+#define ADS7924_IOCTL_OFFSET_CALIBRATE _IO( ADS7924_IOCTL_MAGIC, 16 )
+
+/*!
+ * @brief Returns the history of the last offset calibrations.
+ * @see OFFSET_CALIBRATION
+ * @see ADS7924_OFFSET_HISTORY_T
+ */
+#define ADS7924_IOCTL_GET_OFFSET_HISTORY _IOR( ADS7924_IOCTL_MAGIC, 17, ADS7924_OFFSET_HISTORY_T )
+
+/*!
+ * @brief Programs SLPCONFIG, ACQCONFIG, PWRCONFIG and the mode for the
+ *        sample-rate closest to the requested one.
+ *
+ * The timing bits becomes calculated by the timing model of the datasheet,
+ * all other bits of the configuration registers remain unchanged.
+ * @see ADS7924_RATE_T
+ */
+#define ADS7924_IOCTL_SET_RATE         _IOWR( ADS7924_IOCTL_MAGIC, 18, ADS7924_RATE_T )
+
+/*!
+ * @brief Returns the measured scan rate of the chip.
+ * @see ADS7924_SCAN_RATE_T
+ */
+#define ADS7924_IOCTL_GET_SCAN_RATE    _IOR( ADS7924_IOCTL_MAGIC, 19, ADS7924_SCAN_RATE_T )
+
+/*!
+ * @brief Enables (1) or disables (0) the correction of the timestamps by
+ *        the measured scan rate.
+ *
+ * The correction becomes only applied when the confidence of the
+ * estimation is at least ADS7924_DRIFT_MIN_CONFIDENCE.
+ * @see ADS7924_SCAN_RATE_T
+ * @see ADS7924_SAMPLE_T
+ */
+#define ADS7924_IOCTL_SET_DRIFT_CORRECTION _IOW( ADS7924_IOCTL_MAGIC, 20, uint32_t )
+
+/*!
+ * @brief Sets the streaming mode of the chip.
+ * @see STREAMING
+ */
+#define ADS7924_IOCTL_SET_STREAMING    _IOW( ADS7924_IOCTL_MAGIC, 21, uint8_t )
+
+/*!
+ * @brief Returns the streaming mode of the chip.
+ * @see STREAMING
+ */
+#define ADS7924_IOCTL_GET_STREAMING    _IOR( ADS7924_IOCTL_MAGIC, 22, uint8_t )
+
+/*!
+ * @brief Sets the mode of the channel sequencer of the driver.
+ * @see SEQUENCER
+ */
+#define ADS7924_IOCTL_SET_SEQUENCER    _IOW( ADS7924_IOCTL_MAGIC, 23, uint8_t )
+
+/*!
+ * @brief Returns the mode of the channel sequencer of the driver.
+ * @see SEQUENCER
+ */
+#define ADS7924_IOCTL_GET_SEQUENCER    _IOR( ADS7924_IOCTL_MAGIC, 24, uint8_t )
+
+/*!
+ * @brief Sets the schedule table of the sequencer, refused by EBUSY
+ *        whilst the sequencer runs in ADS7924_SEQ_SCHEDULE.
+ * @see SEQUENCER
+ * @see ADS7924_SCHEDULE_T
+ */
+#define ADS7924_IOCTL_SET_SCHEDULE     _IOW( ADS7924_IOCTL_MAGIC, 25, ADS7924_SCHEDULE_T )
+
+/*!
+ * @brief Returns the jitter and deadline-miss statistics of the schedule
+ *        since the last start of ADS7924_SEQ_SCHEDULE.
+ * @see SEQUENCER
+ * @see ADS7924_SCHEDULE_STATS_T
+ */
+#define ADS7924_IOCTL_GET_SCHEDULE_STATS _IOR( ADS7924_IOCTL_MAGIC, 26, ADS7924_SCHEDULE_STATS_T )
+
+/*!
+ * @brief Submits a register operation to the worker of the bus and returns
+ *        its token in ADS7924_ASYNC_T::token without waiting.
+ *
+ * Fails with EINVAL by a invalid operation or register and with EAGAIN
+ * if ADS7924_ASYNC_MAX_OUTSTANDING results are outstanding.
+ * @see ASYNC
+ */
+#define ADS7924_IOCTL_ASYNC_SUBMIT     _IOWR( ADS7924_IOCTL_MAGIC, 27, ADS7924_ASYNC_T )
+
+/*!
+ * @brief Fetches the oldest result of the completed operations,
+ *        fails with EAGAIN if none is pending.
+ * @see ASYNC
+ */
+#define ADS7924_IOCTL_ASYNC_RESULT     _IOR( ADS7924_IOCTL_MAGIC, 28, ADS7924_ASYNC_RESULT_T )
+
+/*!
+ * @brief Registers the eventfd given by value as third argument of ioctl()
+ *        which becomes signaled by each completion, -1 removes it.
+ * @see ASYNC
+ */
+#define ADS7924_IOCTL_ASYNC_SET_EVENTFD _IOW( ADS7924_IOCTL_MAGIC, 29, int32_t )
+
+/*!
+ * @brief Executes the register operations of ADS7924_BATCH_T in one go.
+ *
+ * Fails with EINVAL by a invalid entry, with EBUSY if the batch changes
+ * MODECNTRL whilst the sequencer or a group owns the mode and with EIO by
+ * a failed transfer.
+ * @see BATCH
+ */
+#define ADS7924_IOCTL_BATCH            _IOWR( ADS7924_IOCTL_MAGIC, 90, ADS7924_BATCH_T )
+
 /*! @} End of defgroup IOCTL_CHIP */
 
 /*!----------------------------------------------------------------------------
@@ -430,7 +1864,206 @@ STATIC_ASSERT( sizeof( ADS7924_BIT_EDIT_T ) == 2 );
  */
 #define ADS7924_IOCTL_ALARM_DISABLE    _IO( ADS7924_IOCTL_MAGIC, 38 )
 
+/*!
+ * @brief Sets the read-output mode in calibrated ASCII-decimal format.
+ * @see CALIBRATION
+ * @see ADS7924_IOCTL_SET_CALIBRATION
+ */
+#define ADS7924_IOCTL_READMODE_SCALED  _IO( ADS7924_IOCTL_MAGIC, 39 )
+
+/*!
+ * @brief Sets the calibration of this channel.
+ * @see CALIBRATION
+ * @see ADS7924_CALIBRATION_T
+ * @see ADS7924_IOCTL_GET_CALIBRATION
+ */
+#define ADS7924_IOCTL_SET_CALIBRATION  _IOW( ADS7924_IOCTL_MAGIC, 40, ADS7924_CALIBRATION_T )
+
+/*!
+ * @brief Returns the current calibration of this channel.
+ * @see CALIBRATION
+ * @see ADS7924_CALIBRATION_T
+ * @see ADS7924_IOCTL_SET_CALIBRATION
+ */
+#define ADS7924_IOCTL_GET_CALIBRATION  _IOR( ADS7924_IOCTL_MAGIC, 41, ADS7924_CALIBRATION_T )
+
+/*!
+ * @brief Sets the read-output mode in binary format of ADS7924_SAMPLE_T,
+ *        value including timestamp.
+ * @see ADS7924_SAMPLE_T
+ */
+#define ADS7924_IOCTL_READMODE_SAMPLE  _IO( ADS7924_IOCTL_MAGIC, 42 )
+
+/*!
+ * @brief Returns the last analog value of this channel including its
+ *        timestamp.
+ * @see ADS7924_SAMPLE_T
+ */
+#define ADS7924_IOCTL_GET_SAMPLE       _IOR( ADS7924_IOCTL_MAGIC, 43, ADS7924_SAMPLE_T )
+
+/*!
+ * @brief Sets the read policy of this channel, one of ADS7924_FRESH_READ_OFF,
+ *        ADS7924_FRESH_READ_CONVERSION or ADS7924_FRESH_READ_NEXT_SCAN.
+ *
+ * If not ADS7924_FRESH_READ_OFF and the chip isn't in a automatic mode,
+ * each read() and
+ * ADS7924_IOCTL_GET_SAMPLE switches the chip for a single conversion of
+ * this channel in ADS7924_MODE_MANUAL_SINGLE, waits for the conversion
+ * time by ACQCONFIG, reads the result and restores the previous mode.
+ * So the chip can remain in ADS7924_MODE_IDLE between the reads.
+ * Concurrent requests becomes coalesced.
+ * By ADS7924_FRESH_READ_NEXT_SCAN and a automatic mode each request waits
+ * for the next conversion of this channel.
+ * @see FRESH_READ
+ */
+#define ADS7924_IOCTL_SET_FRESH_READ   _IOW( ADS7924_IOCTL_MAGIC, 44, uint8_t )
+
+/*!
+ * @brief Sets and arms the capture mode, a pending window becomes
+ *        discarded.
+ *
+ * Fails with EINVAL if preTrigger + postTrigger + 1 exceeds
+ * ADS7924_CAPTURE_MAX_SAMPLES or lower isn't smaller than upper.
+ * @see CAPTURE
+ * @see ADS7924_CAPTURE_T
+ */
+#define ADS7924_IOCTL_SET_CAPTURE      _IOW( ADS7924_IOCTL_MAGIC, 45, ADS7924_CAPTURE_T )
+
+/*!
+ * @brief Sets the processing pipeline of this channel, the state of the
+ *        stages and their counters becomes reset.
+ *
+ * Fails with EINVAL by a unknown stage type or a invalid parameter.
+ * @see PIPELINE
+ * @see ADS7924_PIPELINE_T
+ */
+#define ADS7924_IOCTL_SET_PIPELINE     _IOW( ADS7924_IOCTL_MAGIC, 46, ADS7924_PIPELINE_T )
+
+/*!
+ * @brief Returns the processing pipeline of this channel.
+ * @see PIPELINE
+ */
+#define ADS7924_IOCTL_GET_PIPELINE     _IOR( ADS7924_IOCTL_MAGIC, 47, ADS7924_PIPELINE_T )
+
+/*!
+ * @brief Returns the counters of the stages of this channel.
+ * @see PIPELINE
+ * @see ADS7924_PIPELINE_STATS_T
+ */
+#define ADS7924_IOCTL_GET_PIPELINE_STATS _IOR( ADS7924_IOCTL_MAGIC, 48, ADS7924_PIPELINE_STATS_T )
+
+/*!
+ * @brief Sets the wakeup condition of the readers of this channel in the
+ *        streaming mode and by the sequencer.
+ *
+ * Fails with EINVAL if the watermark is zero or exceeds
+ * CONFIG_ADS7924_FIFO_SIZE.
+ * @see ADS7924_WAKEUP_T
+ * @see STREAMING
+ */
+#define ADS7924_IOCTL_SET_WAKEUP       _IOW( ADS7924_IOCTL_MAGIC, 49, ADS7924_WAKEUP_T )
+
+/*
+ * The numbers 50 to 79 are used by the other devices,
+ * the channel commands continue by 80.
+ */
+
+/*!
+ * @brief Sets the maximum age in microseconds of the stored value which
+ *        read() and ADS7924_IOCTL_GET_SAMPLE return without I2C-transfer,
+ *        0 (default) switches the cached-read mode off.
+ *
+ * Takes effect with the read policy ADS7924_FRESH_READ_OFF only.
+ * @see FRESH_READ
+ */
+#define ADS7924_IOCTL_SET_MAX_AGE      _IOW( ADS7924_IOCTL_MAGIC, 80, uint32_t )
+
 /*! @} End of defgroup IOCTL_CHANNEL */
 
+/*!----------------------------------------------------------------------------
+ * @defgroup IOCTL_GROUP Ioctl-commands for the group device:
+ *                       /dev/adcgroup
+ * @see GROUP
+ * @{
+ */
+
+/*!
+ * @brief Sets the members and the frame period of the group,
+ *        refused by EBUSY whilst the group is running.
+ * @see ADS7924_GROUP_T
+ */
+#define ADS7924_IOCTL_GROUP_SET_MEMBERS _IOW( ADS7924_IOCTL_MAGIC, 50, ADS7924_GROUP_T )
+
+/*!
+ * @brief Starts the synchronized acquisition of the members.
+ */
+#define ADS7924_IOCTL_GROUP_START      _IO( ADS7924_IOCTL_MAGIC, 51 )
+
+/*!
+ * @brief Stops the synchronized acquisition and restores the previous
+ *        modes of the members.
+ */
+#define ADS7924_IOCTL_GROUP_STOP       _IO( ADS7924_IOCTL_MAGIC, 52 )
+
+/*!
+ * @brief Returns the statistics of the group since its last start.
+ * @see ADS7924_GROUP_STATS_T
+ */
+#define ADS7924_IOCTL_GROUP_GET_STATS  _IOR( ADS7924_IOCTL_MAGIC, 53, ADS7924_GROUP_STATS_T )
+
+/*! @} End of defgroup IOCTL_GROUP */
+
+/*!
+ * @defgroup IOCTL_MERGE Ioctl-commands for the aggregate device:
+ *                       /dev/adcall
+ * @see MERGE
+ * @{
+ */
+
+/*!
+ * @brief Sets the subscription mask, bit n % 64 of aMask[n / 64] stands
+ *        for the channel of minor number n.
+ *
+ * The queues of newly subscribed channels start empty.
+ * Bits of minor numbers which don't belong to a channel are refused
+ * by EINVAL.
+ */
+#define ADS7924_IOCTL_MERGE_SET_SUBSCRIPTION _IOW( ADS7924_IOCTL_MAGIC, 60, ADS7924_SUBSCRIPTION_T )
+
+/*!
+ * @brief Returns the current subscription mask.
+ */
+#define ADS7924_IOCTL_MERGE_GET_SUBSCRIPTION _IOR( ADS7924_IOCTL_MAGIC, 61, ADS7924_SUBSCRIPTION_T )
+
+/*! @} End of defgroup IOCTL_MERGE */
+
+/*!
+ * @defgroup IOCTL_VIRTUAL Ioctl-commands for the virtual channels:
+ *                         /dev/adc<bus><chip>v<n>
+ * @see VIRTUAL
+ * @{
+ */
+
+/*!
+ * @brief Defines the expression of the virtual channel.
+ *
+ * Fails with EINVAL by a invalid operation, channel number or shift and
+ * with ENODEV if a input channel isn't present.
+ */
+#define ADS7924_IOCTL_VIRTUAL_SET        _IOW( ADS7924_IOCTL_MAGIC, 70, ADS7924_VIRTUAL_T )
+
+/*!
+ * @brief Returns the definition of the virtual channel.
+ */
+#define ADS7924_IOCTL_VIRTUAL_GET        _IOR( ADS7924_IOCTL_MAGIC, 71, ADS7924_VIRTUAL_T )
+
+/*!
+ * @brief Returns a value of the virtual channel including its timestamp,
+ *        same behavior as read().
+ */
+#define ADS7924_IOCTL_VIRTUAL_GET_SAMPLE _IOR( ADS7924_IOCTL_MAGIC, 72, ADS7924_VIRTUAL_SAMPLE_T )
+
+/*! @} End of defgroup IOCTL_VIRTUAL */
+
 #endif /* ifndef _ADS7924IOCTL_H */
 /*================================== EOF ====================================*/
@@ -0,0 +1,318 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924merge.c
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Aggregate stream of all channels ordered by timestamp.
+ *
+ * Each subscribed channel has its own queue, which becomes filled in
+ * the order of the conversions by adcDeliverSample(). Because each queue
+ * is sorted by itself, read() of /dev/adcall has only to take the
+ * smallest head of all queues again and again (k-way merge).
+ *
+ * The smallest head is released only when no channel can deliver an
+ * older record anymore: Each channel remembers the timestamp of its
+ * newest record, which is the lower bound of its next one. The minimum
+ * of the heads of the filled queues and of these bounds of the empty
+ * queues is the watermark, only records up to the watermark become
+ * released. So that an idle channel can not stop the stream, a record
+ * older than CONFIG_ADS7924_MERGE_HOLD_BACK_MS becomes released
+ * regardless of the watermark; only a record delayed more than this
+ * time can appear out of order.
+ *
+ * @date 2026.10.18
+ * @see ads7924merge.h
+ * @see MERGE
+ */
+#include "ads7924merge.h"
+#include <linux/slab.h>
+
+#define MERGE_MASK (CONFIG_ADS7924_FIFO_SIZE - 1)
+#define MERGE_HOLD_BACK_NS ((u64)CONFIG_ADS7924_MERGE_HOLD_BACK_MS * NSEC_PER_MSEC)
+
+/*!
+ * @brief Browser-macro for all present channels.
+ */
+#define FOR_EACH_CHANNEL( pBus, chip, channel, pChannel )                      \
+   FOR_EACH_I2C_BUS( pBus )                                                    \
+      for( chip = 0; chip < ADC_CHIPS_PER_BUS; chip++ )                        \
+         if( pBus->paChip[chip] != NULL )                                      \
+            for( channel = 0; channel < ADC_CHANNELS_PER_CHIP; channel++ )     \
+               if( (pChannel = pBus->paChip[chip]->paChannel[channel]) != NULL )
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns true when the minor number of the channel is set in mask.
+ */
+static inline bool isInMask( const unsigned long* mask, ADC_CHANNEL_T* pChannel )
+{
+   return (pChannel->minor >= 0) && (pChannel->minor < ADS7924_MERGE_MAX_MINORS) &&
+          test_bit( pChannel->minor, mask );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Timer callback: The hold back of the oldest record has expired,
+ *        so read() and poll() have to re-evaluate the queues.
+ */
+static enum hrtimer_restart onHoldBackTimer( struct hrtimer* pTimer )
+{
+   MERGE_T* pMerge = container_of( pTimer, MERGE_T, oTimer );
+
+   wake_up_interruptible( &pMerge->oWaitQueue );
+   return HRTIMER_NORESTART;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924merge.h
+ */
+void _ADS7924_INIT adcInitMerge( MERGE_T* pMerge )
+{
+   pMerge->minor = -1;
+   atomic_set( &pMerge->openCounter, 0 );
+   mutex_init( &pMerge->oMutex );
+   init_waitqueue_head( &pMerge->oWaitQueue );
+   hrtimer_init( &pMerge->oTimer, CLOCK_MONOTONIC, HRTIMER_MODE_ABS );
+   pMerge->oTimer.function = onHoldBackTimer;
+   bitmap_zero( pMerge->mask, ADS7924_MERGE_MAX_MINORS );
+   pMerge->count = 0;
+   pMerge->level = 0;
+   pMerge->lost  = 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924merge.h
+ */
+void adcFreeMerge( MERGE_T* pMerge )
+{
+   BUS_T* pBus;
+   ADC_CHANNEL_T* pChannel;
+   int chip, channel;
+
+   hrtimer_cancel( &pMerge->oTimer );
+   mutex_lock( &pMerge->oMutex );
+   FOR_EACH_CHANNEL( pBus, chip, channel, pChannel )
+   {
+      pChannel->merge.subscribed = false;
+      kfree( pChannel->merge.paBuffer );
+      pChannel->merge.paBuffer = NULL;
+   }
+   bitmap_zero( pMerge->mask, ADS7924_MERGE_MAX_MINORS );
+   pMerge->count = 0;
+   WRITE_ONCE( pMerge->level, 0 );
+   mutex_unlock( &pMerge->oMutex );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924merge.h
+ */
+int adcSetSubscription( MERGE_T* pMerge, const unsigned long* pMask )
+{
+   BUS_T* pBus;
+   ADC_CHANNEL_T* pChannel;
+   DECLARE_BITMAP( mask, ADS7924_MERGE_MAX_MINORS );
+   DECLARE_BITMAP( found, ADS7924_MERGE_MAX_MINORS );
+   unsigned int level;
+   int chip, channel;
+   int ret = 0;
+
+   if( pMask != NULL )
+      bitmap_copy( mask, pMask, ADS7924_MERGE_MAX_MINORS );
+   else
+      bitmap_zero( mask, ADS7924_MERGE_MAX_MINORS );
+   bitmap_zero( found, ADS7924_MERGE_MAX_MINORS );
+
+   mutex_lock( &pMerge->oMutex );
+   FOR_EACH_CHANNEL( pBus, chip, channel, pChannel )
+   {
+      if( !isInMask( mask, pChannel ) )
+         continue;
+      __set_bit( pChannel->minor, found );
+      if( pChannel->merge.paBuffer != NULL )
+         continue;
+      pChannel->merge.paBuffer = kmalloc_array( CONFIG_ADS7924_FIFO_SIZE,
+                                                sizeof( ADS7924_RECORD_T ),
+                                                GFP_KERNEL );
+      if( pChannel->merge.paBuffer == NULL )
+      {
+         ERROR_MESSAGE( ": Unable to allocate merge queue of minor %d\n", pChannel->minor );
+         ret = -ENOMEM;
+         goto L_UNLOCK;
+      }
+   }
+   if( !bitmap_equal( found, mask, ADS7924_MERGE_MAX_MINORS ) )
+   {
+      bitmap_andnot( found, mask, found, ADS7924_MERGE_MAX_MINORS );
+      ERROR_MESSAGE( ": Subscription contains no channel minors: %*pbl\n",
+                     ADS7924_MERGE_MAX_MINORS, found );
+      ret = -EINVAL;
+      goto L_UNLOCK;
+   }
+
+   pMerge->count = 0;
+   level = 0;
+   FOR_EACH_CHANNEL( pBus, chip, channel, pChannel )
+   {
+      if( isInMask( mask, pChannel ) )
+      {
+         if( !pChannel->merge.subscribed )
+         {
+            pChannel->merge.head = 0;
+            pChannel->merge.tail = 0;
+            pChannel->merge.sequence = 0;
+            pChannel->merge.last = ktime_get_ns();
+            pChannel->merge.subscribed = true;
+         }
+         pMerge->apChannel[pMerge->count++] = pChannel;
+         level += pChannel->merge.head - pChannel->merge.tail;
+      }
+      else
+      {
+         pChannel->merge.subscribed = false;
+      }
+   }
+   bitmap_copy( pMerge->mask, mask, ADS7924_MERGE_MAX_MINORS );
+   WRITE_ONCE( pMerge->level, level );
+
+L_UNLOCK:
+   mutex_unlock( &pMerge->oMutex );
+   wake_up_interruptible( &pMerge->oWaitQueue );
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924merge.h
+ */
+void adcMergeSample( ADC_CHANNEL_T* pChannel, const ADS7924_SAMPLE_T* pSample )
+{
+   MERGE_T* pMerge = &g_data.merge;
+   ADS7924_RECORD_T* pRecord;
+
+   mutex_lock( &pMerge->oMutex );
+   if( !pChannel->merge.subscribed )
+   {
+      mutex_unlock( &pMerge->oMutex );
+      return;
+   }
+   if( (pChannel->merge.head - pChannel->merge.tail) >= CONFIG_ADS7924_FIFO_SIZE )
+   {
+      /* Queue full: The oldest record becomes dropped. */
+      pChannel->merge.tail++;
+      pChannel->merge.paBuffer[pChannel->merge.tail & MERGE_MASK].flags |= ADS7924_SAMPLE_OVERRUN;
+      WRITE_ONCE( pMerge->level, pMerge->level - 1 );
+      pMerge->lost++;
+   }
+   pRecord = &pChannel->merge.paBuffer[pChannel->merge.head & MERGE_MASK];
+   pRecord->timestamp = pSample->timestamp;
+   pRecord->sequence  = pChannel->merge.sequence++;
+   pRecord->value     = pSample->value;
+   pRecord->minor     = pChannel->minor;
+   pRecord->flags     = pSample->flags;
+   pChannel->merge.last = pSample->timestamp;
+   pChannel->merge.head++;
+   WRITE_ONCE( pMerge->level, pMerge->level + 1 );
+   mutex_unlock( &pMerge->oMutex );
+
+   wake_up_interruptible( &pMerge->oWaitQueue );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924merge.h
+ */
+unsigned int adcMergeLevel( MERGE_T* pMerge )
+{
+   return READ_ONCE( pMerge->level );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns the channel with the oldest releasable head or NULL when
+ *        all queues are empty or the oldest head has to be held back.
+ *
+ * A held back head arms oTimer for the expiry of its hold back, because
+ * no further record might come which wakes the readers.
+ * @note The merge mutex has to be held.
+ */
+static ADC_CHANNEL_T* getReleasable( MERGE_T* pMerge )
+{
+   ADC_CHANNEL_T* pChannel;
+   ADC_CHANNEL_T* pOldest = NULL;
+   u64 oldest    = U64_MAX;
+   u64 watermark = U64_MAX;
+   u64 timestamp;
+   unsigned int i;
+
+   for( i = 0; i < pMerge->count; i++ )
+   {
+      pChannel = pMerge->apChannel[i];
+      if( pChannel->merge.head == pChannel->merge.tail )
+      {
+         watermark = min( watermark, pChannel->merge.last );
+         continue;
+      }
+      timestamp = pChannel->merge.paBuffer[pChannel->merge.tail & MERGE_MASK].timestamp;
+      if( timestamp < oldest )
+      {
+         oldest  = timestamp;
+         pOldest = pChannel;
+      }
+   }
+   if( pOldest == NULL )
+      return NULL;
+   if( oldest <= watermark )
+      return pOldest;
+   if( (oldest + MERGE_HOLD_BACK_NS) <= ktime_get_ns() )
+      return pOldest;
+   hrtimer_start( &pMerge->oTimer, ns_to_ktime( oldest + MERGE_HOLD_BACK_NS ),
+                  HRTIMER_MODE_ABS );
+   return NULL;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924merge.h
+ */
+bool adcMergeReady( MERGE_T* pMerge )
+{
+   bool ready;
+
+   mutex_lock( &pMerge->oMutex );
+   ready = (getReleasable( pMerge ) != NULL);
+   mutex_unlock( &pMerge->oMutex );
+   return ready;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924merge.h
+ */
+unsigned int adcPopMerged( MERGE_T* pMerge, ADS7924_RECORD_T* paRecord,
+                           unsigned int max )
+{
+   ADC_CHANNEL_T* pOldest;
+   unsigned int n;
+
+   mutex_lock( &pMerge->oMutex );
+   for( n = 0; (n < max) && (pMerge->level != 0); n++ )
+   {
+      pOldest = getReleasable( pMerge );
+      if( pOldest == NULL )
+         break;
+      paRecord[n] = pOldest->merge.paBuffer[pOldest->merge.tail & MERGE_MASK];
+      pOldest->merge.tail++;
+      WRITE_ONCE( pMerge->level, pMerge->level - 1 );
+   }
+   mutex_unlock( &pMerge->oMutex );
+   return n;
+}
+
+/*================================== EOF ====================================*/
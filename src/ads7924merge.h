@@ -0,0 +1,102 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924merge.h
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Aggregate stream of all channels ordered by timestamp.
+ * @date 2026.10.18
+ * @see ads7924merge.c
+ * @see MERGE
+ */
+#ifndef _ADS7924MERGE_H
+#define _ADS7924MERGE_H
+
+#include "ads7924driver.h"
+
+/*!----------------------------------------------------------------------------
+ * @brief Initializes the aggregate object.
+ */
+extern void adcInitMerge( MERGE_T* pMerge );
+
+/*!----------------------------------------------------------------------------
+ * @brief Frees the merge queues of all channels, used when the driver
+ *        becomes unloaded.
+ */
+extern void adcFreeMerge( MERGE_T* pMerge );
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns true if the channel is subscribed by the aggregate
+ *        device, so its samples has to be produced even if the channel
+ *        device isn't open.
+ */
+static inline bool adcIsSubscribed( ADC_CHANNEL_T* pChannel )
+{
+   return pChannel->merge.subscribed;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns true when at least one channel is subscribed.
+ */
+static inline bool adcHasSubscription( MERGE_T* pMerge )
+{
+   return !bitmap_empty( pMerge->mask, ADS7924_MERGE_MAX_MINORS );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Replaces the subscription by the given bitmap of
+ *        ADS7924_MERGE_MAX_MINORS minor numbers, NULL clears it.
+ * @retval ==0 OK
+ * @retval <0  Error (-EINVAL or -ENOMEM)
+ */
+extern int adcSetSubscription( MERGE_T* pMerge, const unsigned long* pMask );
+
+/*!----------------------------------------------------------------------------
+ * @brief Appends a sample of a subscribed channel to its merge queue and
+ *        wakes the readers of the aggregate device.
+ */
+extern void adcMergeSample( ADC_CHANNEL_T* pChannel, const ADS7924_SAMPLE_T* pSample );
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns the number of queued records of all channels.
+ *
+ * Lockless snapshot, usable as condition of wait_event_interruptible().
+ */
+extern unsigned int adcMergeLevel( MERGE_T* pMerge );
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns true when adcPopMerged() would deliver at least one
+ *        record.
+ *
+ * Takes the merge mutex, so it is not usable as condition of
+ * wait_event_interruptible().
+ */
+extern bool adcMergeReady( MERGE_T* pMerge );
+
+/*!----------------------------------------------------------------------------
+ * @brief Moves up to max records in the order of their timestamps from
+ *        the merge queues to paRecord.
+ *
+ * Records newer than the watermark become held back up to
+ * CONFIG_ADS7924_MERGE_HOLD_BACK_MS, so the result can be 0 although
+ * adcMergeLevel() isn't.
+ * @return Number of moved records.
+ */
+extern unsigned int adcPopMerged( MERGE_T* pMerge, ADS7924_RECORD_T* paRecord,
+                                  unsigned int max );
+
+#endif /* ifndef _ADS7924MERGE_H */
+/*================================== EOF ====================================*/
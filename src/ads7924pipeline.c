@@ -0,0 +1,278 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924pipeline.c
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Processing pipeline of the samples of a channel.
+ *
+ * The stages becomes executed by the thread which delivers the sample,
+ * that is the interrupt thread, the sequencer or the reading process.
+ * Each stage has a constant effort per sample, the filter history is
+ * limited by ADS7924_FILTER_MAX_LENGTH.
+ *
+ * @date 2026.10.18
+ * @see ads7924pipeline.h
+ * @see PIPELINE
+ */
+#include "ads7924pipeline.h"
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924pipeline.h
+ */
+void _ADS7924_INIT adcInitPipeline( ADC_CHANNEL_T* pChannel )
+{
+   mutex_init( &pChannel->pipeline.oMutex );
+   memset( &pChannel->pipeline.config, 0, sizeof( pChannel->pipeline.config ) );
+   memset( &pChannel->pipeline.stats, 0, sizeof( pChannel->pipeline.stats ) );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Checks the parameters of a single stage.
+ */
+static bool isStageValid( const ADS7924_STAGE_T* pStage )
+{
+   switch( pStage->type )
+   {
+      case ADS7924_STAGE_CALIBRATE: return true;
+      case ADS7924_STAGE_FILTER:
+      {
+         switch( pStage->arg0 )
+         {
+            case ADS7924_FILTER_AVERAGE:
+               return (pStage->arg1 > 0) && (pStage->arg1 <= ADS7924_FILTER_MAX_LENGTH);
+            case ADS7924_FILTER_MEDIAN:
+               return (pStage->arg1 == 3) || (pStage->arg1 == 5) || (pStage->arg1 == 7);
+            case ADS7924_FILTER_IIR:
+               return (pStage->arg1 > 0) && (pStage->arg1 <= ADS7924_FILTER_MAX_SHIFT);
+         }
+         return false;
+      }
+      case ADS7924_STAGE_DECIMATE:  return pStage->arg0 > 0;
+      case ADS7924_STAGE_THRESHOLD: return pStage->arg0 <= pStage->arg1;
+      case ADS7924_STAGE_DEADBAND:  return pStage->arg0 >= 0;
+   }
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924pipeline.h
+ */
+int adcSetPipeline( ADC_CHANNEL_T* pChannel, const ADS7924_PIPELINE_T* pConfig )
+{
+   int i;
+
+   if( pConfig->count > ADS7924_PIPELINE_MAX_STAGES )
+   {
+      ERROR_MESSAGE( ": Too many stages: %u\n", pConfig->count );
+      return -EINVAL;
+   }
+   for( i = 0; i < pConfig->count; i++ )
+   {
+      if( !isStageValid( &pConfig->aStage[i] ) )
+      {
+         ERROR_MESSAGE( ": Invalid stage %d of type %u\n", i, pConfig->aStage[i].type );
+         return -EINVAL;
+      }
+   }
+
+   mutex_lock( &pChannel->pipeline.oMutex );
+   pChannel->pipeline.config = *pConfig;
+   memset( pChannel->pipeline.aState, 0, sizeof( pChannel->pipeline.aState ) );
+   memset( &pChannel->pipeline.stats, 0, sizeof( pChannel->pipeline.stats ) );
+   mutex_unlock( &pChannel->pipeline.oMutex );
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924pipeline.h
+ */
+void adcGetPipeline( ADC_CHANNEL_T* pChannel, ADS7924_PIPELINE_T* pConfig )
+{
+   mutex_lock( &pChannel->pipeline.oMutex );
+   *pConfig = pChannel->pipeline.config;
+   mutex_unlock( &pChannel->pipeline.oMutex );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924pipeline.h
+ */
+void adcGetPipelineStats( ADC_CHANNEL_T* pChannel, ADS7924_PIPELINE_STATS_T* pStats )
+{
+   mutex_lock( &pChannel->pipeline.oMutex );
+   *pStats = pChannel->pipeline.stats;
+   mutex_unlock( &pChannel->pipeline.oMutex );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Moving average over the last pStage->arg1 values.
+ *
+ * Until the history is filled the mean of the present values becomes
+ * returned.
+ */
+static s32 average( const ADS7924_STAGE_T* pStage, STAGE_STATE_T* pState, s32 value )
+{
+   unsigned int length = pStage->arg1;
+   unsigned int i = pState->index % length;
+
+   if( pState->index >= length )
+      pState->sum -= pState->aHistory[i];
+   pState->aHistory[i] = value;
+   pState->sum += value;
+   pState->index++;
+   return pState->sum / (s32)min( pState->index, length );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Median of the last pStage->arg1 values.
+ *
+ * The window of at most 7 values becomes sorted by insertion, until the
+ * history is filled the median of the present values becomes returned.
+ */
+static s32 median( const ADS7924_STAGE_T* pStage, STAGE_STATE_T* pState, s32 value )
+{
+   unsigned int length = pStage->arg1;
+   unsigned int n, i, j;
+   s32 aSorted[7];
+   s32 v;
+
+   pState->aHistory[pState->index % length] = value;
+   pState->index++;
+   n = min( pState->index, length );
+
+   for( i = 0; i < n; i++ )
+   {
+      v = pState->aHistory[i];
+      for( j = i; (j > 0) && (aSorted[j - 1] > v); j-- )
+         aSorted[j] = aSorted[j - 1];
+      aSorted[j] = v;
+   }
+   return aSorted[n / 2];
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief First order IIR low-pass: y += (x - y) >> pStage->arg1
+ *
+ * The accumulator in pState->sum holds y with arg1 fraction bits, so
+ * small steps doesn't get lost by the shift. It starts with the first
+ * value to avoid the settling from zero.
+ */
+static s32 lowPass( const ADS7924_STAGE_T* pStage, STAGE_STATE_T* pState, s32 value )
+{
+   unsigned int shift = pStage->arg1;
+
+   if( pState->index == 0 )
+      pState->sum = value << shift;
+   else
+      pState->sum += value - (pState->sum >> shift);
+   pState->index = 1;
+   return (pState->sum + (1 << (shift - 1))) >> shift;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Executes a single stage.
+ * @retval true  Value passed.
+ * @retval false Sample dropped.
+ */
+static bool runStage( const ADS7924_STAGE_T* pStage, STAGE_STATE_T* pState, s32* pValue )
+{
+   switch( pStage->type )
+   {
+      case ADS7924_STAGE_CALIBRATE:
+      {
+         *pValue = (s32)(((s64)*pValue * pStage->arg0) >> 16) + pStage->arg1;
+         *pValue = clamp_t( s32, *pValue, ADS7924_MIN_VALUE, ADS7924_MAX_VALUE );
+         return true;
+      }
+      case ADS7924_STAGE_FILTER:
+      {
+         switch( pStage->arg0 )
+         {
+            case ADS7924_FILTER_AVERAGE: *pValue = average( pStage, pState, *pValue ); break;
+            case ADS7924_FILTER_MEDIAN:  *pValue = median( pStage, pState, *pValue );  break;
+            case ADS7924_FILTER_IIR:     *pValue = lowPass( pStage, pState, *pValue ); break;
+         }
+         return true;
+      }
+      case ADS7924_STAGE_DECIMATE:
+      {
+         if( ++pState->counter < pStage->arg0 )
+            return false;
+         pState->counter = 0;
+         return true;
+      }
+      case ADS7924_STAGE_THRESHOLD:
+      {
+         return (*pValue < pStage->arg0) || (*pValue > pStage->arg1);
+      }
+      case ADS7924_STAGE_DEADBAND:
+      {
+         if( pState->hasLast && (abs( *pValue - pState->last ) <= pStage->arg0) )
+            return false;
+         pState->last = *pValue;
+         pState->hasLast = true;
+         return true;
+      }
+   }
+   return true;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924pipeline.h
+ */
+bool adcRunPipeline( ADC_CHANNEL_T* pChannel, ADS7924_SAMPLE_T* pSample )
+{
+   const ADS7924_STAGE_T* pStage;
+   ADS7924_STAGE_STATS_T* pStats;
+   s32 value = pSample->value;
+   bool passed = true;
+   u64 start = 0;
+   u32 time;
+   int i;
+
+   mutex_lock( &pChannel->pipeline.oMutex );
+   for( i = 0; passed && (i < pChannel->pipeline.config.count); i++ )
+   {
+      pStage = &pChannel->pipeline.config.aStage[i];
+      pStats = &pChannel->pipeline.stats.aStage[i];
+      pStats->input++;
+      if( pStage->budget != 0 )
+         start = ktime_get_ns();
+
+      passed = runStage( pStage, &pChannel->pipeline.aState[i], &value );
+
+      if( pStage->budget != 0 )
+      {
+         time = (u32)(ktime_get_ns() - start);
+         if( time > pStats->maxTime )
+            pStats->maxTime = time;
+         if( time > pStage->budget )
+            pStats->overBudget++;
+      }
+      if( !passed )
+         pStats->dropped++;
+   }
+   mutex_unlock( &pChannel->pipeline.oMutex );
+
+   if( passed && (value != pSample->value) )
+   {
+      pSample->value = value;
+      pSample->flags |= ADS7924_SAMPLE_PROCESSED;
+   }
+   return passed;
+}
+
+/*================================== EOF ====================================*/
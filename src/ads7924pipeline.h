@@ -0,0 +1,71 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924pipeline.h
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Processing pipeline of the samples of a channel.
+ * @date 2026.10.18
+ * @see ads7924pipeline.c
+ * @see PIPELINE
+ */
+#ifndef _ADS7924PIPELINE_H
+#define _ADS7924PIPELINE_H
+
+#include "ads7924driver.h"
+
+/*!----------------------------------------------------------------------------
+ * @brief Initializes the pipeline of the given channel as empty.
+ */
+extern void adcInitPipeline( ADC_CHANNEL_T* pChannel );
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns true if the pipeline of the channel has at least one stage.
+ */
+static inline bool adcHasPipeline( ADC_CHANNEL_T* pChannel )
+{
+   return pChannel->pipeline.config.count != 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Checks and sets a new pipeline, resets the states and the counters
+ *        of all stages.
+ * @retval ==0 OK
+ * @retval <0  Error (-EINVAL)
+ */
+extern int adcSetPipeline( ADC_CHANNEL_T* pChannel, const ADS7924_PIPELINE_T* pConfig );
+
+/*!----------------------------------------------------------------------------
+ * @brief Copies the current pipeline of the channel in pConfig.
+ */
+extern void adcGetPipeline( ADC_CHANNEL_T* pChannel, ADS7924_PIPELINE_T* pConfig );
+
+/*!----------------------------------------------------------------------------
+ * @brief Copies the counters of all stages of the channel in pStats.
+ */
+extern void adcGetPipelineStats( ADC_CHANNEL_T* pChannel, ADS7924_PIPELINE_STATS_T* pStats );
+
+/*!----------------------------------------------------------------------------
+ * @brief Runs the stages of the pipeline on the given sample.
+ * @param pChannel Pointer to the channel object.
+ * @param pSample Sample to process, the value becomes modified in place.
+ * @retval true  Sample has passed all stages.
+ * @retval false Sample has been dropped by a stage.
+ */
+extern bool adcRunPipeline( ADC_CHANNEL_T* pChannel, ADS7924_SAMPLE_T* pSample );
+
+#endif /* ifndef _ADS7924PIPELINE_H */
+/*================================== EOF ====================================*/
@@ -27,6 +27,16 @@
 #include "ads7924driver.h"
 #include "ads7924core.h"
 #include "ads7924fileIo.h"
+#include "ads7924calibration.h"
+#include "ads7924timing.h"
+#include "ads7924stream.h"
+#include "ads7924sequencer.h"
+#include "ads7924group.h"
+#include "ads7924merge.h"
+#include "ads7924capture.h"
+#include "ads7924virtual.h"
+#include "ads7924pipeline.h"
+#include "ads7924bus.h"
 #include "ads7924procFs.h"
 #include "ads7924_dev_tree_names.h"
 
@@ -47,6 +57,8 @@ static const char* getOutputFormatName( OUTPUT_FORMAT_T value )
       FORMAT_CASE_ITEM( OUT_BIN );
       FORMAT_CASE_ITEM( OUT_DEC );
       FORMAT_CASE_ITEM( OUT_HEX );
+      FORMAT_CASE_ITEM( OUT_SCALED );
+      FORMAT_CASE_ITEM( OUT_SAMPLE );
       default: BUG_ON( true );
    }
    return "not defined!";
@@ -60,6 +72,39 @@ typedef struct
 
 #define MODE_LIST_ITEM( m ) { .name = #m, .value = m }
 
+/*!
+ * @brief Names of the streaming modes.
+ * @see STREAMING
+ */
+static const char* mg_streamModeNames[] =
+{
+   [ADS7924_STREAM_OFF]        = "off",
+   [ADS7924_STREAM_CONVERSION] = "each conversion",
+   [ADS7924_STREAM_SCAN]       = "each scan"
+};
+
+/*!
+ * @brief Names of the sequencer modes.
+ * @see SEQUENCER
+ */
+static const char* mg_sequencerModeNames[] =
+{
+   [ADS7924_SEQ_OFF]         = "off",
+   [ADS7924_SEQ_ROUND_ROBIN] = "round-robin",
+   [ADS7924_SEQ_SCHEDULE]    = "schedule"
+};
+
+/*!
+ * @brief Suffixes of the read policies.
+ * @see FRESH_READ
+ */
+static const char* mg_freshReadNames[] =
+{
+   [ADS7924_FRESH_READ_OFF]        = "",
+   [ADS7924_FRESH_READ_CONVERSION] = ", on demand",
+   [ADS7924_FRESH_READ_NEXT_SCAN]  = ", next scan"
+};
+
 static const MODE_LIST_ITEM_T mg_modeList[] =
 {
    MODE_LIST_ITEM( ADS7924_MODE_IDLE ),
@@ -104,6 +149,10 @@ static inline void showIoctlCmds( struct seq_file* pSeqFile )
 {
    const IOC_CHIP_INFO_T*    pCurrentChipItem;
    const IOC_CHANNEL_INFO_T* pCurrentChannelItem;
+   const IOC_GROUP_INFO_T*   pCurrentGroupItem;
+   const IOC_MERGE_INFO_T*   pCurrentMergeItem;
+   const IOC_VIRTUAL_INFO_T* pCurrentVirtualItem;
+   const IOC_ASYNC_INFO_T*   pCurrentAsyncItem;
    int i;
 
    seq_printf( pSeqFile, "Possible modes:\n" );
@@ -122,6 +171,13 @@ static inline void showIoctlCmds( struct seq_file* pSeqFile )
                   pCurrentChipItem->number,
                   pCurrentChipItem->name );
    }
+   for( pCurrentAsyncItem = mg_fTabIoctrlAsync;
+       pCurrentAsyncItem->function != NULL; pCurrentAsyncItem++ )
+   {
+      seq_printf( pSeqFile, " 0x%08X:\t%s\n",
+                  pCurrentAsyncItem->number,
+                  pCurrentAsyncItem->name );
+   }
 
    seq_printf( pSeqFile, 
                "\nValid commands for ioctl() for single channel access:\n" );
@@ -132,6 +188,36 @@ static inline void showIoctlCmds( struct seq_file* pSeqFile )
                   pCurrentChannelItem->number,
                   pCurrentChannelItem->name );
    }
+
+   seq_printf( pSeqFile,
+               "\nValid commands for ioctl() for the group device:\n" );
+   for( pCurrentGroupItem = mg_fTabIoctrlGroup;
+       pCurrentGroupItem->function != NULL; pCurrentGroupItem++ )
+   {
+      seq_printf( pSeqFile, " 0x%08X:\t%s\n",
+                  pCurrentGroupItem->number,
+                  pCurrentGroupItem->name );
+   }
+
+   seq_printf( pSeqFile,
+               "\nValid commands for ioctl() for the aggregate device:\n" );
+   for( pCurrentMergeItem = mg_fTabIoctrlMerge;
+       pCurrentMergeItem->function != NULL; pCurrentMergeItem++ )
+   {
+      seq_printf( pSeqFile, " 0x%08X:\t%s\n",
+                  pCurrentMergeItem->number,
+                  pCurrentMergeItem->name );
+   }
+
+   seq_printf( pSeqFile,
+               "\nValid commands for ioctl() for the virtual channels:\n" );
+   for( pCurrentVirtualItem = mg_fTabIoctrlVirtual;
+       pCurrentVirtualItem->function != NULL; pCurrentVirtualItem++ )
+   {
+      seq_printf( pSeqFile, " 0x%08X:\t%s\n",
+                  pCurrentVirtualItem->number,
+                  pCurrentVirtualItem->name );
+   }
 }
 #endif /* ifdef CONFIG_ADS7924_SHOW_IOCTL_COMMANDS_IN_PROC_FS */
 
@@ -154,21 +240,278 @@ static inline const char* getGpioStatus( void )
 }
 #endif /* ifdef _ADS7924_NO_DEV_TREE */
 
+/*!----------------------------------------------------------------------------
+ * @brief Helper function for procOnOpen, shows the calibration of the
+ *        given channel.
+ * @see CALIBRATION
+ */
+static void showCalibration( struct seq_file* pSeqFile, ADC_CHANNEL_T* pChannel )
+{
+   ADS7924_CALIBRATION_T calibration;
+   unsigned int i;
+
+   adcGetCalibration( pChannel, &calibration );
+   if( calibration.numPoints == 0 )
+   {
+      seq_printf( pSeqFile, "\t\t\tCalibration: gain: %d/65536, offset: %d\n",
+                  calibration.gain, calibration.offset );
+      return;
+   }
+   seq_printf( pSeqFile, "\t\t\tCalibration:" );
+   for( i = 0; i < calibration.numPoints; i++ )
+   {
+      seq_printf( pSeqFile, " %u->%d",
+                  calibration.aPoint[i].raw, calibration.aPoint[i].scaled );
+   }
+   seq_printf( pSeqFile, "\n" );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Helper function for procOnOpen, shows the offset history of the
+ *        given chip.
+ * @see OFFSET_CALIBRATION
+ */
+static void showOffsetHistory( struct seq_file* pSeqFile, ADS7924_T* pChip )
+{
+   ADS7924_OFFSET_HISTORY_T history;
+   unsigned int i;
+
+   adcGetOffsetHistory( pChip, &history );
+   seq_printf( pSeqFile, "\t\tOffset calibration interval: %u ms\n", history.interval );
+   for( i = 0; i < history.count; i++ )
+   {
+      seq_printf( pSeqFile, "\t\t\t%llu ns: %d, %d, %d, %d\n",
+                  (unsigned long long)history.aEntry[i].timestamp,
+                  history.aEntry[i].offset[0],
+                  history.aEntry[i].offset[1],
+                  history.aEntry[i].offset[2],
+                  history.aEntry[i].offset[3] );
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Helper function for procOnOpen, shows the sample-rate per channel
+ *        calculated by the timing model from the given register snapshot.
+ * @see adcReadRegisterFile
+ * @see ADS7924_IOCTL_SET_RATE
+ */
+static void showTiming( struct seq_file* pSeqFile, const u8* paRegister )
+{
+   ADS7924_TIMING_T timing;
+
+   if( !adcCalculateTiming( &timing, paRegister[MODECNTRL], paRegister[SLPCONFIG],
+                            paRegister[ACQCONFIG], paRegister[PWRCONFIG] ) )
+   {
+      seq_printf( pSeqFile, "\t\tSample period: none\n" );
+      return;
+   }
+   seq_printf( pSeqFile, "\t\tSample period: %llu ns, conversion time: %u ns, slot: %llu ns\n",
+               (unsigned long long)timing.period, timing.convTime,
+               (unsigned long long)timing.slot );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Helper function for procOnOpen shows the measured scan rate.
+ * @see ADS7924_SCAN_RATE_T
+ */
+static void showScanRate( struct seq_file* pSeqFile, ADS7924_T* pChip )
+{
+   ADS7924_SCAN_RATE_T scanRate;
+
+   if( adcGetScanRate( pChip, &scanRate ) < 0 )
+   {
+      seq_printf( pSeqFile, "\t\tCouldn't read scan rate!\n" );
+      return;
+   }
+   if( scanRate.nominalPeriod == 0 )
+      return;
+   seq_printf( pSeqFile, "\t\tMeasured period: %llu ns, jitter: %llu ns, "
+                         "confidence: %u, correction: %s\n",
+               (unsigned long long)scanRate.measuredPeriod,
+               (unsigned long long)scanRate.jitter,
+               scanRate.confidence,
+               scanRate.correction? "on" : "off" );
+}
+
+/*!-----------------------------------------------------------------------------
+ * @brief Displays the schedule table of the sequencer and its statistics.
+ * @see SEQUENCER
+ */
+static void showSchedule( struct seq_file* pSeqFile, ADS7924_T* pChip )
+{
+   ADS7924_SCHEDULE_STATS_T stats;
+   int i;
+
+   if( pChip->sequencer.schedule.count == 0 )
+      return;
+   adcGetScheduleStats( pChip, &stats );
+   seq_printf( pSeqFile, "\t\tSchedule: period: %u us, ticks: %u, overruns: %u\n",
+               pChip->sequencer.schedule.period, stats.ticks, stats.overruns );
+   for( i = 0; i < pChip->sequencer.schedule.count; i++ )
+   {
+      seq_printf( pSeqFile, "\t\t\t%d: channel: %u, priority: %u, divider: %u, "
+                            "samples: %u, misses: %u, latency: %u/%u/%u ns, jitter: %u ns\n",
+                  i,
+                  pChip->sequencer.schedule.aEntry[i].channel,
+                  pChip->sequencer.schedule.aEntry[i].priority,
+                  pChip->sequencer.schedule.aEntry[i].divider,
+                  stats.aEntry[i].samples,
+                  stats.aEntry[i].misses,
+                  stats.aEntry[i].minLatency,
+                  stats.aEntry[i].meanLatency,
+                  stats.aEntry[i].maxLatency,
+                  stats.aEntry[i].jitter );
+   }
+}
+
+/*!-----------------------------------------------------------------------------
+ * @brief Displays the stages of the pipeline of a channel and their counters.
+ * @see PIPELINE
+ */
+static void showPipeline( struct seq_file* pSeqFile, ADC_CHANNEL_T* pChannel )
+{
+   static const char* const names[] =
+   {
+      "?", "calibrate", "filter", "decimate", "threshold", "deadband"
+   };
+   static const char* const filterNames[] = { "average", "median", "iir" };
+   ADS7924_PIPELINE_T config;
+   ADS7924_PIPELINE_STATS_T stats;
+   int i;
+
+   if( !adcHasPipeline( pChannel ) )
+      return;
+   adcGetPipeline( pChannel, &config );
+   adcGetPipelineStats( pChannel, &stats );
+   seq_printf( pSeqFile, "\t\t\tPipeline:\n" );
+   for( i = 0; i < config.count; i++ )
+   {
+      if( config.aStage[i].type == ADS7924_STAGE_FILTER )
+      {
+         seq_printf( pSeqFile, "\t\t\t\t%d: %s %s (%d), in: %u, "
+                               "max: %u ns, over budget: %u\n",
+                     i,
+                     names[ADS7924_STAGE_FILTER],
+                     filterNames[config.aStage[i].arg0],
+                     config.aStage[i].arg1,
+                     stats.aStage[i].input,
+                     stats.aStage[i].maxTime,
+                     stats.aStage[i].overBudget );
+         continue;
+      }
+      seq_printf( pSeqFile, "\t\t\t\t%d: %s (%d, %d), in: %u, dropped: %u, "
+                            "max: %u ns, over budget: %u\n",
+                  i,
+                  names[(config.aStage[i].type < ARRAY_SIZE( names ))? config.aStage[i].type : 0],
+                  config.aStage[i].arg0,
+                  config.aStage[i].arg1,
+                  stats.aStage[i].input,
+                  stats.aStage[i].dropped,
+                  stats.aStage[i].maxTime,
+                  stats.aStage[i].overBudget );
+   }
+}
+
+/*!-----------------------------------------------------------------------------
+ * @brief Displays the definitions of the virtual channels of a chip.
+ * @see VIRTUAL
+ */
+static void showVirtual( struct seq_file* pSeqFile, ADS7924_T* pChip )
+{
+   static const char* const names[] = { "off", "linear", "ratio" };
+   ADS7924_VIRTUAL_T definition;
+   int i;
+
+   for( i = 0; i < ARRAY_SIZE( pChip->aVirtual ); i++ )
+   {
+      adcGetVirtual( &pChip->aVirtual[i], &definition );
+      seq_printf( pSeqFile, "\t\t%s%d%cv%d: %s",
+                  g_data.pName,
+                  pChip->pParent->pI2cAdapter->nr,
+                  'A' + pChip->number,
+                  i,
+                  names[definition.operation] );
+      if( definition.operation != ADS7924_VIRTUAL_OFF )
+      {
+         seq_printf( pSeqFile, ", A: %u * %d, B: %u * %d, offset: %d, shift: %u",
+                     definition.channelA, definition.gainA,
+                     definition.channelB, definition.gainB,
+                     definition.offset, definition.shift );
+      }
+      seq_printf( pSeqFile, ", open-count: %d\n",
+                  atomic_read( &pChip->aVirtual[i].openCounter ) );
+   }
+}
+
+/*!-----------------------------------------------------------------------------
+ * @brief Displays the members and the statistics of the group device.
+ * @see GROUP
+ */
+static void showGroup( struct seq_file* pSeqFile )
+{
+   GROUP_T* pGroup = &g_data.group;
+   ADS7924_GROUP_STATS_T stats;
+   int i;
+
+   seq_printf( pSeqFile, "\n%sgroup: %s, open-count: %d\n", g_data.pName,
+               pGroup->running? "running" : "stopped",
+               atomic_read( &pGroup->openCounter ) );
+   if( pGroup->config.count == 0 )
+      return;
+   seq_printf( pSeqFile, "\tPeriod: %u us, members:", pGroup->config.period );
+   for( i = 0; i < pGroup->config.count; i++ )
+   {
+      seq_printf( pSeqFile, " %s%d%c", g_data.pName,
+                  pGroup->config.aMember[i].bus,
+                  'A' + pGroup->config.aMember[i].chip );
+   }
+   adcGetGroupStats( pGroup, &stats );
+   seq_printf( pSeqFile, "\n\tFrames: %u, late: %u, lost: %u, errors: %u, "
+                         "skew: %u ns, max. skew: %u ns, FIFO: %u\n",
+               stats.frames, stats.late, stats.lost, stats.errors,
+               stats.lastSkew, stats.maxSkew, adcGroupFifoLevel( pGroup ) );
+}
+
+/*!-----------------------------------------------------------------------------
+ * @brief Displays the queueing statistics of the priority classes of
+ *        the given bus.
+ * @see ads7924bus.h
+ */
+static void showBusScheduler( struct seq_file* pSeqFile, BUS_T* pBus )
+{
+   static const char* const apName[BUS_CLASSES] =
+   {
+      [BUS_CLASS_HARVEST] = "harvest",
+      [BUS_CLASS_USER]    = "user",
+      [BUS_CLASS_CONFIG]  = "config",
+      [BUS_CLASS_DIAG]    = "diagnostic"
+   };
+   BUS_CLASS_STATS_T aStats[BUS_CLASSES];
+   int i;
+
+   adcGetBusStats( pBus, aStats );
+   for( i = 0; i < BUS_CLASSES; i++ )
+   {
+      seq_printf( pSeqFile, "\tTransfers %-10s: %u, queueing avg: %llu ns, max: %llu ns\n",
+                  apName[i], aStats[i].transfers,
+                  (aStats[i].transfers != 0)?
+                     div_u64( aStats[i].totalWait, aStats[i].transfers ) : 0,
+                  aStats[i].maxWait );
+   }
+}
+
 #define __VERSION TS( VERSION )
 /*!-----------------------------------------------------------------------------
- * @brief Displays the current driver status via process-file-system.
- *
- * E.g.:
- * @code
- * cat /proc/driver/adc
- * @endcode
+ * @brief Helper function for procOnOpen, displays the status of all objects.
  */
-static int procOnOpen( struct seq_file* pSeqFile, void* pValue )
+static void showStatus( struct seq_file* pSeqFile )
 {
    BUS_T* pI2cBus;
    int chipIndex;
    int channelIndex;
    u8 adcRegister;
+   u8 aRegister[ADS7924_REGISTER_FILE_SIZE];
+   bool hasRegisters;
    char binAsciiBuffer[10];
 
    seq_printf( pSeqFile, KBUILD_MODNAME " Version: " __VERSION "\n" );
@@ -187,6 +530,10 @@ static int procOnOpen( struct seq_file* pSeqFile, void* pValue )
    FOR_EACH_I2C_BUS( pI2cBus )
    {
       seq_printf( pSeqFile, "\nI2C-bus number: %d\n", pI2cBus->pI2cAdapter->nr );
+      showBusScheduler( pSeqFile, pI2cBus );
+      seq_printf( pSeqFile, "\tAsynchronous operations: %u submitted, %u completed\n",
+                  READ_ONCE( pI2cBus->async.submitted ),
+                  READ_ONCE( pI2cBus->async.completed ) );
       for( chipIndex = 0; chipIndex < ADC_CHIPS_PER_BUS; chipIndex++ )
       {
          if( pI2cBus->paChip[chipIndex] == NULL )
@@ -211,84 +558,51 @@ static int procOnOpen( struct seq_file* pSeqFile, void* pValue )
 #endif
          seq_printf( pSeqFile, "\t\tOpen-count: %d\n",
                      atomic_read( &pI2cBus->paChip[chipIndex]->openCounter ));
-
-         if( adcReadModeByte( pI2cBus->paChip[chipIndex], &adcRegister ) < 0 )
-         {
-            seq_printf( pSeqFile, "\t\tCouldn't read mode on address 0x%02X!\n", MODECNTRL );
-         }
-         else
+         seq_printf( pSeqFile, "\t\tBurst reads: %u, coalesced requests: %u\n",
+                     pI2cBus->paChip[chipIndex]->burst.completed,
+                     pI2cBus->paChip[chipIndex]->burst.served );
+
+         /*
+          * All registers by a single I2C-transfer, so the dump occupies the
+          * bus as short as possible.
+          */
+         hasRegisters = adcReadRegisterFile( pI2cBus->paChip[chipIndex], aRegister ) == 0;
+         if( hasRegisters )
          {
-            adcRegister &= ADS7924_MODE_AUTO_BURST_SCAN_SLEEP;
+            adcRegister = aRegister[MODECNTRL] & ADS7924_MODE_AUTO_BURST_SCAN_SLEEP;
             seq_printf( pSeqFile, "\t\tMODECNTRL: 0x%02X, %s\n",
                         adcRegister, getModeName( adcRegister ) );
-         }
-
-         if( adcReadIntCtrl( pI2cBus->paChip[chipIndex], &adcRegister ) < 0 )
-         {
-            seq_printf( pSeqFile,
-                        "\t\tCouldn't read interrupt control register on address 0x%02X!\n",
-                        INTCNTRL );
-         }
-         else
-         {
             seq_printf( pSeqFile, "\t\tINTCNTRL:  0x%02X, %s\n",
-                        adcRegister,
-                        toBin( binAsciiBuffer, adcRegister )
-                      );
-         }
-
-         if( adcReadIntConfig( pI2cBus->paChip[chipIndex], &adcRegister ) < 0 )
-         {
-            seq_printf( pSeqFile,
-                        "\t\tCouldn't read interrupt configuration register on address 0x%02X!\n",
-                        INTCONFIG );
-         }
-         else
-         {
+                        aRegister[INTCNTRL],
+                        toBin( binAsciiBuffer, aRegister[INTCNTRL] ) );
             seq_printf( pSeqFile, "\t\tINTCONFIG: 0x%02X, %s\n",
-                        adcRegister,
-                        toBin( binAsciiBuffer, adcRegister ) );
-         }
-
-         if( adcReadSlpConfig( pI2cBus->paChip[chipIndex], &adcRegister ) < 0 )
-         {
-            seq_printf( pSeqFile,
-                        "\t\tCouldn't read sleep configuration register on address 0x%02X!\n",
-                        SLPCONFIG );
-         }
-         else
-         {
+                        aRegister[INTCONFIG],
+                        toBin( binAsciiBuffer, aRegister[INTCONFIG] ) );
             seq_printf( pSeqFile, "\t\tSLPCONFIG: 0x%02X, %s\n",
-                        adcRegister,
-                        toBin( binAsciiBuffer, adcRegister ) );
-         }
-
-         if( adcReadAcqConfig( pI2cBus->paChip[chipIndex], &adcRegister ) < 0 )
-         {
-            seq_printf( pSeqFile,
-                        "\t\tCouldn't read aquire configuration register on address 0x%02X!\n",
-                        ACQCONFIG );
-
-         }
-         else
-         {
+                        aRegister[SLPCONFIG],
+                        toBin( binAsciiBuffer, aRegister[SLPCONFIG] ) );
             seq_printf( pSeqFile, "\t\tACQCONFIG: 0x%02X, %s\n",
-                        adcRegister,
-                        toBin( binAsciiBuffer, adcRegister ));
-         }
-
-         if( adcReadPwrConfig( pI2cBus->paChip[chipIndex], &adcRegister ) < 0 )
-         {
-            seq_printf( pSeqFile,
-                        "\t\tCouldn't read power configuration register on address 0x%02X!\n",
-                        PWRCONFIG );
+                        aRegister[ACQCONFIG],
+                        toBin( binAsciiBuffer, aRegister[ACQCONFIG] ) );
+            seq_printf( pSeqFile, "\t\tPWRCONFIG: 0x%02X, %s\n",
+                        aRegister[PWRCONFIG],
+                        toBin( binAsciiBuffer, aRegister[PWRCONFIG] ) );
+            showTiming( pSeqFile, aRegister );
          }
          else
          {
-            seq_printf( pSeqFile, "\t\tPWRCONFIG: 0x%02X, %s\n",
-                        adcRegister,
-                        toBin( binAsciiBuffer, adcRegister ));
+            seq_printf( pSeqFile, "\t\tCouldn't read the registers 0x%02X to 0x%02X!\n",
+                        MODECNTRL, PWRCONFIG );
          }
+         showScanRate( pSeqFile, pI2cBus->paChip[chipIndex] );
+         showOffsetHistory( pSeqFile, pI2cBus->paChip[chipIndex] );
+         seq_printf( pSeqFile, "\t\tStreaming: %s\n",
+                     mg_streamModeNames[pI2cBus->paChip[chipIndex]->streamMode] );
+         seq_printf( pSeqFile, "\t\tSequencer: %s, switches: %u\n",
+                     mg_sequencerModeNames[pI2cBus->paChip[chipIndex]->sequencer.mode],
+                     pI2cBus->paChip[chipIndex]->sequencer.switches );
+         showSchedule( pSeqFile, pI2cBus->paChip[chipIndex] );
+         showVirtual( pSeqFile, pI2cBus->paChip[chipIndex] );
 
          for( channelIndex = 0; channelIndex < ADC_CHANNELS_PER_CHIP; channelIndex++ )
          {
@@ -299,38 +613,82 @@ static int procOnOpen( struct seq_file* pSeqFile, void* pValue )
                         pI2cBus->pI2cAdapter->nr,
                         'A' + chipIndex,
                         channelIndex );
-            seq_printf( pSeqFile, "\t\t\tOpen-count: %d\n",
-                        atomic_read( &pI2cBus->paChip[chipIndex]->paChannel[channelIndex]->openCounter ));
-            seq_printf( pSeqFile, "\t\t\tReadmode: %s\n",
-                        getOutputFormatName( pI2cBus->paChip[chipIndex]->paChannel[channelIndex]->outputFormat ));
-            if( adcReadUpperLimitThreshold( pI2cBus->paChip[chipIndex]->paChannel[channelIndex], &adcRegister ) < 0 )
+            seq_printf( pSeqFile, "\t\t\tOpen-count: %d, published values: %u\n",
+                        atomic_read( &pI2cBus->paChip[chipIndex]->paChannel[channelIndex]->openCounter ),
+                        pI2cBus->paChip[chipIndex]->paChannel[channelIndex]->result.sequence );
+            seq_printf( pSeqFile, "\t\t\tReadmode: %s%s\n",
+                        getOutputFormatName( pI2cBus->paChip[chipIndex]->paChannel[channelIndex]->outputFormat ),
+                        mg_freshReadNames[pI2cBus->paChip[chipIndex]->paChannel[channelIndex]->freshRead] );
+            if( pI2cBus->paChip[chipIndex]->paChannel[channelIndex]->maxAge != 0 )
+               seq_printf( pSeqFile, "\t\t\tMaximum age: %u us\n",
+                           pI2cBus->paChip[chipIndex]->paChannel[channelIndex]->maxAge );
+            showCalibration( pSeqFile, pI2cBus->paChip[chipIndex]->paChannel[channelIndex] );
+            showPipeline( pSeqFile, pI2cBus->paChip[chipIndex]->paChannel[channelIndex] );
+            if( adcIsStreaming( pI2cBus->paChip[chipIndex]->paChannel[channelIndex] ) )
             {
-               seq_printf( pSeqFile,
-                           "\t\t\tCouldn't read upper limit register %d on address 0x%02X!\n",
-                           channelIndex, g_ads7924InternList[channelIndex].upperLimit );
-
+               seq_printf( pSeqFile, "\t\t\tFIFO: %u of %u, overruns: %u, "
+                                     "watermark: %u, timeout: %u us, wakeups: %u\n",
+                           adcFifoLevel( pI2cBus->paChip[chipIndex]->paChannel[channelIndex] ),
+                           CONFIG_ADS7924_FIFO_SIZE,
+                           pI2cBus->paChip[chipIndex]->paChannel[channelIndex]->fifo.overruns,
+                           pI2cBus->paChip[chipIndex]->paChannel[channelIndex]->fifo.wakeup.watermark,
+                           pI2cBus->paChip[chipIndex]->paChannel[channelIndex]->fifo.wakeup.timeout,
+                           pI2cBus->paChip[chipIndex]->paChannel[channelIndex]->fifo.wakeups );
             }
-            else
+            if( adcIsCapturing( pI2cBus->paChip[chipIndex]->paChannel[channelIndex] ) )
             {
-               seq_printf( pSeqFile, "\t\t\tULR%d: 0x%02X\n", channelIndex, adcRegister );
+               seq_printf( pSeqFile, "\t\t\tCapture: %s, %u + %u samples, trigger outside %u..%u, windows: %u\n",
+                           adcIsCaptureReady( pI2cBus->paChip[chipIndex]->paChannel[channelIndex] )? "ready" : "armed",
+                           pI2cBus->paChip[chipIndex]->paChannel[channelIndex]->capture.config.preTrigger,
+                           pI2cBus->paChip[chipIndex]->paChannel[channelIndex]->capture.config.postTrigger,
+                           pI2cBus->paChip[chipIndex]->paChannel[channelIndex]->capture.config.lower,
+                           pI2cBus->paChip[chipIndex]->paChannel[channelIndex]->capture.config.upper,
+                           pI2cBus->paChip[chipIndex]->paChannel[channelIndex]->capture.sequence );
             }
-
-            if( adcReadLowerLimitThreshold( pI2cBus->paChip[chipIndex]->paChannel[channelIndex], &adcRegister ) < 0 )
+            if( hasRegisters )
             {
-               seq_printf( pSeqFile,
-                           "\t\t\tCouldn't read lower limit register %d on address 0x%02X!\n",
-                           channelIndex, g_ads7924InternList[channelIndex].lowerLimit );
-
-            }
-            else
-            {
-               seq_printf( pSeqFile, "\t\t\tLLR%d: 0x%02X\n", channelIndex, adcRegister );
+               seq_printf( pSeqFile, "\t\t\tULR%d: 0x%02X\n", channelIndex,
+                           aRegister[g_ads7924InternList[channelIndex].upperLimit] );
+               seq_printf( pSeqFile, "\t\t\tLLR%d: 0x%02X\n", channelIndex,
+                           aRegister[g_ads7924InternList[channelIndex].lowerLimit] );
             }
 
          } /* for( channelIndex = 0; channelIndex < ADC_CHANNELS_PER_CHIP; channelIndex++ ) */
       } /* for( chipIndex = 0; chipIndex < ADC_CHIPS_PER_BUS; chipIndex++ ) */
    } /* FOR_EACH_I2C_BUS( pI2cBus ) */
 
+   showGroup( pSeqFile );
+   seq_printf( pSeqFile, "\n%sall: open-count: %d, subscription: [%*pbl], "
+                         "queued: %u, lost: %u\n",
+               g_data.pName, atomic_read( &g_data.merge.openCounter ),
+               ADS7924_MERGE_MAX_MINORS, g_data.merge.mask,
+               adcMergeLevel( &g_data.merge ), g_data.merge.lost );
+   seq_printf( pSeqFile, "\n%svalues: open-count: %d, slots: %u\n",
+               g_data.pName, atomic_read( &g_data.values.openCounter ),
+               (g_data.values.pPage != NULL)? g_data.values.pPage->count : 0 );
+}
+
+/*!-----------------------------------------------------------------------------
+ * @brief Displays the current driver status via process-file-system.
+ *
+ * The I2C-transfers of the dump have the lowest priority on the bus,
+ * concurrent dumps becomes serialized.
+ *
+ * E.g.:
+ * @code
+ * cat /proc/driver/adc
+ * @endcode
+ */
+static int procOnOpen( struct seq_file* pSeqFile, void* pValue )
+{
+   static DEFINE_MUTEX( oDiagnosticMutex );
+
+   if( mutex_lock_interruptible( &oDiagnosticMutex ) )
+      return -ERESTARTSYS;
+   WRITE_ONCE( g_data.pDiagnostic, current );
+   showStatus( pSeqFile );
+   WRITE_ONCE( g_data.pDiagnostic, NULL );
+   mutex_unlock( &oDiagnosticMutex );
    return 0;
 }
 
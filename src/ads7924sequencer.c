@@ -0,0 +1,630 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924sequencer.c
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Channel sequencer: Delivery of the selected channels only.
+ *
+ * In ADS7924_SEQ_ROUND_ROBIN the chip converts autonomously and the
+ * thread reads once per period the data registers of the channels in use
+ * by a single burst transfer, sleeping in between for the period, at least
+ * SEQUENCER_GAP_US.
+ *
+ * In ADS7924_SEQ_SCHEDULE the thread becomes woken by a periodic hrtimer
+ * and converts the due entries of the schedule table by switching of the
+ * single-channel mode: Each step writes MODECNTRL with the SEL_ID of the
+ * next channel and reads afterwards the data register of the previous
+ * one, which keeps the last conversion before the switch.
+ *
+ * @date 2026.10.18
+ * @see ads7924sequencer.h
+ * @see SEQUENCER
+ */
+#include "ads7924core.h"
+#include "ads7924timing.h"
+#include "ads7924stream.h"
+#include "ads7924merge.h"
+#include "ads7924sequencer.h"
+#include <linux/kthread.h>
+
+#define SEQUENCER_IDLE_MS  10 //!<@brief Polling interval when no channel is open.
+#define SEQUENCER_RETRY_MS 10 //!<@brief Delay after a failed I2C-transfer.
+#define SEQUENCER_GAP_US   20 //!<@brief Minimum sleep between two round-robin bursts.
+#define LATENCY_SHIFT       4 //!<@brief Latency and jitter becomes averaged over 16 samples.
+
+/*!----------------------------------------------------------------------------
+ * @brief Timer callback, releases a tick of the schedule.
+ */
+static enum hrtimer_restart onScheduleTimer( struct hrtimer* pTimer )
+{
+   ADS7924_T* pChip = container_of( pTimer, ADS7924_T, sequencer.oTimer );
+
+   wake_up_process( pChip->sequencer.pThread );
+   hrtimer_forward_now( pTimer, ns_to_ktime( (u64)pChip->sequencer.schedule.period * NSEC_PER_USEC ) );
+   return HRTIMER_RESTART;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924sequencer.h
+ */
+void _ADS7924_INIT adcInitSequencer( ADS7924_T* pChip )
+{
+   mutex_init( &pChip->sequencer.oMutex );
+   mutex_init( &pChip->sequencer.oStatMutex );
+   pChip->sequencer.pThread  = NULL;
+   pChip->sequencer.mode     = ADS7924_SEQ_OFF;
+   pChip->sequencer.switches = 0;
+   pChip->sequencer.schedule.count = 0;
+   hrtimer_init( &pChip->sequencer.oTimer, CLOCK_MONOTONIC, HRTIMER_MODE_ABS );
+   pChip->sequencer.oTimer.function = onScheduleTimer;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns tACQ + tCONV of the current ACQCONFIG in nanoseconds.
+ */
+static u32 getConvTime( ADS7924_T* pChip )
+{
+   u8 mode;
+   u8 aConfig[PWRCONFIG - SLPCONFIG + 1];
+
+   if( adcReadTimingShadow( pChip, &mode, aConfig ) < 0 )
+      return adcGetConvTime( ADS7924_ACQTIME_MASK );
+   return adcGetConvTime( aConfig[ACQCONFIG - SLPCONFIG] );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Switches the conversion to the next channel and reads the value
+ *        of the current one.
+ * @param next Next channel, <0: no further conversion.
+ * @param current Current channel, <0: none.
+ * @param pValue Target of the value of the current channel.
+ * @param pLastSwitch In: time of the previous switch, out: of this one.
+ * @param convTime tACQ + tCONV in ns.
+ */
+static int switchChannel( ADS7924_T* pChip, int next, int current,
+                          VALUE_T* pValue, u64* pLastSwitch, u32 convTime )
+{
+   u64 now;
+
+   if( current >= 0 )
+   {
+      /*
+       * The current channel needs at least one completed conversion,
+       * as a rule the I2C-transfers takes longer anyway.
+       */
+      now = ktime_get_ns();
+      if( now < *pLastSwitch + convTime )
+         usleep_range( DIV_ROUND_UP( *pLastSwitch + convTime - now, NSEC_PER_USEC ),
+                       DIV_ROUND_UP( *pLastSwitch + convTime - now, NSEC_PER_USEC ) + 10 );
+   }
+
+   pChip->sequencer.switches++;
+   return adcSwitchChannel( pChip,
+                            (next < 0)? ADS7924_MODE_AWAKE : (ADS7924_MODE_AUTO_SINGLE | next),
+                            current, pValue, pLastSwitch );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Delivers the value of a channel which has been read from its
+ *        data register.
+ * @param readTime Time of the reading transfer respectively of the switch.
+ * @param period Interval before readTime in which the last conversion
+ *               of the channel has been ended.
+ * @return Timestamp of the sample.
+ */
+static u64 deliver( ADS7924_T* pChip, int channel, VALUE_T value,
+                    u64 readTime, u64 period )
+{
+   ADS7924_SAMPLE_T sample;
+
+   /*
+    * The last conversion of the channel has been ended within one
+    * period before the reading, the middle of this interval becomes taken.
+    */
+   sample.timestamp = readTime - div_u64( period, 2 ) - ADS7924_CONV_TIME_NS;
+   sample.value     = value;
+   sample.channel   = channel;
+   sample.flags     = ADS7924_SAMPLE_RECONSTRUCTED;
+   sample.dummy     = 0;
+   if( pChip->paChannel[channel] != NULL )
+      adcDeliverSample( pChip->paChannel[channel], &sample );
+   return sample.timestamp;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns true if the channel is opened or subscribed.
+ */
+static bool isChannelInUse( ADS7924_T* pChip, int channel )
+{
+   if( pChip->paChannel[channel] == NULL )
+      return false;
+   return (atomic_read( &pChip->paChannel[channel]->openCounter ) != 0) ||
+          adcIsSubscribed( pChip->paChannel[channel] );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Body of the sequencer thread in ADS7924_SEQ_ROUND_ROBIN.
+ *
+ * The chip converts autonomously, ADS7924_MODE_AUTO_SINGLE if only one
+ * channel is in use, otherwise ADS7924_MODE_AUTO_SCAN. Each period the
+ * data registers from the first to the last channel in use becomes read
+ * by a single burst transfer and the values of the channels in use
+ * becomes delivered.
+ */
+static int onRoundRobinThread( void* pData )
+{
+   ADS7924_T* pChip = pData;
+   ADS7924_TIMING_T timing;
+   VALUE_T aValue[ADC_CHANNELS_PER_CHIP];
+   u8 aConfig[PWRCONFIG - SLPCONFIG + 1];
+   u8 shadowMode, newMode;
+   u8 mode = ADS7924_MODE_AWAKE;
+   u32 gap = SEQUENCER_GAP_US;
+   u64 readTime;
+   int first, last, i;
+
+   DEBUG_MESSAGE( ": Sequencer of chip 0x%02X started\n", pChip->pI2cSlave->addr );
+   while( !kthread_should_stop() )
+   {
+      for( first = 0; first < ADC_CHANNELS_PER_CHIP; first++ )
+      {
+         if( isChannelInUse( pChip, first ) )
+            break;
+      }
+      if( first == ADC_CHANNELS_PER_CHIP )
+      {
+         schedule_timeout_interruptible( msecs_to_jiffies( SEQUENCER_IDLE_MS ) );
+         continue;
+      }
+      for( last = ADC_CHANNELS_PER_CHIP - 1; last > first; last-- )
+      {
+         if( isChannelInUse( pChip, last ) )
+            break;
+      }
+
+      newMode = (first == last)? (ADS7924_MODE_AUTO_SINGLE | first) : ADS7924_MODE_AUTO_SCAN;
+      if( newMode != mode )
+      {
+         if( (adcWriteModeByte( pChip, newMode ) < 0) ||
+             (adcReadTimingShadow( pChip, &shadowMode, aConfig ) < 0) ||
+             !adcCalculateTiming( &timing, newMode, aConfig[0], aConfig[1], aConfig[2] ) )
+         {
+            ERROR_MESSAGE( ": Sequencer: setting of mode 0x%02X failed!\n", newMode );
+            mode = ADS7924_MODE_AWAKE;
+            schedule_timeout_interruptible( msecs_to_jiffies( SEQUENCER_RETRY_MS ) );
+            continue;
+         }
+         mode = newMode;
+         pChip->sequencer.switches++;
+         gap = max_t( u32, div_u64( timing.period + NSEC_PER_USEC - 1, NSEC_PER_USEC ),
+                      SEQUENCER_GAP_US );
+      }
+
+      /*
+       * Sleeping one period until each register holds a new conversion
+       * leaves the I2C-bus to the other chips and users in the meantime.
+       */
+      usleep_range( gap, gap + 10 );
+
+      readTime = ktime_get_ns();
+      if( adcReadAnalogValues( pChip, first, last - first + 1, aValue ) < 0 )
+      {
+         ERROR_MESSAGE( ": Sequencer: reading of channel %d to %d failed!\n", first, last );
+         schedule_timeout_interruptible( msecs_to_jiffies( SEQUENCER_RETRY_MS ) );
+         continue;
+      }
+      for( i = first; i <= last; i++ )
+      {
+         if( isChannelInUse( pChip, i ) )
+            deliver( pChip, i, aValue[i - first], readTime, timing.period );
+      }
+   }
+   DEBUG_MESSAGE( ": Sequencer of chip 0x%02X stopped\n", pChip->pI2cSlave->addr );
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns the number of ticks in [from, to) in which a entry of
+ *        the given divider is due.
+ */
+static inline u64 countDueTicks( u64 from, u64 to, u32 divider )
+{
+   return div_u64( to + divider - 1, divider ) - div_u64( from + divider - 1, divider );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Counts deadline-misses of a schedule entry without sample.
+ */
+static void addMisses( ADS7924_T* pChip, unsigned int index, u64 count )
+{
+   mutex_lock( &pChip->sequencer.oStatMutex );
+   pChip->sequencer.stats.aEntry[index].misses += count;
+   mutex_unlock( &pChip->sequencer.oStatMutex );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Updates the statistics of a schedule entry by a delivered sample.
+ * @param index Index of the entry in the schedule table.
+ * @param latency Conversion instant minus release of the tick in ns.
+ * @param miss True if the deadline has been missed.
+ */
+static void updateStatistics( ADS7924_T* pChip, unsigned int index,
+                              s64 latency, bool miss )
+{
+   ADS7924_SCHEDULE_STAT_T* pStat = &pChip->sequencer.stats.aEntry[index];
+   u32 value = clamp_t( s64, latency, 0, U32_MAX );
+   s32 deviation;
+
+   mutex_lock( &pChip->sequencer.oStatMutex );
+   if( miss )
+      pStat->misses++;
+   if( pStat->samples == 0 )
+   {
+      pStat->minLatency  = value;
+      pStat->maxLatency  = value;
+      pStat->meanLatency = value;
+   }
+   pStat->samples++;
+   pStat->minLatency = min( pStat->minLatency, value );
+   pStat->maxLatency = max( pStat->maxLatency, value );
+   deviation = (s32)(value - pStat->meanLatency);
+   pStat->meanLatency += deviation >> LATENCY_SHIFT;
+   pStat->jitter += ((s32)abs( deviation ) - (s32)pStat->jitter) >> LATENCY_SHIFT;
+   mutex_unlock( &pChip->sequencer.oStatMutex );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Converts the due entries of a tick in the order of their priority.
+ * @param tick Number of the tick.
+ * @param release Release time of the tick in ns.
+ * @param period Base period in ns.
+ */
+static void processTick( ADS7924_T* pChip, u64 tick, u64 release, u64 period )
+{
+   ADS7924_SCHEDULE_T* pSchedule = &pChip->sequencer.schedule;
+   VALUE_T value;
+   u32 convTime = getConvTime( pChip );
+   u64 lastSwitch = 0;
+   u64 timestamp;
+   int current = -1;
+   u32 rem;
+   int i, index, next;
+   bool late = false;
+
+   for( i = 0; i <= pSchedule->count; i++ )
+   {
+      index = -1;
+      if( i < pSchedule->count )
+      {
+         index = pChip->sequencer.aOrder[i];
+         div_u64_rem( tick, pSchedule->aEntry[index].divider, &rem );
+         if( rem != 0 )
+            continue;
+         if( late || (ktime_get_ns() >= release + period) )
+         {
+            /* Too late for this tick, the next one has been released. */
+            late = true;
+            addMisses( pChip, index, 1 );
+            continue;
+         }
+      }
+      next = (index < 0)? -1 : pSchedule->aEntry[index].channel;
+      if( (next < 0) && (current < 0) )
+         break;
+
+      if( switchChannel( pChip, next, (current < 0)? -1 : pSchedule->aEntry[current].channel,
+                         &value, &lastSwitch, convTime ) < 0 )
+      {
+         /*
+          * Neither the sample of the current entry nor the conversion of
+          * the next one is certain, both count as missed.
+          */
+         if( index >= 0 )
+         {
+            ERROR_MESSAGE( ": Sequencer: switching to channel %d failed!\n", next );
+            addMisses( pChip, index, 1 );
+         }
+         if( current >= 0 )
+         {
+            if( index < 0 )
+               ERROR_MESSAGE( ": Sequencer: reading of channel %d failed!\n",
+                              pSchedule->aEntry[current].channel );
+            addMisses( pChip, current, 1 );
+         }
+         current = -1;
+         continue;
+      }
+
+      if( current >= 0 )
+      {
+         timestamp = deliver( pChip, pSchedule->aEntry[current].channel, value,
+                              lastSwitch, convTime );
+         updateStatistics( pChip, current, (s64)(timestamp - release),
+                           lastSwitch > release + period * pSchedule->aEntry[current].divider );
+      }
+      current = index;
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Body of the sequencer thread in ADS7924_SEQ_SCHEDULE.
+ *
+ * The thread sleeps until the timer releases the next tick. Ticks which
+ * has been lost completely, e.g. by a long blocked I2C-bus, becomes
+ * counted as overruns and as deadline-misses of their due entries.
+ */
+static int onScheduleThread( void* pData )
+{
+   ADS7924_T* pChip = pData;
+   ADS7924_SCHEDULE_T* pSchedule = &pChip->sequencer.schedule;
+   u64 period = (u64)pSchedule->period * NSEC_PER_USEC;
+   u64 nextTick = 0;
+   u64 now, tick;
+   int i;
+
+   DEBUG_MESSAGE( ": Schedule of chip 0x%02X started\n", pChip->pI2cSlave->addr );
+   while( true )
+   {
+      set_current_state( TASK_INTERRUPTIBLE );
+      if( kthread_should_stop() )
+         break;
+      now = ktime_get_ns();
+      if( now < pChip->sequencer.start + nextTick * period )
+      {
+         schedule();
+         continue;
+      }
+      __set_current_state( TASK_RUNNING );
+
+      tick = div64_u64( now - pChip->sequencer.start, period );
+      if( tick > nextTick )
+      {
+         mutex_lock( &pChip->sequencer.oStatMutex );
+         pChip->sequencer.stats.overruns += tick - nextTick;
+         mutex_unlock( &pChip->sequencer.oStatMutex );
+         for( i = 0; i < pSchedule->count; i++ )
+            addMisses( pChip, i, countDueTicks( nextTick, tick, pSchedule->aEntry[i].divider ) );
+      }
+
+      processTick( pChip, tick, pChip->sequencer.start + tick * period, period );
+      mutex_lock( &pChip->sequencer.oStatMutex );
+      pChip->sequencer.stats.ticks++;
+      mutex_unlock( &pChip->sequencer.oStatMutex );
+      nextTick = tick + 1;
+   }
+   __set_current_state( TASK_RUNNING );
+   DEBUG_MESSAGE( ": Schedule of chip 0x%02X stopped\n", pChip->pI2cSlave->addr );
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Terminates the sequencer thread and restores the previous mode.
+ * @note The caller has to hold sequencer.oMutex.
+ */
+static int stopSequencer( ADS7924_T* pChip )
+{
+   int ret = 0;
+
+   if( pChip->sequencer.mode == ADS7924_SEQ_SCHEDULE )
+      hrtimer_cancel( &pChip->sequencer.oTimer );
+   kthread_stop( pChip->sequencer.pThread );
+   pChip->sequencer.pThread = NULL;
+   pChip->sequencer.mode = ADS7924_SEQ_OFF;
+
+   if( adcWriteModeByte( pChip, pChip->sequencer.prevMode ) < 0 )
+   {
+      ERROR_MESSAGE( ": Restoring of mode 0x%02X failed!\n", pChip->sequencer.prevMode );
+      ret = -EIO;
+   }
+   adcReleaseReaders( pChip );
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924sequencer.h
+ */
+int adcLockMode( ADS7924_T* pChip )
+{
+   mutex_lock( &pChip->sequencer.oMutex );
+   if( adcIsSequencing( pChip ) )
+   {
+      ERROR_MESSAGE( ": Mode is owned by the running sequencer!\n" );
+      goto L_BUSY;
+   }
+   if( pChip->inGroup )
+   {
+      ERROR_MESSAGE( ": Mode is owned by the running group!\n" );
+      goto L_BUSY;
+   }
+   return 0;
+
+L_BUSY:
+   mutex_unlock( &pChip->sequencer.oMutex );
+   return -EBUSY;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924sequencer.h
+ */
+int adcSetSequencer( ADS7924_T* pChip, u8 mode )
+{
+   struct task_struct* pThread;
+   int (*threadFunction)( void* );
+   int ret = 0;
+
+   switch( mode )
+   {
+      case ADS7924_SEQ_OFF:         threadFunction = NULL;               break;
+      case ADS7924_SEQ_ROUND_ROBIN: threadFunction = onRoundRobinThread; break;
+      case ADS7924_SEQ_SCHEDULE:    threadFunction = onScheduleThread;   break;
+      default:
+      {
+         ERROR_MESSAGE( ": Unknown sequencer mode: %d\n", mode );
+         return -EINVAL;
+      }
+   }
+
+   mutex_lock( &pChip->sequencer.oMutex );
+   if( mode == pChip->sequencer.mode )
+      goto L_UNLOCK;
+
+   if( pChip->sequencer.mode != ADS7924_SEQ_OFF )
+   {
+      ret = stopSequencer( pChip );
+      if( ret < 0 )
+         goto L_UNLOCK;
+   }
+
+   if( mode == ADS7924_SEQ_OFF )
+      goto L_UNLOCK;
+
+   if( pChip->streamMode != ADS7924_STREAM_OFF )
+   {
+      ERROR_MESSAGE( ": Sequencer and streaming mode are exclusive!\n" );
+      ret = -EBUSY;
+      goto L_UNLOCK;
+   }
+
+   if( pChip->inGroup )
+   {
+      ERROR_MESSAGE( ": Mode is owned by the running group!\n" );
+      ret = -EBUSY;
+      goto L_UNLOCK;
+   }
+
+   if( (mode == ADS7924_SEQ_SCHEDULE) && (pChip->sequencer.schedule.count == 0) )
+   {
+      ERROR_MESSAGE( ": No schedule table!\n" );
+      ret = -EINVAL;
+      goto L_UNLOCK;
+   }
+
+   ret = adcPrepareFifos( pChip );
+   if( ret < 0 )
+      goto L_UNLOCK;
+
+   if( adcReadModeByte( pChip, &pChip->sequencer.prevMode ) < 0 )
+   {
+      ERROR_MESSAGE( ": adcReadModeByte() failed!\n" );
+      ret = -EIO;
+      goto L_UNLOCK;
+   }
+
+   pChip->sequencer.switches = 0;
+   mutex_lock( &pChip->sequencer.oStatMutex );
+   memset( &pChip->sequencer.stats, 0, sizeof( pChip->sequencer.stats ) );
+   mutex_unlock( &pChip->sequencer.oStatMutex );
+   /* The first tick leaves the thread one base period to start. */
+   pChip->sequencer.start = ktime_get_ns() +
+                            (u64)pChip->sequencer.schedule.period * NSEC_PER_USEC;
+   pChip->sequencer.mode = mode;
+   pThread = kthread_run( threadFunction, pChip, "ads7924seq-%d-%02x",
+                          pChip->pI2cSlave->adapter->nr, pChip->pI2cSlave->addr );
+   if( IS_ERR( pThread ) )
+   {
+      ERROR_MESSAGE( ": Unable to start the sequencer thread!\n" );
+      pChip->sequencer.mode = ADS7924_SEQ_OFF;
+      ret = PTR_ERR( pThread );
+      goto L_UNLOCK;
+   }
+   pChip->sequencer.pThread = pThread;
+   if( mode == ADS7924_SEQ_SCHEDULE )
+      hrtimer_start( &pChip->sequencer.oTimer,
+                     ns_to_ktime( pChip->sequencer.start ), HRTIMER_MODE_ABS );
+
+L_UNLOCK:
+   mutex_unlock( &pChip->sequencer.oMutex );
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924sequencer.h
+ */
+int adcSetSchedule( ADS7924_T* pChip, const ADS7924_SCHEDULE_T* pSchedule )
+{
+   int i, j;
+   u8 index;
+   int ret = 0;
+
+   if( (pSchedule->count == 0) || (pSchedule->count > ADS7924_SCHEDULE_SIZE) ||
+       (pSchedule->period < ADS7924_SCHEDULE_MIN_PERIOD) )
+   {
+      ERROR_MESSAGE( ": Invalid schedule: count: %u, period: %u us\n",
+                     pSchedule->count, pSchedule->period );
+      return -EINVAL;
+   }
+   for( i = 0; i < pSchedule->count; i++ )
+   {
+      if( (pSchedule->aEntry[i].channel >= ADC_CHANNELS_PER_CHIP) ||
+          (pChip->paChannel[pSchedule->aEntry[i].channel] == NULL) ||
+          (pSchedule->aEntry[i].divider == 0) )
+      {
+         ERROR_MESSAGE( ": Invalid schedule entry %d: channel: %u, divider: %u\n",
+                        i, pSchedule->aEntry[i].channel, pSchedule->aEntry[i].divider );
+         return -EINVAL;
+      }
+   }
+
+   mutex_lock( &pChip->sequencer.oMutex );
+   if( pChip->sequencer.mode == ADS7924_SEQ_SCHEDULE )
+   {
+      ERROR_MESSAGE( ": Schedule is running!\n" );
+      ret = -EBUSY;
+      goto L_UNLOCK;
+   }
+   pChip->sequencer.schedule = *pSchedule;
+
+   /*
+    * Order of execution within a tick: Insertion sort by descending
+    * priority, entries of the same priority in order of the table.
+    */
+   for( i = 0; i < pSchedule->count; i++ )
+   {
+      index = i;
+      for( j = i; (j > 0) && (pSchedule->aEntry[pChip->sequencer.aOrder[j-1]].priority <
+                              pSchedule->aEntry[index].priority); j-- )
+         pChip->sequencer.aOrder[j] = pChip->sequencer.aOrder[j-1];
+      pChip->sequencer.aOrder[j] = index;
+   }
+
+L_UNLOCK:
+   mutex_unlock( &pChip->sequencer.oMutex );
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924sequencer.h
+ */
+void adcGetScheduleStats( ADS7924_T* pChip, ADS7924_SCHEDULE_STATS_T* pStats )
+{
+   mutex_lock( &pChip->sequencer.oStatMutex );
+   *pStats = pChip->sequencer.stats;
+   mutex_unlock( &pChip->sequencer.oStatMutex );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924sequencer.h
+ */
+void adcStopSequencer( ADS7924_T* pChip )
+{
+   mutex_lock( &pChip->sequencer.oMutex );
+   if( pChip->sequencer.mode != ADS7924_SEQ_OFF )
+      stopSequencer( pChip );
+   mutex_unlock( &pChip->sequencer.oMutex );
+}
+
+/*================================== EOF ====================================*/
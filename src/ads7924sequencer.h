@@ -0,0 +1,106 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924sequencer.h
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Channel sequencer: Conversion of selected channels only by
+ *        switching of the single-channel mode.
+ * @date 2026.10.18
+ * @see ads7924sequencer.c
+ * @see SEQUENCER
+ */
+#ifndef _ADS7924SEQUENCER_H
+#define _ADS7924SEQUENCER_H
+
+#include "ads7924driver.h"
+
+/*!----------------------------------------------------------------------------
+ * @brief Initializes the sequencer objects of the given chip.
+ */
+extern void adcInitSequencer( ADS7924_T* pChip );
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns true if the sequencer of the chip is running.
+ */
+static inline bool adcIsSequencing( ADS7924_T* pChip )
+{
+   return pChip->sequencer.mode != ADS7924_SEQ_OFF;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns true if the register MODECNTRL is owned by the running
+ *        sequencer or the running group.
+ * @note Without sequencer.oMutex the result is a hint only,
+ *       see adcLockMode().
+ */
+static inline bool adcIsModeOwned( ADS7924_T* pChip )
+{
+   return adcIsSequencing( pChip ) || pChip->inGroup;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Takes the ownership of the register MODECNTRL for a rewrite
+ *        which is not done by the sequencer or the group.
+ *
+ * On success sequencer.oMutex stays locked until adcUnlockMode(), so
+ * neither the sequencer nor the group can start before the rewrite is done.
+ * @retval ==0 OK, the caller has to call adcUnlockMode().
+ * @retval -EBUSY The mode is owned by the running sequencer or group.
+ */
+extern int adcLockMode( ADS7924_T* pChip );
+
+/*!----------------------------------------------------------------------------
+ * @brief Releases the ownership taken by adcLockMode().
+ */
+static inline void adcUnlockMode( ADS7924_T* pChip )
+{
+   mutex_unlock( &pChip->sequencer.oMutex );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Starts or stops the sequencer of the chip.
+ *
+ * Starting allocates the FIFOs of the present channels, saves the current
+ * mode and starts the sequencer thread. Stopping terminates the thread,
+ * restores the saved mode and wakes the waiting readers.
+ * @param pChip Pointer to the chip object.
+ * @param mode ADS7924_SEQ_OFF, ADS7924_SEQ_ROUND_ROBIN or ADS7924_SEQ_SCHEDULE
+ * @retval ==0 OK
+ * @retval <0  Error (-EINVAL, -EBUSY, -ENOMEM or -EIO)
+ */
+extern int adcSetSequencer( ADS7924_T* pChip, u8 mode );
+
+/*!----------------------------------------------------------------------------
+ * @brief Checks and stores the schedule table for ADS7924_SEQ_SCHEDULE.
+ * @retval ==0 OK
+ * @retval <0  Error (-EINVAL or -EBUSY if the schedule is running)
+ */
+extern int adcSetSchedule( ADS7924_T* pChip, const ADS7924_SCHEDULE_T* pSchedule );
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns the statistics of the schedule since its last start.
+ */
+extern void adcGetScheduleStats( ADS7924_T* pChip, ADS7924_SCHEDULE_STATS_T* pStats );
+
+/*!----------------------------------------------------------------------------
+ * @brief Stops the sequencer if running, used when the driver becomes
+ *        unloaded.
+ */
+extern void adcStopSequencer( ADS7924_T* pChip );
+
+#endif /* ifndef _ADS7924SEQUENCER_H */
+/*================================== EOF ====================================*/
@@ -0,0 +1,442 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924stream.c
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Data-ready streaming: Harvesting of each conversion by the
+ *        interrupt into the FIFOs of the channels.
+ * @date 2026.10.18
+ * @see ads7924stream.h
+ * @see STREAMING
+ */
+#include "ads7924core.h"
+#include "ads7924stream.h"
+#include "ads7924merge.h"
+#include "ads7924capture.h"
+#include "ads7924virtual.h"
+#include "ads7924pipeline.h"
+#include <linux/slab.h>
+
+#define FIFO_MASK (CONFIG_ADS7924_FIFO_SIZE - 1)
+
+/*!----------------------------------------------------------------------------
+ * @brief Timer callback: The oldest sample of the FIFO has reached its
+ *        maximum latency.
+ */
+static enum hrtimer_restart onWakeupTimer( struct hrtimer* pTimer )
+{
+   ADC_CHANNEL_T* pChannel = container_of( pTimer, ADC_CHANNEL_T, fifo.oTimer );
+
+   pChannel->fifo.wakeups++;
+   wakeUpChannel( pChannel );
+   return HRTIMER_NORESTART;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924stream.h
+ */
+void _ADS7924_INIT adcInitStream( ADC_CHANNEL_T* pChannel )
+{
+   BUILD_BUG_ON( (CONFIG_ADS7924_FIFO_SIZE & FIFO_MASK) != 0 );
+
+   mutex_init( &pChannel->fifo.oMutex );
+   pChannel->fifo.paBuffer = NULL;
+   pChannel->fifo.head     = 0;
+   pChannel->fifo.tail     = 0;
+   pChannel->fifo.overruns = 0;
+   pChannel->fifo.wakeup.watermark = 1;
+   pChannel->fifo.wakeup.timeout   = 0;
+   pChannel->fifo.deadline = 0;
+   pChannel->fifo.wakeups  = 0;
+   hrtimer_init( &pChannel->fifo.oTimer, CLOCK_MONOTONIC, HRTIMER_MODE_ABS );
+   pChannel->fifo.oTimer.function = onWakeupTimer;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924stream.h
+ */
+void adcFreeStream( ADC_CHANNEL_T* pChannel )
+{
+   hrtimer_cancel( &pChannel->fifo.oTimer );
+   kfree( pChannel->fifo.paBuffer );
+   pChannel->fifo.paBuffer = NULL;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Allocates the FIFO buffer if not already done and clears the FIFO.
+ */
+static int prepareFifo( ADC_CHANNEL_T* pChannel )
+{
+   int ret = 0;
+
+   mutex_lock( &pChannel->fifo.oMutex );
+   if( pChannel->fifo.paBuffer == NULL )
+   {
+      pChannel->fifo.paBuffer = kmalloc_array( CONFIG_ADS7924_FIFO_SIZE,
+                                               sizeof( ADS7924_SAMPLE_T ),
+                                               GFP_KERNEL );
+      if( pChannel->fifo.paBuffer == NULL )
+      {
+         ERROR_MESSAGE( ": Unable to allocate FIFO for channel %d\n",
+                        pChannel->cannelNumber );
+         ret = -ENOMEM;
+      }
+   }
+   pChannel->fifo.head     = 0;
+   pChannel->fifo.tail     = 0;
+   pChannel->fifo.overruns = 0;
+   mutex_unlock( &pChannel->fifo.oMutex );
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924stream.h
+ */
+int adcPrepareFifos( ADS7924_T* pChip )
+{
+   int i, ret;
+
+   for( i = 0; i < ADC_CHANNELS_PER_CHIP; i++ )
+   {
+      if( pChip->paChannel[i] == NULL )
+         continue;
+      ret = prepareFifo( pChip->paChannel[i] );
+      if( ret < 0 )
+         return ret;
+   }
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924stream.h
+ */
+void adcReleaseReaders( ADS7924_T* pChip )
+{
+   int i;
+
+   for( i = 0; i < ADC_CHANNELS_PER_CHIP; i++ )
+   {
+      if( pChip->paChannel[i] != NULL )
+         wakeUpChannel( pChip->paChannel[i] );
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924stream.h
+ */
+int adcSetStreaming( ADS7924_T* pChip, u8 streamMode )
+{
+   u8 intConfig;
+   int ret;
+
+   switch( streamMode )
+   {
+      case ADS7924_STREAM_OFF:        intConfig = ADS7924_INTCNFG_ALARM;          break;
+      case ADS7924_STREAM_CONVERSION: intConfig = ADS7924_INTCNFG_DATA_READY_ONE; break;
+      case ADS7924_STREAM_SCAN:       intConfig = ADS7924_INTCNFG_DATA_READY_ALL; break;
+      default:
+      {
+         ERROR_MESSAGE( ": Unknown streaming mode: %d\n", streamMode );
+         return -EINVAL;
+      }
+   }
+
+   /*
+    * The starts of sequencer, group and streaming are serialized by
+    * sequencer.oMutex, so none of them can pass the check of the others.
+    */
+   mutex_lock( &pChip->sequencer.oMutex );
+   if( streamMode != ADS7924_STREAM_OFF )
+   {
+      if( pChip->sequencer.mode != ADS7924_SEQ_OFF )
+      {
+         ERROR_MESSAGE( ": Sequencer and streaming mode are exclusive!\n" );
+         ret = -EBUSY;
+         goto L_UNLOCK;
+      }
+      if( pChip->inGroup )
+      {
+         ERROR_MESSAGE( ": Chip is member of the running group!\n" );
+         ret = -EBUSY;
+         goto L_UNLOCK;
+      }
+      ret = adcPrepareFifos( pChip );
+      if( ret < 0 )
+         goto L_UNLOCK;
+   }
+
+   ret = adcWriteStreamMode( pChip, streamMode, intConfig, ADS7924_INTCNFG_MASK & ~intConfig );
+   if( ret < 0 )
+   {
+      ERROR_MESSAGE( ": adcWriteStreamMode() failed!\n" );
+      ret = -EIO;
+      goto L_UNLOCK;
+   }
+
+   if( streamMode == ADS7924_STREAM_OFF )
+      adcReleaseReaders( pChip );
+
+L_UNLOCK:
+   mutex_unlock( &pChip->sequencer.oMutex );
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924stream.h
+ */
+int adcSetWakeup( ADC_CHANNEL_T* pChannel, const ADS7924_WAKEUP_T* pWakeup )
+{
+   if( (pWakeup->watermark == 0) || (pWakeup->watermark > CONFIG_ADS7924_FIFO_SIZE) )
+   {
+      ERROR_MESSAGE( ": Watermark %u out of range 1..%u\n",
+                     pWakeup->watermark, CONFIG_ADS7924_FIFO_SIZE );
+      return -EINVAL;
+   }
+
+   hrtimer_cancel( &pChannel->fifo.oTimer );
+   mutex_lock( &pChannel->fifo.oMutex );
+   WRITE_ONCE( pChannel->fifo.wakeup.watermark, pWakeup->watermark );
+   WRITE_ONCE( pChannel->fifo.wakeup.timeout, pWakeup->timeout );
+   WRITE_ONCE( pChannel->fifo.deadline,
+               ktime_get_ns() + (u64)pWakeup->timeout * NSEC_PER_USEC );
+   if( (pWakeup->timeout != 0) && (pChannel->fifo.head != pChannel->fifo.tail) )
+      hrtimer_start( &pChannel->fifo.oTimer, ns_to_ktime( pChannel->fifo.deadline ),
+                     HRTIMER_MODE_ABS );
+   mutex_unlock( &pChannel->fifo.oMutex );
+
+   /* Readers re-evaluate their condition. */
+   wakeUpChannel( pChannel );
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924stream.h
+ */
+bool adcIsFifoReady( ADC_CHANNEL_T* pChannel )
+{
+   unsigned int level;
+
+   /*
+    * Lockless, because it's used as condition of wait_event_interruptible()
+    * where the task may not sleep. A outdated snapshot is harmless, the
+    * producer and the timer wake the readers again.
+    */
+   level = adcFifoLevel( pChannel );
+   if( level == 0 )
+      return false;
+   if( level >= READ_ONCE( pChannel->fifo.wakeup.watermark ) )
+      return true;
+   return (READ_ONCE( pChannel->fifo.wakeup.timeout ) != 0) &&
+          (ktime_get_ns() >= READ_ONCE( pChannel->fifo.deadline ));
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Puts a sample in the FIFO, by a full FIFO the oldest sample
+ *        becomes overwritten and the new oldest one marked.
+ *
+ * The first sample into a empty FIFO starts the latency timeout,
+ * adcPopSamples() restarts it for the oldest remaining sample.
+ * @retval true The readers has to be woken.
+ */
+static bool pushSample( ADC_CHANNEL_T* pChannel, const ADS7924_SAMPLE_T* pSample )
+{
+   unsigned int level;
+   bool wake = true;
+
+   mutex_lock( &pChannel->fifo.oMutex );
+   if( pChannel->fifo.paBuffer != NULL )
+   {
+      if( (pChannel->fifo.head - pChannel->fifo.tail) >= CONFIG_ADS7924_FIFO_SIZE )
+      {
+         WRITE_ONCE( pChannel->fifo.tail, pChannel->fifo.tail + 1 );
+         pChannel->fifo.overruns++;
+         pChannel->fifo.paBuffer[pChannel->fifo.tail & FIFO_MASK].flags |= ADS7924_SAMPLE_OVERRUN;
+      }
+      pChannel->fifo.paBuffer[pChannel->fifo.head & FIFO_MASK] = *pSample;
+      /* Publishes the sample for the lockless level of adcFifoLevel. */
+      smp_store_release( &pChannel->fifo.head, pChannel->fifo.head + 1 );
+
+      level = pChannel->fifo.head - pChannel->fifo.tail;
+      if( (level == 1) && (pChannel->fifo.wakeup.timeout != 0) )
+      {
+         WRITE_ONCE( pChannel->fifo.deadline, ktime_get_ns() +
+                     (u64)pChannel->fifo.wakeup.timeout * NSEC_PER_USEC );
+         hrtimer_start( &pChannel->fifo.oTimer, ns_to_ktime( pChannel->fifo.deadline ),
+                        HRTIMER_MODE_ABS );
+      }
+      wake = (level >= pChannel->fifo.wakeup.watermark);
+      if( wake )
+         pChannel->fifo.wakeups++;
+   }
+   mutex_unlock( &pChannel->fifo.oMutex );
+   return wake;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924stream.h
+ */
+void adcDeliverSample( ADC_CHANNEL_T* pChannel, const ADS7924_SAMPLE_T* pSample )
+{
+   ADS7924_SAMPLE_T processed;
+
+   if( adcHasPipeline( pChannel ) )
+   {
+      processed = *pSample;
+      if( !adcRunPipeline( pChannel, &processed ) )
+         return;
+      pSample = &processed;
+   }
+
+   publishResult( pChannel, pSample );
+
+   if( pushSample( pChannel, pSample ) )
+      wakeUpChannel( pChannel );
+   if( adcIsSubscribed( pChannel ) )
+      adcMergeSample( pChannel, pSample );
+   if( adcIsCapturing( pChannel ) )
+      adcCaptureSample( pChannel, pSample );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924stream.h
+ */
+void adcStreamHarvest( ADS7924_T* pChip, const ADS7924_TIMING_T* pTiming,
+                       u8 mode, u64 scanEnd )
+{
+   VALUE_T aValue[ADC_CHANNELS_PER_CHIP];
+   u64 aTimestamp[ADC_CHANNELS_PER_CHIP];
+   ADS7924_SAMPLE_T sample;
+   ADC_CHANNEL_T* pChannel;
+   unsigned int first, last, i;
+   u8 converting;
+   u64 now;
+
+   /* Taken before the transfers, so adcAlignToRead() never skips the conversion read. */
+   now = ktime_get_ns();
+
+   first = 0;
+   last  = ADC_CHANNELS_PER_CHIP - 1;
+   if( READ_ONCE( pChip->streamMode ) == ADS7924_STREAM_CONVERSION )
+   {
+      if( (mode & MODE1) == 0 )
+      {
+         /* Single modes: Only the selected channel becomes converted. */
+         first = mode & (SEL_ID1 | SEL_ID0);
+      }
+      else
+      {
+         /*
+          * Scan modes: The channels becomes converted one after the other,
+          * in these modes SEL_ID of MODECNTRL reads back the channel in
+          * conversion, which follows the completed one.
+          */
+         if( adcReadModeByte( pChip, &converting ) < 0 )
+         {
+            ERROR_MESSAGE( ": adcReadModeByte() failed!\n" );
+            return;
+         }
+         first = ((converting & (SEL_ID1 | SEL_ID0)) + ADC_CHANNELS_PER_CHIP - 1) %
+                 ADC_CHANNELS_PER_CHIP;
+      }
+      last = first;
+   }
+
+   if( adcReadAllAnalogValues( pChip, aValue ) < 0 )
+   {
+      ERROR_MESSAGE( ": adcReadAllAnalogValues() failed!\n" );
+      return;
+   }
+
+   for( i = first; i <= last; i++ )
+   {
+      sample.timestamp = 0;
+      if( pTiming != NULL )
+      {
+         if( first == last )
+            sample.timestamp = (scanEnd > ADS7924_CONV_TIME_NS)? (scanEnd - ADS7924_CONV_TIME_NS) : 0;
+         else
+            sample.timestamp = adcReconstructTimestamp( pTiming, mode, i, scanEnd );
+         sample.timestamp = adcAlignToRead( sample.timestamp, pTiming->period, now );
+      }
+      sample.flags = ADS7924_SAMPLE_RECONSTRUCTED;
+      if( sample.timestamp == 0 )
+      {
+         sample.timestamp = now;
+         sample.flags = 0;
+      }
+      aTimestamp[i] = sample.timestamp;
+
+      pChannel = pChip->paChannel[i];
+      if( pChannel == NULL )
+         continue; /* Channel not present */
+
+      if( (atomic_read( &pChannel->openCounter ) == 0) && !adcIsSubscribed( pChannel ) )
+         continue; /* Channel currently neither open nor subscribed */
+
+      sample.value   = aValue[i];
+      sample.channel = i;
+      sample.dummy   = 0;
+      adcDeliverSample( pChannel, &sample );
+   }
+
+   /* Virtual channels need all inputs from the same scan. */
+   if( (first == 0) && (last == ADC_CHANNELS_PER_CHIP - 1) )
+      adcHarvestVirtual( pChip, aValue, aTimestamp, sample.flags );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924stream.h
+ */
+unsigned int adcFifoLevel( ADC_CHANNEL_T* pChannel )
+{
+   unsigned int tail = READ_ONCE( pChannel->fifo.tail );
+
+   return smp_load_acquire( &pChannel->fifo.head ) - tail;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924stream.h
+ */
+unsigned int adcPopSamples( ADC_CHANNEL_T* pChannel,
+                            ADS7924_SAMPLE_T* paSample, unsigned int max )
+{
+   unsigned int n;
+
+   mutex_lock( &pChannel->fifo.oMutex );
+   for( n = 0; (n < max) && (pChannel->fifo.head != pChannel->fifo.tail); n++ )
+   {
+      paSample[n] = pChannel->fifo.paBuffer[pChannel->fifo.tail & FIFO_MASK];
+      WRITE_ONCE( pChannel->fifo.tail, pChannel->fifo.tail + 1 );
+   }
+   /*
+    * The latency timeout of the remaining samples runs from the oldest
+    * of them, not from the first sample of the drained ones.
+    */
+   if( (n != 0) && (pChannel->fifo.head != pChannel->fifo.tail) &&
+       (pChannel->fifo.wakeup.timeout != 0) )
+   {
+      WRITE_ONCE( pChannel->fifo.deadline,
+                  pChannel->fifo.paBuffer[pChannel->fifo.tail & FIFO_MASK].timestamp +
+                  (u64)pChannel->fifo.wakeup.timeout * NSEC_PER_USEC );
+      hrtimer_start( &pChannel->fifo.oTimer, ns_to_ktime( pChannel->fifo.deadline ),
+                     HRTIMER_MODE_ABS );
+   }
+   mutex_unlock( &pChannel->fifo.oMutex );
+   return n;
+}
+
+/*================================== EOF ====================================*/
@@ -0,0 +1,135 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924stream.h
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Data-ready streaming: Harvesting of each conversion by the
+ *        interrupt into the FIFOs of the channels.
+ * @date 2026.10.18
+ * @see ads7924stream.c
+ * @see STREAMING
+ */
+#ifndef _ADS7924STREAM_H
+#define _ADS7924STREAM_H
+
+#include "ads7924driver.h"
+#include "ads7924timing.h"
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns true if the chip of the given channel is in streaming mode
+ *        or its sequencer is running, read() takes the FIFO in this case.
+ */
+static inline bool adcIsStreaming( ADC_CHANNEL_T* pChannel )
+{
+   return (pChannel->pParent->streamMode != ADS7924_STREAM_OFF) ||
+          (pChannel->pParent->sequencer.mode != ADS7924_SEQ_OFF);
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Initializes the FIFO object of the given channel.
+ * @note The buffer becomes allocated by adcSetStreaming().
+ */
+extern void adcInitStream( ADC_CHANNEL_T* pChannel );
+
+/*!----------------------------------------------------------------------------
+ * @brief Releases the FIFO buffer of the given channel.
+ */
+extern void adcFreeStream( ADC_CHANNEL_T* pChannel );
+
+/*!----------------------------------------------------------------------------
+ * @brief Allocates the FIFOs of the present channels if not already done
+ *        and clears them.
+ * @retval ==0 OK
+ * @retval <0  -ENOMEM
+ */
+extern int adcPrepareFifos( ADS7924_T* pChip );
+
+/*!----------------------------------------------------------------------------
+ * @brief Wakes all readers of the chip, e.g. when the FIFOs will no longer
+ *        be filled.
+ */
+extern void adcReleaseReaders( ADS7924_T* pChip );
+
+/*!----------------------------------------------------------------------------
+ * @brief Sets the wakeup condition of the readers of the channel FIFO.
+ * @retval ==0 OK
+ * @retval <0  Error (-EINVAL)
+ * @see ADS7924_WAKEUP_T
+ */
+extern int adcSetWakeup( ADC_CHANNEL_T* pChannel, const ADS7924_WAKEUP_T* pWakeup );
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns true if the FIFO of the channel fulfills the wakeup
+ *        condition: The watermark is reached or the oldest sample has
+ *        exceeded the timeout.
+ */
+extern bool adcIsFifoReady( ADC_CHANNEL_T* pChannel );
+
+/*!----------------------------------------------------------------------------
+ * @brief Runs the pipeline of the channel on the sample, stores the result
+ *        as last result of the channel, puts it in the FIFO and wakes the
+ *        readers.
+ *
+ * A sample dropped by the pipeline becomes not delivered at all.
+ * @see PIPELINE
+ */
+extern void adcDeliverSample( ADC_CHANNEL_T* pChannel, const ADS7924_SAMPLE_T* pSample );
+
+/*!----------------------------------------------------------------------------
+ * @brief Switches the streaming mode of the chip.
+ *
+ * Programs the INT-pin function in INTCONFIG, allocates the FIFOs of
+ * the present channels if not already done and clears them.
+ * @param pChip Pointer to the chip object.
+ * @param streamMode ADS7924_STREAM_OFF, ADS7924_STREAM_CONVERSION or
+ *                   ADS7924_STREAM_SCAN
+ * @retval ==0 OK
+ * @retval <0  Error (-EINVAL, -EBUSY, -ENOMEM or -EIO)
+ */
+extern int adcSetStreaming( ADS7924_T* pChip, u8 streamMode );
+
+/*!----------------------------------------------------------------------------
+ * @brief Harvests the analog values after a data-ready interrupt and puts
+ *        the samples in the FIFOs of the opened channels.
+ *
+ * Becomes invoked by the bottom half of the interrupt.
+ * @param pChip Pointer to the chip object.
+ * @param pTiming Timing of the current configuration or NULL if the
+ *                conversion instants can't be reconstructed.
+ * @param mode Value of MODECNTRL.
+ * @param scanEnd Time of the scan end in ns.
+ */
+extern void adcStreamHarvest( ADS7924_T* pChip, const ADS7924_TIMING_T* pTiming,
+                              u8 mode, u64 scanEnd );
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns the number of samples in the FIFO of the given channel.
+ *
+ * Lockless snapshot, usable as condition of wait_event_interruptible().
+ */
+extern unsigned int adcFifoLevel( ADC_CHANNEL_T* pChannel );
+
+/*!----------------------------------------------------------------------------
+ * @brief Removes up to max of the oldest samples of the FIFO and copies
+ *        them in paSample.
+ * @return Number of copied samples, 0 if the FIFO is empty.
+ */
+extern unsigned int adcPopSamples( ADC_CHANNEL_T* pChannel,
+                                   ADS7924_SAMPLE_T* paSample, unsigned int max );
+
+#endif /* ifndef _ADS7924STREAM_H */
+/*================================== EOF ====================================*/
@@ -0,0 +1,540 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924timing.c
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Timing model of the ADS7924 and solver for sample-rates.
+ *
+ * Timing model, see ADS7924.pdf chapters "Timing Characteristics" and
+ * "Operating Modes":
+ * @code
+ * tACQ   = ACQTIME   * 2us + 6us
+ * tCONV  = 4us
+ * tPWRUP = PWRUPTIME * 2us
+ * tSLEEP = 2.5ms << SLPTIME, divided by 4 (SLPDIV4) or multiplied by 8 (SLPMULT8)
+ *
+ * Auto-Single:                 period = tACQ + tCONV
+ * Auto-Scan:                   period = 4 * (tACQ + tCONV)
+ * Auto-Single with sleep:      period = tPWRUP + tACQ + tCONV + tSLEEP
+ * Auto-Scan with sleep:        period = 4 * (tPWRUP + tACQ + tCONV + tSLEEP)
+ * Auto-Burst-Scan with sleep:  period = tPWRUP + 4 * (tACQ + tCONV) + tSLEEP
+ * @endcode
+ *
+ * @date 2026.10.18
+ * @see ads7924timing.h
+ */
+#include "ads7924core.h"
+#include "ads7924timing.h"
+#include <linux/math64.h>
+
+#define NS_PER_US         1000
+#define MHZ_PER_NS        1000000000000ULL //!<@brief 1 / 1ns in millihertz
+#define SLEEP_BASE_NS     2500000          //!<@brief 2.5 ms
+#define SLPTIME_MASK      (SLPTIME2 | SLPTIME1 | SLPTIME0)
+#define SLEEP_MASK        (SLPDIV4 | SLPMULT8 | SLPTIME_MASK)
+
+/*!
+ * @defgroup SCAN_ESTIMATION Parameters of the scan period estimation
+ * @{
+ */
+#define SCAN_LOCK_COUNT      16 //!<@brief Interrupts until full confidence.
+#define SCAN_MAX_GAP         64 //!<@brief Maximum of missed scans between two interrupts.
+#define SCAN_PHASE_SHIFT      2 //!<@brief Proportional gain 1/4 of the loop.
+#define SCAN_PERIOD_SHIFT     4 //!<@brief Integral gain 1/16 of the loop.
+#define SCAN_JITTER_SHIFT     3 //!<@brief Jitter becomes averaged over 8 interrupts.
+#define SCAN_TOLERANCE_SHIFT  3 //!<@brief Period is limited to nominal +/- 12.5%.
+#define SCAN_RATIO_SHIFT     20 //!<@brief Fixed point of the correction factor.
+#define SCAN_DRIFT_SHIFT     10 //!<@brief Residual drift 1/1024 of a confident estimation.
+/*! @} */
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns tPWRUP in nanoseconds.
+ */
+static inline u32 getPwrUpTime( u8 pwrConfig )
+{
+   return (pwrConfig & ADS7924_PWRUPTIME_MASK) * 2 * NS_PER_US;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns tSLEEP in nanoseconds.
+ */
+static inline u64 getSleepTime( u8 slpConfig )
+{
+   u64 sleepTime = (u64)SLEEP_BASE_NS << (slpConfig & SLPTIME_MASK);
+
+   if( (slpConfig & SLPDIV4) != 0 )
+      return sleepTime / 4;
+   if( (slpConfig & SLPMULT8) != 0 )
+      return sleepTime * 8;
+   return sleepTime;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns true if the given mode uses the sleep timer.
+ */
+static inline bool isSleepMode( u8 mode )
+{
+   switch( mode & ADS7924_MODE_AUTO_BURST_SCAN_SLEEP )
+   {
+      case ADS7924_MODE_AUTO_SINGLE_SLEEP:
+      case ADS7924_MODE_AUTO_SCAN_SLEEP:
+      case ADS7924_MODE_AUTO_BURST_SCAN_SLEEP:
+         return true;
+   }
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924timing.h
+ */
+bool adcCalculateTiming( ADS7924_TIMING_T* pTiming,
+                         u8 mode, u8 slpConfig, u8 acqConfig, u8 pwrConfig )
+{
+   memset( pTiming, 0, sizeof( ADS7924_TIMING_T ) );
+   pTiming->convTime = adcGetConvTime( acqConfig );
+   if( isSleepMode( mode ) )
+   {
+      pTiming->pwrUpTime = getPwrUpTime( pwrConfig );
+      pTiming->sleepTime = getSleepTime( slpConfig );
+   }
+
+   switch( mode & ADS7924_MODE_AUTO_BURST_SCAN_SLEEP )
+   {
+      case ADS7924_MODE_AUTO_SINGLE:
+      case ADS7924_MODE_AUTO_SINGLE_SLEEP:
+      {
+         pTiming->slot = pTiming->pwrUpTime + pTiming->convTime + pTiming->sleepTime;
+         pTiming->period = pTiming->slot;
+         break;
+      }
+      case ADS7924_MODE_AUTO_SCAN:
+      case ADS7924_MODE_AUTO_SCAN_SLEEP:
+      {
+         pTiming->slot = pTiming->pwrUpTime + pTiming->convTime + pTiming->sleepTime;
+         pTiming->period = ADC_CHANNELS_PER_CHIP * pTiming->slot;
+         break;
+      }
+      case ADS7924_MODE_AUTO_BURST_SCAN_SLEEP:
+      {
+         pTiming->slot = pTiming->convTime;
+         pTiming->period = pTiming->pwrUpTime +
+                           ADC_CHANNELS_PER_CHIP * pTiming->slot +
+                           pTiming->sleepTime;
+         break;
+      }
+      default:
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924timing.h
+ */
+u64 adcReconstructTimestamp( const ADS7924_TIMING_T* pTiming,
+                             u8 mode, int channel, u64 irqTimestamp )
+{
+   u64 offset = ADS7924_CONV_TIME_NS;
+
+   switch( mode & ADS7924_MODE_AUTO_BURST_SCAN_SLEEP )
+   {
+      case ADS7924_MODE_AUTO_SINGLE:
+      case ADS7924_MODE_AUTO_SINGLE_SLEEP:
+      {
+         if( channel != (mode & (SEL_ID1 | SEL_ID0)) )
+            return 0;
+         break;
+      }
+      case ADS7924_MODE_AUTO_SCAN:
+      case ADS7924_MODE_AUTO_SCAN_SLEEP:
+      case ADS7924_MODE_AUTO_BURST_SCAN_SLEEP:
+      {
+         offset += (ADC_CHANNELS_PER_CHIP - 1 - channel) * pTiming->slot;
+         break;
+      }
+      default:
+      {
+         return 0;
+      }
+   }
+
+   if( irqTimestamp <= offset )
+      return 0;
+   return irqTimestamp - offset;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924timing.h
+ */
+void _ADS7924_INIT adcInitScanEstimation( ADS7924_T* pChip )
+{
+   mutex_init( &pChip->scanEstimation.oMutex );
+   pChip->scanEstimation.correction = false;
+   pChip->scanEstimation.nominal    = 0;
+   pChip->scanEstimation.count      = 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Restarts the estimation with the nominal period.
+ * @note The caller has to hold scanEstimation.oMutex.
+ */
+static void resetScanEstimation( ADS7924_T* pChip, u64 nominal, u64 timestamp )
+{
+   pChip->scanEstimation.nominal = nominal;
+   pChip->scanEstimation.period  = nominal;
+   pChip->scanEstimation.phase   = timestamp;
+   pChip->scanEstimation.jitter  = 0;
+   pChip->scanEstimation.count   = 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns the confidence 0 to 1000 of the current estimation.
+ *
+ * It grows with the number of interrupts until SCAN_LOCK_COUNT and
+ * decreases with the jitter in relation to the period.
+ * @note The caller has to hold scanEstimation.oMutex.
+ */
+static u32 getScanConfidence( ADS7924_T* pChip )
+{
+   u64 quality;
+   u32 lock;
+
+   if( pChip->scanEstimation.period == 0 )
+      return 0;
+
+   lock = min_t( u32, pChip->scanEstimation.count, SCAN_LOCK_COUNT ) * 1000 / SCAN_LOCK_COUNT;
+   quality = div64_u64( 1000 * pChip->scanEstimation.period,
+                        pChip->scanEstimation.period + 4 * pChip->scanEstimation.jitter );
+   return (u32)(lock * quality / 1000);
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924timing.h
+ */
+u64 adcUpdateScanEstimation( ADS7924_T* pChip,
+                             ADS7924_TIMING_T* pTiming, u64 irqTimestamp )
+{
+   u64 delta, k, predicted, absError, ratio;
+   s64 error;
+   u64 ret = irqTimestamp;
+
+   mutex_lock( &pChip->scanEstimation.oMutex );
+   if( pChip->scanEstimation.nominal != pTiming->period )
+   {
+      /* Timing configuration has been changed. */
+      resetScanEstimation( pChip, pTiming->period, irqTimestamp );
+      goto L_UNLOCK;
+   }
+
+   if( irqTimestamp <= pChip->scanEstimation.phase )
+      goto L_UNLOCK;
+
+   /*
+    * Alarm-interrupts doesn't come by each scan, so the distance to the
+    * last interrupt is a integer multiple k of the period.
+    */
+   delta = irqTimestamp - pChip->scanEstimation.phase;
+   k = div64_u64( delta + pChip->scanEstimation.period / 2,
+                  pChip->scanEstimation.period );
+   if( k == 0 )
+      goto L_UNLOCK;
+   if( k > SCAN_MAX_GAP )
+   {
+      /* Too long gap for a reliable phase, synchronize again. */
+      pChip->scanEstimation.phase = irqTimestamp;
+      goto L_UNLOCK;
+   }
+
+   predicted = pChip->scanEstimation.phase + k * pChip->scanEstimation.period;
+   error = (s64)(irqTimestamp - predicted);
+   absError = abs( error );
+
+   pChip->scanEstimation.jitter += ((s64)absError - (s64)pChip->scanEstimation.jitter) >> SCAN_JITTER_SHIFT;
+
+   if( absError > pChip->scanEstimation.period / 4 )
+   {
+      /* Outlier, e.g. a delayed interrupt: synchronize again. */
+      pChip->scanEstimation.phase = irqTimestamp;
+      goto L_UNLOCK;
+   }
+
+   pChip->scanEstimation.phase = predicted + (error >> SCAN_PHASE_SHIFT);
+   pChip->scanEstimation.period += div_s64( error, (s32)(k << SCAN_PERIOD_SHIFT) );
+   pChip->scanEstimation.period = clamp( pChip->scanEstimation.period,
+                    pChip->scanEstimation.nominal - (pChip->scanEstimation.nominal >> SCAN_TOLERANCE_SHIFT),
+                    pChip->scanEstimation.nominal + (pChip->scanEstimation.nominal >> SCAN_TOLERANCE_SHIFT) );
+   if( pChip->scanEstimation.count < UINT_MAX )
+      pChip->scanEstimation.count++;
+
+   if( !pChip->scanEstimation.correction ||
+       (getScanConfidence( pChip ) < ADS7924_DRIFT_MIN_CONFIDENCE) )
+      goto L_UNLOCK;
+
+   /*
+    * Correction of the timestamps: The filtered phase replaces the
+    * interrupt time and the slots becomes scaled by the measured period.
+    */
+   ratio = div64_u64( pChip->scanEstimation.period << SCAN_RATIO_SHIFT,
+                      pChip->scanEstimation.nominal );
+   pTiming->slot   = (pTiming->slot * ratio) >> SCAN_RATIO_SHIFT;
+   pTiming->period = pChip->scanEstimation.period;
+   ret = pChip->scanEstimation.phase;
+
+L_UNLOCK:
+   mutex_unlock( &pChip->scanEstimation.oMutex );
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924timing.h
+ */
+int adcGetScanRate( ADS7924_T* pChip, ADS7924_SCAN_RATE_T* pScanRate )
+{
+   ADS7924_TIMING_T timing;
+   u8 mode;
+   u8 aConfig[PWRCONFIG - SLPCONFIG + 1];
+   int ret;
+
+   memset( pScanRate, 0, sizeof( ADS7924_SCAN_RATE_T ) );
+
+   ret = adcReadTimingShadow( pChip, &mode, aConfig );
+   if( ret < 0 )
+      return ret;
+
+   mutex_lock( &pChip->scanEstimation.oMutex );
+   pScanRate->correction = pChip->scanEstimation.correction;
+   if( adcCalculateTiming( &timing, mode, aConfig[0], aConfig[1], aConfig[2] ) )
+   {
+      pScanRate->nominalPeriod  = timing.period;
+      pScanRate->measuredPeriod = timing.period;
+      /* Is the estimation of the current configuration? */
+      if( pChip->scanEstimation.nominal == timing.period )
+      {
+         pScanRate->measuredPeriod = pChip->scanEstimation.period;
+         pScanRate->jitter         = pChip->scanEstimation.jitter;
+         pScanRate->count          = pChip->scanEstimation.count;
+         pScanRate->confidence     = getScanConfidence( pChip );
+      }
+      pScanRate->rate = div64_u64( MHZ_PER_NS + pScanRate->measuredPeriod / 2,
+                                   pScanRate->measuredPeriod );
+   }
+   mutex_unlock( &pChip->scanEstimation.oMutex );
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924timing.h
+ */
+void adcSetDriftCorrection( ADS7924_T* pChip, bool enable )
+{
+   mutex_lock( &pChip->scanEstimation.oMutex );
+   pChip->scanEstimation.correction = enable;
+   mutex_unlock( &pChip->scanEstimation.oMutex );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924timing.h
+ */
+u64 adcPredictConversion( ADS7924_T* pChip, int channel, u64 now, u64* pInstant )
+{
+   ADS7924_TIMING_T timing;
+   u8 mode;
+   u8 aConfig[PWRCONFIG - SLPCONFIG + 1];
+   u64 scanEnd, instant, end, limit, guard, ratio, n;
+   u64 modeTimestamp;
+   u32 driftShift = SCAN_TOLERANCE_SHIFT;
+
+   *pInstant = 0;
+   if( adcReadTimingShadow( pChip, &mode, aConfig ) < 0 )
+      return 0;
+   if( !adcCalculateTiming( &timing, mode, aConfig[0], aConfig[1], aConfig[2] ) )
+      return 0;
+
+   /*
+    * A window of one period plus the tolerance of the sleep oscillator
+    * contains in any case a conversion of the channel.
+    */
+   limit = now + timing.period + (timing.period >> SCAN_TOLERANCE_SHIFT) +
+           ADS7924_CONV_TIME_NS;
+
+   modeTimestamp = adcGetModeTimestamp( pChip );
+   guard = ADS7924_CONV_TIME_NS;
+
+   mutex_lock( &pChip->scanEstimation.oMutex );
+   if( (pChip->scanEstimation.nominal == timing.period) &&
+       (pChip->scanEstimation.phase > modeTimestamp) )
+   {
+      /* Scan end of the last interrupt in the current configuration. */
+      scanEnd = pChip->scanEstimation.phase;
+      guard += 2 * pChip->scanEstimation.jitter;
+      if( getScanConfidence( pChip ) >= ADS7924_DRIFT_MIN_CONFIDENCE )
+      {
+         ratio = div64_u64( pChip->scanEstimation.period << SCAN_RATIO_SHIFT,
+                            pChip->scanEstimation.nominal );
+         timing.slot   = (timing.slot * ratio) >> SCAN_RATIO_SHIFT;
+         timing.period = pChip->scanEstimation.period;
+         driftShift = SCAN_DRIFT_SHIFT;
+      }
+   }
+   else
+   {
+      /*
+       * No interrupt since the last mode change: The first scan ends
+       * after power-up, acquisition and conversion of all channels.
+       */
+      scanEnd = modeTimestamp + timing.pwrUpTime + timing.convTime;
+      if( (mode & ADS7924_MODE_AUTO_BURST_SCAN_SLEEP) != ADS7924_MODE_AUTO_SINGLE &&
+          (mode & ADS7924_MODE_AUTO_BURST_SCAN_SLEEP) != ADS7924_MODE_AUTO_SINGLE_SLEEP )
+         scanEnd += (ADC_CHANNELS_PER_CHIP - 1) * timing.slot;
+   }
+   mutex_unlock( &pChip->scanEstimation.oMutex );
+
+   instant = adcReconstructTimestamp( &timing, mode, channel, scanEnd );
+   if( instant == 0 )
+      return 0;
+
+   if( now >= instant )
+   {
+      /* Next conversion after now. */
+      n = div64_u64( now - instant, timing.period ) + 1;
+      instant += n * timing.period;
+   }
+   end = instant + ADS7924_CONV_TIME_NS;
+
+   /* The uncertainty grows with the distance to the reference. */
+   guard += (end - scanEnd) >> driftShift;
+   if( end + guard > limit )
+   {
+      DEBUG_MESSAGE( ": Prediction of channel %d too uncertain\n", channel );
+      return limit;
+   }
+
+   *pInstant = instant;
+   return end + guard;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Absolute difference of two periods.
+ */
+static inline u64 getDeviation( u64 a, u64 b )
+{
+   return (a > b)? (a - b) : (b - a);
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924timing.h
+ */
+int adcSolveRate( ADS7924_RATE_T* pRate, u8* paMask )
+{
+   static const u8 aSleepModifier[] = { 0, SLPDIV4, SLPMULT8 };
+   ADS7924_TIMING_T timing;
+   u64 target;
+   u64 deviation;
+   u64 bestDeviation = U64_MAX;
+   unsigned int modifier, slpTime, acqTime, pwrUpTime;
+   unsigned int numSleepCases;
+   unsigned int numPwrUpCases;
+   u8 slp, acq, pwr;
+
+   if( pRate->rate == 0 )
+   {
+      ERROR_MESSAGE( ": Rate of zero not possible!\n" );
+      return -EINVAL;
+   }
+
+   switch( pRate->mode & ADS7924_MODE_AUTO_BURST_SCAN_SLEEP )
+   {
+      case ADS7924_MODE_AUTO_SINGLE:
+      case ADS7924_MODE_AUTO_SCAN:
+      case ADS7924_MODE_AUTO_SINGLE_SLEEP:
+      case ADS7924_MODE_AUTO_SCAN_SLEEP:
+      case ADS7924_MODE_AUTO_BURST_SCAN_SLEEP:
+         break;
+      default:
+      {
+         ERROR_MESSAGE( ": Mode 0x%02X isn't a automatic mode!\n", pRate->mode );
+         return -EINVAL;
+      }
+   }
+
+   target = div_u64( MHZ_PER_NS, pRate->rate );
+
+   paMask[0] = 0;
+   paMask[1] = ADS7924_ACQTIME_MASK;
+   paMask[2] = 0;
+   numSleepCases = 1;
+   numPwrUpCases = 1;
+   if( isSleepMode( pRate->mode ) )
+   {
+      paMask[0] = SLEEP_MASK;
+      paMask[2] = ADS7924_PWRUPTIME_MASK;
+      numSleepCases = ARRAY_SIZE( aSleepModifier ) * (SLPTIME_MASK + 1);
+      numPwrUpCases = ADS7924_PWRUPTIME_MASK + 1;
+   }
+
+   /*
+    * At most 3 * 8 * 32 * 32 = 24576 cases, that's cheap enough for a
+    * complete search. By equal deviation the last found candidate wins,
+    * this prefers the longer acquire time.
+    */
+   for( modifier = 0; modifier < numSleepCases; modifier++ )
+   {
+      slpTime = modifier % (SLPTIME_MASK + 1);
+      slp = aSleepModifier[modifier / (SLPTIME_MASK + 1)] | slpTime;
+      for( pwrUpTime = 0; pwrUpTime < numPwrUpCases; pwrUpTime++ )
+      {
+         pwr = pwrUpTime;
+         if( (numPwrUpCases > 1) && (getPwrUpTime( pwr ) < pRate->minPwrUpTime) )
+            continue;
+         for( acqTime = 0; acqTime <= ADS7924_ACQTIME_MASK; acqTime++ )
+         {
+            acq = acqTime;
+            if( (adcGetConvTime( acq ) - ADS7924_CONV_TIME_NS) < pRate->minAcqTime )
+               continue;
+            adcCalculateTiming( &timing, pRate->mode, slp, acq, pwr );
+            deviation = getDeviation( timing.period, target );
+            if( deviation > bestDeviation )
+               continue;
+            bestDeviation = deviation;
+            pRate->slpConfig = slp;
+            pRate->acqConfig = acq;
+            pRate->pwrConfig = pwr;
+         }
+      }
+   }
+
+   if( bestDeviation == U64_MAX )
+   {
+      ERROR_MESSAGE( ": No solution for the given minimum times!\n" );
+      return -EINVAL;
+   }
+
+   adcCalculateTiming( &timing, pRate->mode,
+                       pRate->slpConfig, pRate->acqConfig, pRate->pwrConfig );
+   pRate->period   = timing.period;
+   pRate->convTime = timing.convTime;
+   pRate->rate     = div64_u64( MHZ_PER_NS + timing.period / 2, timing.period );
+
+   DEBUG_MESSAGE( ": Target: %llu ns, achieved: %llu ns, SLP: 0x%02X, ACQ: 0x%02X, PWR: 0x%02X\n",
+                  (unsigned long long)target, (unsigned long long)timing.period,
+                  pRate->slpConfig, pRate->acqConfig, pRate->pwrConfig );
+   return 0;
+}
+
+/*================================== EOF ====================================*/
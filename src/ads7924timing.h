@@ -0,0 +1,189 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924timing.h
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Timing model of the ADS7924 and solver for sample-rates.
+ * @date 2026.10.18
+ * @see ads7924timing.c
+ * @see ADS7924_IOCTL_SET_RATE
+ */
+#ifndef _ADS7924TIMING_H
+#define _ADS7924TIMING_H
+
+#include "ads7924driver.h"
+
+/*!
+ * @brief Conversion time tCONV in nanoseconds.
+ * See ADS7924.pdf chapter "Timing Characteristics".
+ */
+#define ADS7924_CONV_TIME_NS 4000
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns tACQ + tCONV in nanoseconds.
+ * @param acqConfig Value of ACQCONFIG.
+ */
+static inline u32 adcGetConvTime( u8 acqConfig )
+{
+   return ((acqConfig & ADS7924_ACQTIME_MASK) * 2 + 6) * 1000 + ADS7924_CONV_TIME_NS;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Timing of a register configuration, all times in nanoseconds.
+ * @see adcCalculateTiming
+ */
+typedef struct
+{
+   u64 period;    //!<@brief Sample period of each converted channel.
+   u64 slot;      //!<@brief Distance of two consecutive conversions within a scan.
+   u64 sleepTime; //!<@brief Sleep time, 0 in modes without sleep.
+   u32 pwrUpTime; //!<@brief Power-up time, 0 in modes without sleep.
+   u32 convTime;  //!<@brief tACQ + tCONV
+} ADS7924_TIMING_T;
+
+/*!----------------------------------------------------------------------------
+ * @brief Calculates the timing of the given register values by the timing
+ *        model of the ADS7924 datasheet.
+ * @param pTiming Target object.
+ * @param mode Value of MODECNTRL.
+ * @param slpConfig Value of SLPCONFIG.
+ * @param acqConfig Value of ACQCONFIG.
+ * @param pwrConfig Value of PWRCONFIG.
+ * @retval true  Mode is a automatic mode, pTiming is valid.
+ * @retval false Mode has no periodic timing.
+ */
+extern bool adcCalculateTiming( ADS7924_TIMING_T* pTiming,
+                                u8 mode, u8 slpConfig, u8 acqConfig, u8 pwrConfig );
+
+/*!----------------------------------------------------------------------------
+ * @brief Reconstructs the conversion instant of a channel from the time of
+ *        the hardware-interrupt which has signaled the end of the scan.
+ *
+ * In the scan-modes the conversion of channel 3 ends at the interrupt,
+ * each previous channel was converted one slot earlier.
+ * The conversion instant is the end of the acquisition, which is
+ * tCONV before the end of the conversion.
+ * @param pTiming Timing of the current register configuration.
+ * @param mode Value of MODECNTRL.
+ * @param channel Channel number 0 to 3.
+ * @param irqTimestamp Time of the hardware-interrupt in ns.
+ * @retval >0 Reconstructed conversion instant in ns.
+ * @retval ==0 Channel wasn't converted in this mode.
+ * @see ADS7924_SAMPLE_T
+ */
+extern u64 adcReconstructTimestamp( const ADS7924_TIMING_T* pTiming,
+                                    u8 mode, int channel, u64 irqTimestamp );
+
+/*!----------------------------------------------------------------------------
+ * @brief Moves a reconstructed conversion instant to the conversion whose
+ *        value the data register holds at the time of reading.
+ *
+ * The interrupt signals the end of a conversion, but the threaded handler
+ * reads the data register later. In the automatic modes the register
+ * becomes overwritten each period, so after a latency of more than one
+ * period the value belongs to a later conversion than the interrupt.
+ * @param timestamp Reconstructed conversion instant in ns.
+ * @param period Sample period of the channel in ns, 0: not periodic.
+ * @param readTime Time in ns just before the register has been read.
+ * @return Conversion instant of the value read.
+ */
+static inline u64 adcAlignToRead( u64 timestamp, u64 period, u64 readTime )
+{
+   u64 conversionEnd = timestamp + ADS7924_CONV_TIME_NS;
+
+   if( (period == 0) || (timestamp == 0) || (readTime < conversionEnd + period) )
+      return timestamp;
+   return timestamp + div64_u64( readTime - conversionEnd, period ) * period;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Initializing of the scan period estimation of a chip.
+ */
+extern void adcInitScanEstimation( ADS7924_T* pChip );
+
+/*!----------------------------------------------------------------------------
+ * @brief Updates the scan period estimation by a further hardware-interrupt.
+ *
+ * Phase-locked loop of second order: The phase error of the interrupt
+ * against the predicted scan end corrects the phase by 1/4 and the period
+ * by 1/16. Gaps of missed scans and outliers becomes tolerated, a change of
+ * the timing configuration restarts the estimation.
+ *
+ * If the correction is enabled and the estimation is confident enough,
+ * the slot and period of pTiming becomes scaled by the measured period.
+ * @param pChip Pointer to the chip object.
+ * @param pTiming Timing of the current configuration, may be corrected.
+ * @param irqTimestamp Time of the hardware-interrupt in ns.
+ * @return The time of the scan end which shall be used for
+ *         adcReconstructTimestamp.
+ * @see ADS7924_SCAN_RATE_T
+ */
+extern u64 adcUpdateScanEstimation( ADS7924_T* pChip,
+                                    ADS7924_TIMING_T* pTiming, u64 irqTimestamp );
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns the measured scan rate of the chip.
+ * @retval ==0 OK
+ * @retval <0  Error
+ */
+extern int adcGetScanRate( ADS7924_T* pChip, ADS7924_SCAN_RATE_T* pScanRate );
+
+/*!----------------------------------------------------------------------------
+ * @brief Enables or disables the correction of the timestamps by the
+ *        measured scan rate.
+ */
+extern void adcSetDriftCorrection( ADS7924_T* pChip, bool enable );
+
+/*!----------------------------------------------------------------------------
+ * @brief Predicts the end of the next conversion of a channel in the
+ *        automatic modes.
+ *
+ * Reference is the filtered scan end of the last interrupt if there is one
+ * in the current configuration, otherwise the end of the first scan after
+ * the last write of MODECNTRL. The next conversion follows by whole periods,
+ * measured ones if the scan period estimation is confident enough.
+ * The returned time includes a guard for jitter and drift, which grows
+ * with the distance to the reference. It is limited to one period plus
+ * the oscillator tolerance after now, in this case the instant is unknown.
+ * @param pChip Pointer to the chip object.
+ * @param channel Channel number 0 to 3.
+ * @param now Current time in ns.
+ * @param pInstant Target of the predicted conversion instant in ns,
+ *                 0 if unknown.
+ * @retval >0 Time in ns after which the conversion is completed.
+ * @retval ==0 Chip isn't in a automatic mode or the channel isn't converted.
+ * @see ADS7924_FRESH_READ_NEXT_SCAN
+ */
+extern u64 adcPredictConversion( ADS7924_T* pChip, int channel, u64 now, u64* pInstant );
+
+/*!----------------------------------------------------------------------------
+ * @brief Seeks the register combination which achieves the sample-rate
+ *        requested in pRate closest.
+ *
+ * @param pRate In: requested rate, mode and minimum times;
+ *              out: achieved rate, period, conversion time and
+ *              register values.
+ * @param paMask Target of the three masks (SLPCONFIG, ACQCONFIG, PWRCONFIG)
+ *               of the bits which are determined by the solution.
+ *               All other bits shall be preserved.
+ * @retval ==0 OK
+ * @retval <0  -EINVAL
+ */
+extern int adcSolveRate( ADS7924_RATE_T* pRate, u8* paMask );
+
+#endif /* ifndef _ADS7924TIMING_H */
+/*================================== EOF ====================================*/
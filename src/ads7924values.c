@@ -0,0 +1,167 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924values.c
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Read-only page of the latest values of all channels.
+ * @date 2026.10.18
+ * @see ads7924values.h
+ * @see VALUES
+ */
+#include <linux/mm.h>
+#include "ads7924core.h"
+#include "ads7924values.h"
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924values.h
+ */
+void _ADS7924_INIT adcInitValues( VALUES_T* pValues )
+{
+   pValues->minor = -1;
+   atomic_set( &pValues->openCounter, 0 );
+   pValues->pPage = NULL;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Binds the result of the channel to the slot of its minor number
+ *        and copies the current result into it.
+ */
+static void bindChannel( ADS7924_VALUES_T* pPage, ADC_CHANNEL_T* pChannel )
+{
+   ADS7924_VALUE_SLOT_T* pSlot;
+
+   if( pChannel->minor >= ADS7924_VALUES_SLOTS )
+   {
+      ERROR_MESSAGE( ": Minor %d out of shared page!\n", pChannel->minor );
+      return;
+   }
+
+   pSlot = &pPage->aSlot[pChannel->minor];
+   pSlot->channel = pChannel->cannelNumber;
+   if( pPage->count <= pChannel->minor )
+      pPage->count = pChannel->minor + 1;
+
+   write_seqlock( &pChannel->result.oLock );
+   pChannel->result.pSlot = pSlot;
+   if( pChannel->result.isValid )
+      updateSlot( &pChannel->result );
+   write_sequnlock( &pChannel->result.oLock );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924values.h
+ */
+int _ADS7924_INIT adcAllocValues( VALUES_T* pValues )
+{
+   ADS7924_VALUES_T* pPage;
+   BUS_T*            pBus;
+   int               i, j;
+
+   pPage = (ADS7924_VALUES_T*)get_zeroed_page( GFP_KERNEL );
+   if( pPage == NULL )
+   {
+      ERROR_MESSAGE( ": Can not allocate the page of %svalues\n", g_data.pName );
+      return -ENOMEM;
+   }
+
+   for( i = 0; i < ARRAY_SIZE( pPage->aSlot ); i++ )
+      pPage->aSlot[i].channel = ADS7924_VALUES_UNUSED;
+
+   FOR_EACH_I2C_BUS( pBus )
+   {
+      for( i = 0; i < ARRAY_SIZE( pBus->paChip ); i++ )
+      {
+         if( pBus->paChip[i] == NULL )
+            continue;
+         for( j = 0; j < ADC_CHANNELS_PER_CHIP; j++ )
+         {
+            if( pBus->paChip[i]->paChannel[j] != NULL )
+               bindChannel( pPage, pBus->paChip[i]->paChannel[j] );
+         }
+      }
+   }
+
+   pPage->magic = ADS7924_VALUES_MAGIC;
+   pValues->pPage = pPage;
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924values.h
+ */
+void adcFreeValues( VALUES_T* pValues )
+{
+   BUS_T* pBus;
+   int    i, j;
+
+   if( pValues->pPage == NULL )
+      return;
+
+   FOR_EACH_I2C_BUS( pBus )
+   {
+      for( i = 0; i < ARRAY_SIZE( pBus->paChip ); i++ )
+      {
+         if( pBus->paChip[i] == NULL )
+            continue;
+         for( j = 0; j < ADC_CHANNELS_PER_CHIP; j++ )
+         {
+            ADC_CHANNEL_T* pChannel = pBus->paChip[i]->paChannel[j];
+            if( pChannel == NULL )
+               continue;
+            write_seqlock( &pChannel->result.oLock );
+            pChannel->result.pSlot = NULL;
+            write_sequnlock( &pChannel->result.oLock );
+         }
+      }
+   }
+
+   /*
+    * Pages still mapped by a process keep their own reference,
+    * see vm_insert_page().
+    */
+   free_page( (unsigned long)pValues->pPage );
+   pValues->pPage = NULL;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924values.h
+ */
+int adcMapValues( VALUES_T* pValues, struct vm_area_struct* pVma )
+{
+   if( pValues->pPage == NULL )
+      return -ENODEV;
+
+   if( (pVma->vm_pgoff != 0) || ((pVma->vm_end - pVma->vm_start) > PAGE_SIZE) )
+   {
+      ERROR_MESSAGE( ": Only one page at offset 0 is mappable!\n" );
+      return -EINVAL;
+   }
+
+   if( (pVma->vm_flags & VM_WRITE) != 0 )
+   {
+      ERROR_MESSAGE( ": %svalues is read-only!\n", g_data.pName );
+      return -EPERM;
+   }
+
+   /* mprotect() shall not make the page writable later. */
+   pVma->vm_flags &= ~VM_MAYWRITE;
+   pVma->vm_flags |= VM_DONTEXPAND;
+
+   return vm_insert_page( pVma, pVma->vm_start, virt_to_page( pValues->pPage ) );
+}
+
+/*================================== EOF ====================================*/
@@ -0,0 +1,58 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924values.h
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Read-only page of the latest values of all channels.
+ * @date 2026.10.18
+ * @see ads7924values.c
+ * @see VALUES
+ */
+#ifndef _ADS7924VALUES_H
+#define _ADS7924VALUES_H
+
+#include "ads7924driver.h"
+
+/*!----------------------------------------------------------------------------
+ * @brief Initializes the object of the device /dev/adcvalues,
+ *        except the minor number.
+ */
+extern void adcInitValues( VALUES_T* pValues );
+
+/*!----------------------------------------------------------------------------
+ * @brief Allocates the shared page and binds the result of each channel
+ *        to the slot of its minor number.
+ * @note The minor numbers of all channels has to be already assigned.
+ * @retval ==0 OK
+ * @retval <0  Error (-ENOMEM)
+ */
+extern int adcAllocValues( VALUES_T* pValues );
+
+/*!----------------------------------------------------------------------------
+ * @brief Unbinds the channels and gives the shared page free.
+ */
+extern void adcFreeValues( VALUES_T* pValues );
+
+/*!----------------------------------------------------------------------------
+ * @brief Maps the shared page read-only into the given user-space area.
+ * @retval ==0 OK
+ * @retval <0  Error (-EINVAL, -EPERM or -ENODEV)
+ */
+extern int adcMapValues( VALUES_T* pValues, struct vm_area_struct* pVma );
+
+#endif /* ifndef _ADS7924VALUES_H */
+/*================================== EOF ====================================*/
@@ -0,0 +1,222 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924virtual.c
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Virtual channels derived from two channels of the same chip.
+ * @date 2026.10.18
+ * @see ads7924virtual.h
+ * @see VIRTUAL
+ */
+#include "ads7924core.h"
+#include "ads7924timing.h"
+#include "ads7924sequencer.h"
+#include "ads7924virtual.h"
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924virtual.h
+ */
+void _ADS7924_INIT adcInitVirtual( ADS7924_T* pChip )
+{
+   int i;
+
+   for( i = 0; i < ARRAY_SIZE( pChip->aVirtual ); i++ )
+   {
+      pChip->aVirtual[i].pParent = pChip;
+      pChip->aVirtual[i].number  = i;
+      atomic_set( &pChip->aVirtual[i].openCounter, 0 );
+      mutex_init( &pChip->aVirtual[i].oMutex );
+      init_waitqueue_head( &pChip->aVirtual[i].oWaitQueue );
+      pChip->aVirtual[i].definition.operation = ADS7924_VIRTUAL_OFF;
+      pChip->aVirtual[i].isValid = false;
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924virtual.h
+ */
+int adcSetVirtual( VIRTUAL_CHANNEL_T* pVirtual, const ADS7924_VIRTUAL_T* pDefinition )
+{
+   ADS7924_T* pChip = pVirtual->pParent;
+
+   if( (pDefinition->operation > ADS7924_VIRTUAL_RATIO) ||
+       (pDefinition->channelA >= ADC_CHANNELS_PER_CHIP) ||
+       (pDefinition->channelB >= ADC_CHANNELS_PER_CHIP) ||
+       (pDefinition->shift > 24) )
+   {
+      ERROR_MESSAGE( ": Invalid definition of virtual channel %d\n", pVirtual->number );
+      return -EINVAL;
+   }
+   if( (pDefinition->operation != ADS7924_VIRTUAL_OFF) &&
+       ((pChip->paChannel[pDefinition->channelA] == NULL) ||
+        (pChip->paChannel[pDefinition->channelB] == NULL)) )
+   {
+      ERROR_MESSAGE( ": Input channel of virtual channel %d not present!\n", pVirtual->number );
+      return -ENODEV;
+   }
+
+   mutex_lock( &pVirtual->oMutex );
+   pVirtual->definition = *pDefinition;
+   pVirtual->isValid = false;
+   mutex_unlock( &pVirtual->oMutex );
+   wake_up_interruptible( &pVirtual->oWaitQueue );
+   return 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924virtual.h
+ */
+void adcGetVirtual( VIRTUAL_CHANNEL_T* pVirtual, ADS7924_VIRTUAL_T* pDefinition )
+{
+   mutex_lock( &pVirtual->oMutex );
+   *pDefinition = pVirtual->definition;
+   mutex_unlock( &pVirtual->oMutex );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Evaluates the expression of the definition.
+ * @note The caller has to hold pVirtual->oMutex.
+ */
+static void compute( VIRTUAL_CHANNEL_T* pVirtual, const VALUE_T* paValue,
+                     const u64* paTimestamp, u8 flags )
+{
+   const ADS7924_VIRTUAL_T* pDef = &pVirtual->definition;
+   ADS7924_VIRTUAL_SAMPLE_T* pResult = &pVirtual->result;
+   s64 a = (s64)pDef->gainA * paValue[pDef->channelA];
+   s64 b = (s64)pDef->gainB * paValue[pDef->channelB];
+   s64 value = 0;
+
+   pResult->flags = flags;
+   if( pDef->operation == ADS7924_VIRTUAL_LINEAR )
+   {
+      /* Division instead of shift: Rounding towards zero for negative values too. */
+      value = div64_s64( a + b + pDef->offset, 1LL << pDef->shift );
+   }
+   else if( b != 0 )
+   {
+      value = div64_s64( (a + pDef->offset) * (1LL << pDef->shift), b );
+   }
+   else
+   {
+      pResult->flags |= ADS7924_VIRTUAL_INVALID;
+   }
+
+   pResult->value     = clamp_t( s64, value, S32_MIN, S32_MAX );
+   pResult->timestamp = paTimestamp[pDef->channelA] / 2 + paTimestamp[pDef->channelB] / 2;
+   pResult->number    = pVirtual->number;
+   pResult->dummy     = 0;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924virtual.h
+ */
+void adcHarvestVirtual( ADS7924_T* pChip, const VALUE_T* paValue,
+                        const u64* paTimestamp, u8 flags )
+{
+   VIRTUAL_CHANNEL_T* pVirtual;
+   int i;
+
+   for( i = 0; i < ARRAY_SIZE( pChip->aVirtual ); i++ )
+   {
+      pVirtual = &pChip->aVirtual[i];
+      if( pVirtual->definition.operation == ADS7924_VIRTUAL_OFF )
+         continue;
+      mutex_lock( &pVirtual->oMutex );
+      compute( pVirtual, paValue, paTimestamp, flags );
+      pVirtual->isValid = true;
+      mutex_unlock( &pVirtual->oMutex );
+      wake_up_interruptible( &pVirtual->oWaitQueue );
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ * @see ads7924virtual.h
+ */
+int adcReadVirtual( VIRTUAL_CHANNEL_T* pVirtual,
+                    ADS7924_VIRTUAL_SAMPLE_T* pSample, bool nonBlock )
+{
+   ADS7924_T* pChip = pVirtual->pParent;
+   VALUE_T aValue[ADC_CHANNELS_PER_CHIP];
+   u64 aTimestamp[ADC_CHANNELS_PER_CHIP];
+   u8 aConfig[PWRCONFIG - SLPCONFIG + 1];
+   u32 convTime;
+   u64 start;
+   u8 mode;
+   int i, ret;
+
+   if( pVirtual->definition.operation == ADS7924_VIRTUAL_OFF )
+      return -ENODATA;
+
+   if( pChip->streamMode == ADS7924_STREAM_SCAN )
+   {
+      if( !pVirtual->isValid )
+      {
+         if( nonBlock )
+            return -EAGAIN;
+         if( wait_event_interruptible( pVirtual->oWaitQueue,
+                                       pVirtual->isValid ||
+                                       (pChip->streamMode != ADS7924_STREAM_SCAN) ||
+                                       (pVirtual->definition.operation == ADS7924_VIRTUAL_OFF) ) )
+            return -ERESTARTSYS;
+      }
+      mutex_lock( &pVirtual->oMutex );
+      if( pVirtual->isValid )
+      {
+         *pSample = pVirtual->result;
+         pVirtual->isValid = false;
+         mutex_unlock( &pVirtual->oMutex );
+         return 0;
+      }
+      mutex_unlock( &pVirtual->oMutex );
+      /* Streaming has been switched off meanwhile: Reading by I2C. */
+   }
+
+   /*
+    * A scan on demand would disturb the sequencer respectively the group,
+    * which own the mode of the chip.
+    */
+   if( adcLockMode( pChip ) < 0 )
+      return -EBUSY;
+   ret = adcReadTimingShadow( pChip, &mode, aConfig );
+   if( ret >= 0 )
+   {
+      convTime = adcGetConvTime( aConfig[ACQCONFIG - SLPCONFIG] );
+      ret = adcConvertScan( pChip, convTime, aValue, &start );
+   }
+   adcUnlockMode( pChip );
+   if( ret < 0 )
+      return -EIO;
+
+   /* Conversion instant of channel i is the end of its acquisition time. */
+   for( i = 0; i < ADC_CHANNELS_PER_CHIP; i++ )
+      aTimestamp[i] = start + (i + 1) * convTime - ADS7924_CONV_TIME_NS;
+
+   mutex_lock( &pVirtual->oMutex );
+   if( pVirtual->definition.operation == ADS7924_VIRTUAL_OFF )
+   {
+      ret = -ENODATA;
+   }
+   else
+   {
+      compute( pVirtual, aValue, aTimestamp, ADS7924_SAMPLE_RECONSTRUCTED );
+      *pSample = pVirtual->result;
+   }
+   mutex_unlock( &pVirtual->oMutex );
+   return ret;
+}
+
+/*================================== EOF ====================================*/
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*!
+ * @file ads7924virtual.h
+ * @author Ulrich Becker
+ * @copyright www.INKATRON.de
+ * @brief Virtual channels derived from two channels of the same chip.
+ * @date 2026.10.18
+ * @see ads7924virtual.c
+ * @see VIRTUAL
+ */
+#ifndef _ADS7924VIRTUAL_H
+#define _ADS7924VIRTUAL_H
+
+#include "ads7924driver.h"
+
+/*!----------------------------------------------------------------------------
+ * @brief Initializes the virtual channel objects of the given chip,
+ *        except the minor numbers.
+ */
+extern void adcInitVirtual( ADS7924_T* pChip );
+
+/*!----------------------------------------------------------------------------
+ * @brief Checks and sets the definition of a virtual channel.
+ * @retval ==0 OK
+ * @retval <0  Error (-EINVAL or -ENODEV)
+ */
+extern int adcSetVirtual( VIRTUAL_CHANNEL_T* pVirtual, const ADS7924_VIRTUAL_T* pDefinition );
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns the definition of a virtual channel.
+ */
+extern void adcGetVirtual( VIRTUAL_CHANNEL_T* pVirtual, ADS7924_VIRTUAL_T* pDefinition );
+
+/*!----------------------------------------------------------------------------
+ * @brief Calculates all defined virtual channels of the chip from a
+ *        harvested scan and wakes their readers.
+ * @param pChip Pointer to the chip object.
+ * @param paValue Offset corrected values of channel 0 to 3.
+ * @param paTimestamp Conversion instants of channel 0 to 3 in ns.
+ * @param flags Flags of the samples, e.g. ADS7924_SAMPLE_RECONSTRUCTED.
+ */
+extern void adcHarvestVirtual( ADS7924_T* pChip, const VALUE_T* paValue,
+                               const u64* paTimestamp, u8 flags );
+
+/*!----------------------------------------------------------------------------
+ * @brief Provides a value of the virtual channel.
+ *
+ * Whilst the chip is streaming in ADS7924_STREAM_SCAN the function takes
+ * the result of the next scan, otherwise it reads all data registers by
+ * a single I2C-transfer.
+ * @param pVirtual Pointer to the virtual channel object.
+ * @param pSample Target of the value.
+ * @param nonBlock Return -EAGAIN instead of waiting for the next scan.
+ * @retval ==0 OK
+ * @retval <0  Error (-ENODATA if not defined, -EAGAIN, -ERESTARTSYS or -EIO)
+ */
+extern int adcReadVirtual( VIRTUAL_CHANNEL_T* pVirtual,
+                           ADS7924_VIRTUAL_SAMPLE_T* pSample, bool nonBlock );
+
+#endif /* ifndef _ADS7924VIRTUAL_H */
+/*================================== EOF ====================================*/
@@ -0,0 +1,195 @@
+/******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+///////////////////////////////////////////////////////////////////////////////
+// Name:        ads7924stress.c
+// Purpose:     Latency measurement of ADS7924_IOCTL_GET_SAMPLE by many
+//              concurrent readers of the same channel.
+// Author:      Ulrich Becker
+// Modified by:
+// Created:     2026.10.18
+// Copyright:   www.INKATRON.de
+///////////////////////////////////////////////////////////////////////////////
+//
+// Usage: adcstress [-d <device>] [-t <threads>] [-n <calls per thread>]
+//
+// Each thread opens the channel device and calls ADS7924_IOCTL_GET_SAMPLE
+// in a loop. The duration of each call becomes sorted into logarithmic
+// buckets, at the end the percentiles of all threads are printed.
+// To stress the latest-value publication the chip should stream meanwhile,
+// e.g.:
+//    ioctl( fdChip, ADS7924_IOCTL_SET_MODE, ADS7924_MODE_AUTO_SCAN );
+//    ioctl( fdChip, ADS7924_IOCTL_SET_STREAMING, ADS7924_STREAM_SCAN );
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+
+#include "ads7924test.h"
+
+#define DEFAULT_THREADS 8
+#define DEFAULT_CALLS   100000
+#define MAX_THREADS     64
+#define BUCKETS         32    // Bucket i: 2^i <= t < 2^(i+1) ns
+
+typedef struct
+{
+   pthread_t thread;
+   uint64_t  aBucket[BUCKETS];
+   uint64_t  max;
+   uint64_t  sum;
+   uint64_t  errors;
+} READER_T;
+
+static const char* mg_pDevice = ADC0;
+static unsigned int mg_calls  = DEFAULT_CALLS;
+
+/*-----------------------------------------------------------------------------
+ */
+static inline uint64_t now( void )
+{
+   struct timespec ts;
+
+   clock_gettime( CLOCK_MONOTONIC, &ts );
+   return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/*-----------------------------------------------------------------------------
+ */
+static void* reader( void* pArg )
+{
+   READER_T* pReader = pArg;
+   ADS7924_SAMPLE_T sample;
+   uint64_t start, t;
+   unsigned int i;
+   int b, fd;
+
+   fd = open( mg_pDevice, O_RDWR );
+   if( fd < 0 )
+   {
+      fprintf( stderr, "ERROR: Unable to open \"%s\": %s\n", mg_pDevice, strerror( errno ) );
+      pReader->errors = mg_calls;
+      return NULL;
+   }
+
+   for( i = 0; i < mg_calls; i++ )
+   {
+      start = now();
+      if( ioctl( fd, ADS7924_IOCTL_GET_SAMPLE, &sample ) < 0 )
+      {
+         pReader->errors++;
+         continue;
+      }
+      t = now() - start;
+      pReader->sum += t;
+      if( t > pReader->max )
+         pReader->max = t;
+      for( b = 0; (b < BUCKETS - 1) && ((t >> (b + 1)) != 0); b++ );
+      pReader->aBucket[b]++;
+   }
+   close( fd );
+   return NULL;
+}
+
+/*-----------------------------------------------------------------------------
+ * Returns the upper limit of the bucket which contains the given fraction.
+ */
+static uint64_t percentile( const uint64_t* paBucket, uint64_t total, double fraction )
+{
+   uint64_t count = 0;
+   int b;
+
+   for( b = 0; b < BUCKETS; b++ )
+   {
+      count += paBucket[b];
+      if( count >= (uint64_t)(total * fraction) )
+         break;
+   }
+   return 1ULL << (b + 1);
+}
+
+/*-----------------------------------------------------------------------------
+ */
+int main( int argc, char** ppArgv )
+{
+   static READER_T aReader[MAX_THREADS];
+   uint64_t aBucket[BUCKETS] = { 0 };
+   uint64_t total = 0, sum = 0, max = 0, errors = 0;
+   unsigned int threads = DEFAULT_THREADS;
+   unsigned int i;
+   int b, opt;
+
+   while( (opt = getopt( argc, ppArgv, "d:t:n:h" )) != -1 )
+   {
+      switch( opt )
+      {
+         case 'd': mg_pDevice = optarg;                  break;
+         case 't': threads  = strtoul( optarg, NULL, 0 ); break;
+         case 'n': mg_calls = strtoul( optarg, NULL, 0 ); break;
+         default:
+         {
+            printf( "Usage: %s [-d <device>] [-t <threads>] [-n <calls per thread>]\n",
+                    ppArgv[0] );
+            return (opt == 'h')? EXIT_SUCCESS : EXIT_FAILURE;
+         }
+      }
+   }
+   if( (threads == 0) || (threads > MAX_THREADS) || (mg_calls == 0) )
+   {
+      fprintf( stderr, "ERROR: Threads 1..%d and calls > 0 expected!\n", MAX_THREADS );
+      return EXIT_FAILURE;
+   }
+
+   for( i = 0; i < threads; i++ )
+      pthread_create( &aReader[i].thread, NULL, reader, &aReader[i] );
+
+   for( i = 0; i < threads; i++ )
+   {
+      pthread_join( aReader[i].thread, NULL );
+      for( b = 0; b < BUCKETS; b++ )
+      {
+         aBucket[b] += aReader[i].aBucket[b];
+         total += aReader[i].aBucket[b];
+      }
+      sum += aReader[i].sum;
+      errors += aReader[i].errors;
+      if( aReader[i].max > max )
+         max = aReader[i].max;
+   }
+
+   if( total == 0 )
+   {
+      fprintf( stderr, "ERROR: No successful call!\n" );
+      return EXIT_FAILURE;
+   }
+
+   printf( "%s: %u threads, %llu calls, %llu errors\n", mg_pDevice, threads,
+           (unsigned long long)total, (unsigned long long)errors );
+   printf( "mean:   %llu ns\n", (unsigned long long)(sum / total) );
+   printf( "p50:  < %llu ns\n", (unsigned long long)percentile( aBucket, total, 0.5 ) );
+   printf( "p99:  < %llu ns\n", (unsigned long long)percentile( aBucket, total, 0.99 ) );
+   printf( "p99.9:< %llu ns\n", (unsigned long long)percentile( aBucket, total, 0.999 ) );
+   printf( "max:    %llu ns\n", (unsigned long long)max );
+   return EXIT_SUCCESS;
+}
+
+/*================================== EOF ====================================*/